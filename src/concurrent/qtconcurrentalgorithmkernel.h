@@ -0,0 +1,554 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QTCONCURRENT_ALGORITHMKERNEL_H
+#define QTCONCURRENT_ALGORITHMKERNEL_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined (Q_QDOC)
+
+#include <QtConcurrent/qtconcurrentthreadengine.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qlist.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+
+namespace QtConcurrent {
+
+/*
+    The PhasedKernel class runs an algorithm as a sequence of phases, each
+    of which is split into blocks that the threads of the engine process in
+    parallel. The thread that completes the last block of a phase calls
+    finishPhase() for the sequential part between two phases, and then
+    starts the next one.
+
+    The claimed block and the current phase are packed into one atomic, so
+    that a thread cannot claim a block of a phase that has been completed.
+*/
+template <typename T>
+class PhasedKernel : public ThreadEngine<T>
+{
+public:
+    explicit PhasedKernel(QThreadPool *pool) : ThreadEngine<T>(pool) { }
+
+protected:
+    // Blocks of a phase. Phases that cannot be canceled leave the data in
+    // a consistent state when completed, for example by moving elements
+    // back from a temporary buffer.
+    virtual void runBlock(int phase, int block) = 0;
+    virtual void finishPhase(int) { }
+    virtual bool isCancelable(int) const { return true; }
+
+    void addPhase(int blockCount) { blockCounts.append(blockCount); }
+
+    // Number of blocks to split \a count elements into
+    static int blockCountFor(qsizetype count, QThreadPool *pool)
+    {
+        enum { MinBlockSize = 4096, BlocksPerThread = 4 };
+        const qsizetype maxBlockCount = qsizetype(std::max(pool->maxThreadCount(), 1))
+                                        * BlocksPerThread;
+        return int(std::clamp(count / MinBlockSize, qsizetype(1), maxBlockCount));
+    }
+
+    static qsizetype blockBegin(int block, int blockCount, qsizetype count)
+    {
+        return qsizetype(qint64(count) * block / blockCount);
+    }
+
+    void start() override
+    {
+        progressReportingEnabled = this->isProgressReportingEnabled();
+        int totalBlockCount = 0;
+        for (int blockCount : std::as_const(blockCounts))
+            totalBlockCount += blockCount;
+        if (progressReportingEnabled && totalBlockCount > 0)
+            this->setProgressRange(0, totalBlockCount);
+        state.storeRelaxed(packState(firstPhaseWithBlocks(0), 0));
+    }
+
+    bool shouldStartThread() override
+    {
+        const quint64 current = state.loadRelaxed();
+        const int phase = statePhase(current);
+        return phase < blockCounts.size() && stateBlock(current) < blockCounts.at(phase)
+                && !this->shouldThrottleThread();
+    }
+
+    ThreadFunctionResult threadFunction() override
+    {
+        for (;;) {
+            quint64 current = state.loadAcquire();
+            const int phase = statePhase(current);
+            const int block = stateBlock(current);
+            if (phase >= blockCounts.size() || block >= blockCounts.at(phase))
+                return ThreadFinished; // No more work, or all blocks of this phase are claimed
+            if (this->isCanceled() && isCancelable(phase))
+                return ThreadFinished;
+            if (!state.testAndSetAcquire(current, current + 1))
+                continue;
+
+            this->waitForResume(); // (only waits if the qfuture is paused.)
+
+            if (shouldStartThread())
+                this->startThread();
+
+            runBlock(phase, block);
+
+            if (progressReportingEnabled)
+                this->setProgressValue(completed.fetchAndAddRelaxed(1) + 1);
+
+            if (blocksDone.fetchAndAddOrdered(1) + 1 == blockCounts.at(phase)) {
+                blocksDone.storeRelaxed(0);
+                finishPhase(phase);
+                state.storeRelease(packState(firstPhaseWithBlocks(phase + 1), 0));
+            }
+
+            if (this->shouldThrottleThread())
+                return ThrottleThread;
+        }
+    }
+
+private:
+    int firstPhaseWithBlocks(int phase)
+    {
+        for (; phase < blockCounts.size() && blockCounts.at(phase) == 0; ++phase)
+            finishPhase(phase);
+        return phase;
+    }
+
+    static quint64 packState(int phase, int block) { return (quint64(phase) << 32) | quint32(block); }
+    static int statePhase(quint64 state) { return int(state >> 32); }
+    static int stateBlock(quint64 state) { return int(quint32(state)); }
+
+    QList<int> blockCounts;
+    QAtomicInteger<quint64> state;
+    QAtomicInt blocksDone;
+    QAtomicInt completed;
+    bool progressReportingEnabled = false;
+};
+
+template <typename Iterator>
+using EnableIfRandomAccessIterator = std::enable_if_t<
+        std::is_base_of_v<std::random_access_iterator_tag,
+                          typename std::iterator_traits<Iterator>::iterator_category>, bool>;
+
+template <typename Sequence>
+using EnableIfSequence =
+        std::enable_if_t<!std::is_pointer_v<std::decay_t<Sequence>>,
+                         decltype(std::begin(std::declval<Sequence &>()), bool())>;
+
+/*
+    Sorts the blocks of the range, and then merges runs of blocks pairwise
+    until one run is left. Each merge is split into one part per block of
+    its output, using a binary search for the number of elements that each
+    input run contributes to the part. The searches are done before the
+    round starts, as merging moves elements out of the runs. Merges move the
+    elements between the range and a buffer; they cannot be canceled, so
+    that no elements are left in the buffer.
+*/
+template <typename Iterator, typename Compare>
+class SortKernel : public PhasedKernel<void>
+{
+    using ValueType = typename std::iterator_traits<Iterator>::value_type;
+
+public:
+    template <typename C = Compare>
+    SortKernel(QThreadPool *pool, Iterator begin, Iterator end, C &&compare)
+        : PhasedKernel<void>(pool), begin(begin), count(end - begin),
+          blockCount(blockCountFor(count, pool)), compare(std::forward<C>(compare)),
+          splits(blockCount)
+    {
+        addPhase(blockCount);
+        for (int runBlocks = 1; runBlocks < blockCount; runBlocks *= 2) {
+            addPhase(blockCount);
+            ++mergeRounds;
+        }
+        if (mergeRounds % 2)
+            addPhase(blockCount); // Move the elements back from the buffer
+    }
+
+protected:
+    void runBlock(int phase, int block) override
+    {
+        const qsizetype first = blockBegin(block, blockCount, count);
+        const qsizetype last = blockBegin(block + 1, blockCount, count);
+        if (phase == 0) {
+            std::stable_sort(begin + first, begin + last, compare);
+        } else if (phase <= mergeRounds) {
+            // Odd rounds merge from the range into the buffer, even ones back
+            if (phase % 2)
+                mergePart(begin, buffer.begin(), phase - 1, block);
+            else
+                mergePart(buffer.begin(), begin, phase - 1, block);
+        } else {
+            std::move(buffer.begin() + first, buffer.begin() + last, begin + first);
+        }
+    }
+
+    void finishPhase(int phase) override
+    {
+        if (phase == 0 && mergeRounds > 0)
+            buffer.resize(count);
+        if (phase < mergeRounds) {
+            // The next phase is merge round number 'phase'
+            for (int block = 0; block < blockCount; ++block) {
+                if (phase % 2)
+                    splits[block] = splitPart(buffer.begin(), phase, block);
+                else
+                    splits[block] = splitPart(begin, phase, block);
+            }
+        } else if (phase == mergeRounds + (mergeRounds % 2)) {
+            buffer = std::vector<ValueType>();
+        }
+    }
+
+    bool isCancelable(int phase) const override { return phase == 0; }
+
+private:
+    // Runs span whole blocks, so each part of the output of a round belongs
+    // to the merge of one pair of runs
+    struct Merge
+    {
+        int lastBlock;
+        qsizetype begin;
+        qsizetype middle;
+        qsizetype end;
+    };
+
+    Merge mergeOf(int round, int block) const
+    {
+        const int runBlocks = 1 << round;
+        const int firstBlock = block / (2 * runBlocks) * (2 * runBlocks);
+        const int middleBlock = std::min(firstBlock + runBlocks, blockCount);
+        const int lastBlock = std::min(firstBlock + 2 * runBlocks, blockCount);
+        return { lastBlock, blockBegin(firstBlock, blockCount, count),
+                 blockBegin(middleBlock, blockCount, count),
+                 blockBegin(lastBlock, blockCount, count) };
+    }
+
+    // Returns how many elements of the part of \a block come before it in
+    // the left run of its merge
+    template <typename Source>
+    qsizetype splitPart(Source source, int round, int block)
+    {
+        const Merge merge = mergeOf(round, block);
+        return coRank(blockBegin(block, blockCount, count) - merge.begin, source + merge.begin,
+                      merge.middle - merge.begin, source + merge.middle,
+                      merge.end - merge.middle);
+    }
+
+    template <typename Source, typename Destination>
+    void mergePart(Source source, Destination destination, int round, int block)
+    {
+        const Merge merge = mergeOf(round, block);
+        const qsizetype partBegin = blockBegin(block, blockCount, count) - merge.begin;
+        const qsizetype partEnd = blockBegin(block + 1, blockCount, count) - merge.begin;
+        const qsizetype leftBegin = splits[block];
+        const qsizetype leftEnd =
+                block + 1 < merge.lastBlock ? splits[block + 1] : merge.middle - merge.begin;
+
+        const Source left = source + merge.begin;
+        const Source right = source + merge.middle;
+        std::merge(std::make_move_iterator(left + leftBegin),
+                   std::make_move_iterator(left + leftEnd),
+                   std::make_move_iterator(right + (partBegin - leftBegin)),
+                   std::make_move_iterator(right + (partEnd - leftEnd)),
+                   destination + merge.begin + partBegin, compare);
+    }
+
+    // Returns how many of the first \a k elements of the stable merge of
+    // \a left and \a right come from \a left
+    template <typename Source>
+    qsizetype coRank(qsizetype k, Source left, qsizetype leftCount,
+                     Source right, qsizetype rightCount)
+    {
+        qsizetype low = std::max(qsizetype(0), k - rightCount);
+        qsizetype high = std::min(k, leftCount);
+        while (low < high) {
+            const qsizetype middle = low + (high - low) / 2;
+            // Equivalent elements are taken from the left run first
+            if (!std::invoke(compare, right[k - middle - 1], left[middle]))
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        return low;
+    }
+
+    const Iterator begin;
+    const qsizetype count;
+    const int blockCount;
+    int mergeRounds = 0;
+    Compare compare;
+    std::vector<qsizetype> splits;
+    std::vector<ValueType> buffer;
+};
+
+/*
+    Scans the blocks of the range in a first phase, computes the value that
+    each block starts from sequentially, and applies it to the blocks in a
+    second phase.
+*/
+template <typename Iterator, typename T, typename BinaryOperation, bool Exclusive>
+class ScanKernel : public PhasedKernel<void>
+{
+public:
+    template <typename U = T, typename Op = BinaryOperation>
+    ScanKernel(QThreadPool *pool, Iterator begin, Iterator end, U &&init, Op &&op)
+        : PhasedKernel<void>(pool), begin(begin), count(end - begin),
+          blockCount(blockCountFor(count, pool)), init(std::forward<U>(init)),
+          op(std::forward<Op>(op)), totals(blockCount), carries(blockCount)
+    {
+        addPhase(count ? blockCount : 0);
+        addPhase(count ? blockCount : 0);
+    }
+
+protected:
+    void runBlock(int phase, int block) override
+    {
+        Iterator it = begin + blockBegin(block, blockCount, count);
+        const Iterator last = begin + blockBegin(block + 1, blockCount, count);
+        if (it == last)
+            return;
+
+        if (phase == 0) {
+            // Inclusive scans are done in place here and completed with
+            // the carry later; exclusive ones need the carry first.
+            T total = *it;
+            if constexpr (Exclusive) {
+                while (++it != last)
+                    total = std::invoke(op, std::move(total), *it);
+            } else {
+                while (++it != last)
+                    *it = total = std::invoke(op, std::move(total), *it);
+            }
+            totals[block] = std::move(total);
+        } else if constexpr (Exclusive) {
+            T sum = *carries[block];
+            for (; it != last; ++it) {
+                T value = std::move(*it);
+                *it = sum;
+                sum = std::invoke(op, std::move(sum), std::move(value));
+            }
+        } else if (block > 0) {
+            const T &carry = *carries[block];
+            for (; it != last; ++it)
+                *it = std::invoke(op, carry, std::move(*it));
+        }
+    }
+
+    void finishPhase(int phase) override
+    {
+        if (phase != 0)
+            return;
+        std::optional<T> carry = init;
+        for (int block = 0; block < blockCount; ++block) {
+            carries[block] = carry;
+            if (!totals[block])
+                continue;
+            if (carry)
+                carry = std::invoke(op, std::move(*carry), std::move(*totals[block]));
+            else
+                carry = std::move(totals[block]);
+        }
+    }
+
+private:
+    const Iterator begin;
+    const qsizetype count;
+    const int blockCount;
+    const std::optional<T> init;
+    BinaryOperation op;
+    std::vector<std::optional<T>> totals;
+    std::vector<std::optional<T>> carries;
+};
+
+/*
+    Evaluates the predicate and counts the matching elements of each block,
+    computes where each block moves its elements to, and moves them through
+    a buffer. Like for sorting, only the first phase can be canceled.
+*/
+template <typename Iterator, typename Predicate>
+class PartitionKernel : public PhasedKernel<qsizetype>
+{
+    using ValueType = typename std::iterator_traits<Iterator>::value_type;
+
+public:
+    template <typename P = Predicate>
+    PartitionKernel(QThreadPool *pool, Iterator begin, Iterator end, P &&predicate)
+        : PhasedKernel<qsizetype>(pool), begin(begin), count(end - begin),
+          blockCount(blockCountFor(count, pool)), predicate(std::forward<P>(predicate)),
+          matches(count), matchOffsets(blockCount + 1)
+    {
+        addPhase(blockCount);
+        addPhase(blockCount);
+        addPhase(blockCount);
+    }
+
+    qsizetype *result() override { return &partitionPoint; }
+
+protected:
+    void runBlock(int phase, int block) override
+    {
+        const qsizetype first = blockBegin(block, blockCount, count);
+        const qsizetype last = blockBegin(block + 1, blockCount, count);
+        if (phase == 0) {
+            qsizetype matchCount = 0;
+            for (qsizetype i = first; i < last; ++i) {
+                matches[i] = bool(std::invoke(predicate, begin[i]));
+                matchCount += matches[i];
+            }
+            matchOffsets[block + 1] = matchCount;
+        } else if (phase == 1) {
+            // Elements keep their relative order in both groups
+            qsizetype matchIndex = matchOffsets[block];
+            qsizetype otherIndex = partitionPoint + (first - matchOffsets[block]);
+            for (qsizetype i = first; i < last; ++i)
+                buffer[matches[i] ? matchIndex++ : otherIndex++] = std::move(begin[i]);
+        } else {
+            std::move(buffer.begin() + first, buffer.begin() + last, begin + first);
+        }
+    }
+
+    void finishPhase(int phase) override
+    {
+        if (phase == 0) {
+            for (int block = 0; block < blockCount; ++block)
+                matchOffsets[block + 1] += matchOffsets[block];
+            partitionPoint = matchOffsets[blockCount];
+            buffer.resize(count);
+        } else if (phase == 2) {
+            buffer = std::vector<ValueType>();
+            matches = std::vector<char>();
+        }
+    }
+
+    bool isCancelable(int phase) const override { return phase == 0; }
+
+private:
+    const Iterator begin;
+    const qsizetype count;
+    const int blockCount;
+    Predicate predicate;
+    std::vector<char> matches;
+    std::vector<qsizetype> matchOffsets;
+    std::vector<ValueType> buffer;
+    qsizetype partitionPoint = 0;
+};
+
+/*
+    Reduces the transformed elements of each block, and then the results of
+    the blocks in order, so that the reduction need not be commutative.
+*/
+template <typename Iterator, typename T, typename ReduceOperation, typename TransformOperation>
+class TransformReduceKernel : public PhasedKernel<T>
+{
+    using PhasedKernel<T>::blockBegin;
+
+public:
+    template <typename U = T, typename R = ReduceOperation, typename Tr = TransformOperation>
+    TransformReduceKernel(QThreadPool *pool, Iterator begin, Iterator end, U &&init,
+                          R &&reduce, Tr &&transform)
+        : PhasedKernel<T>(pool), begin(begin), count(end - begin),
+          blockCount(PhasedKernel<T>::blockCountFor(count, pool)), value(std::forward<U>(init)),
+          reduce(std::forward<R>(reduce)), transform(std::forward<Tr>(transform)),
+          partials(blockCount)
+    {
+        this->addPhase(count ? blockCount : 0);
+    }
+
+    T *result() override { return &value; }
+
+protected:
+    void runBlock(int, int block) override
+    {
+        Iterator it = begin + blockBegin(block, blockCount, count);
+        const Iterator last = begin + blockBegin(block + 1, blockCount, count);
+        if (it == last)
+            return;
+
+        T partial = std::invoke(transform, *it);
+        while (++it != last)
+            partial = std::invoke(reduce, std::move(partial), std::invoke(transform, *it));
+        partials[block] = std::move(partial);
+    }
+
+    void finishPhase(int) override
+    {
+        for (std::optional<T> &partial : partials) {
+            if (partial)
+                value = std::invoke(reduce, std::move(value), std::move(*partial));
+        }
+        partials = std::vector<std::optional<T>>();
+    }
+
+private:
+    const Iterator begin;
+    const qsizetype count;
+    const int blockCount;
+    T value;
+    ReduceOperation reduce;
+    TransformOperation transform;
+    std::vector<std::optional<T>> partials;
+};
+
+//! [qtconcurrentalgorithmkernel-1]
+template <typename Iterator, typename Compare>
+inline ThreadEngineStarter<void> startSort(QThreadPool *pool, Iterator begin, Iterator end,
+                                           Compare &&compare)
+{
+    return startThreadEngine(new SortKernel<Iterator, std::decay_t<Compare>>(
+            pool, begin, end, std::forward<Compare>(compare)));
+}
+
+//! [qtconcurrentalgorithmkernel-2]
+template <bool Exclusive, typename T, typename Iterator, typename BinaryOperation>
+inline ThreadEngineStarter<void> startScan(QThreadPool *pool, Iterator begin, Iterator end,
+                                           T &&init, BinaryOperation &&op)
+{
+    using ValueType = typename std::iterator_traits<Iterator>::value_type;
+    return startThreadEngine(
+            new ScanKernel<Iterator, ValueType, std::decay_t<BinaryOperation>, Exclusive>(
+                    pool, begin, end, std::forward<T>(init), std::forward<BinaryOperation>(op)));
+}
+
+//! [qtconcurrentalgorithmkernel-3]
+template <typename Iterator, typename Predicate>
+inline ThreadEngineStarter<qsizetype> startPartition(QThreadPool *pool, Iterator begin,
+                                                     Iterator end, Predicate &&predicate)
+{
+    return startThreadEngine(new PartitionKernel<Iterator, std::decay_t<Predicate>>(
+            pool, begin, end, std::forward<Predicate>(predicate)));
+}
+
+//! [qtconcurrentalgorithmkernel-4]
+template <typename T, typename Iterator, typename ReduceOperation, typename TransformOperation>
+inline ThreadEngineStarter<T> startTransformReduce(QThreadPool *pool, Iterator begin,
+                                                   Iterator end, T &&init,
+                                                   ReduceOperation &&reduce,
+                                                   TransformOperation &&transform)
+{
+    return startThreadEngine(
+            new TransformReduceKernel<Iterator, std::decay_t<T>, std::decay_t<ReduceOperation>,
+                                      std::decay_t<TransformOperation>>(
+                    pool, begin, end, std::forward<T>(init),
+                    std::forward<ReduceOperation>(reduce),
+                    std::forward<TransformOperation>(transform)));
+}
+
+} // namespace QtConcurrent
+
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif
@@ -0,0 +1,395 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QTCONCURRENT_ALGORITHMS_H
+#define QTCONCURRENT_ALGORITHMS_H
+
+#if 0
+#pragma qt_class(QtConcurrentAlgorithms)
+#endif
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_QDOC)
+
+#include <QtConcurrent/qtconcurrentalgorithmkernel.h>
+
+QT_BEGIN_NAMESPACE
+
+
+
+namespace QtConcurrent {
+
+// sort() on sequences
+template <typename Sequence, typename Compare = std::less<>, EnableIfSequence<Sequence> = true>
+QFuture<void> sort(QThreadPool *pool, Sequence &&sequence, Compare &&compare = {})
+{
+    return startSort(pool, std::begin(sequence), std::end(sequence),
+                     std::forward<Compare>(compare));
+}
+
+template <typename Sequence, typename Compare = std::less<>, EnableIfSequence<Sequence> = true>
+QFuture<void> sort(Sequence &&sequence, Compare &&compare = {})
+{
+    return startSort(QThreadPool::globalInstance(), std::begin(sequence), std::end(sequence),
+                     std::forward<Compare>(compare));
+}
+
+// sort() on iterators
+template <typename Iterator, typename Compare = std::less<>,
+          EnableIfRandomAccessIterator<Iterator> = true>
+QFuture<void> sort(QThreadPool *pool, Iterator begin, Iterator end, Compare &&compare = {})
+{
+    return startSort(pool, begin, end, std::forward<Compare>(compare));
+}
+
+template <typename Iterator, typename Compare = std::less<>,
+          EnableIfRandomAccessIterator<Iterator> = true>
+QFuture<void> sort(Iterator begin, Iterator end, Compare &&compare = {})
+{
+    return startSort(QThreadPool::globalInstance(), begin, end, std::forward<Compare>(compare));
+}
+
+// inclusiveScan() on sequences
+template <typename Sequence, typename BinaryOperation = std::plus<>,
+          EnableIfSequence<Sequence> = true>
+QFuture<void> inclusiveScan(QThreadPool *pool, Sequence &&sequence, BinaryOperation &&op = {})
+{
+    return startScan<false>(pool, std::begin(sequence), std::end(sequence), std::nullopt,
+                            std::forward<BinaryOperation>(op));
+}
+
+template <typename Sequence, typename BinaryOperation = std::plus<>,
+          EnableIfSequence<Sequence> = true>
+QFuture<void> inclusiveScan(Sequence &&sequence, BinaryOperation &&op = {})
+{
+    return startScan<false>(QThreadPool::globalInstance(), std::begin(sequence),
+                            std::end(sequence), std::nullopt,
+                            std::forward<BinaryOperation>(op));
+}
+
+// inclusiveScan() on iterators
+template <typename Iterator, typename BinaryOperation = std::plus<>,
+          EnableIfRandomAccessIterator<Iterator> = true>
+QFuture<void> inclusiveScan(QThreadPool *pool, Iterator begin, Iterator end,
+                            BinaryOperation &&op = {})
+{
+    return startScan<false>(pool, begin, end, std::nullopt, std::forward<BinaryOperation>(op));
+}
+
+template <typename Iterator, typename BinaryOperation = std::plus<>,
+          EnableIfRandomAccessIterator<Iterator> = true>
+QFuture<void> inclusiveScan(Iterator begin, Iterator end, BinaryOperation &&op = {})
+{
+    return startScan<false>(QThreadPool::globalInstance(), begin, end, std::nullopt,
+                            std::forward<BinaryOperation>(op));
+}
+
+// exclusiveScan() on sequences
+template <typename Sequence, typename T, typename BinaryOperation = std::plus<>,
+          EnableIfSequence<Sequence> = true>
+QFuture<void> exclusiveScan(QThreadPool *pool, Sequence &&sequence, T &&init,
+                            BinaryOperation &&op = {})
+{
+    return startScan<true>(pool, std::begin(sequence), std::end(sequence), std::forward<T>(init),
+                           std::forward<BinaryOperation>(op));
+}
+
+template <typename Sequence, typename T, typename BinaryOperation = std::plus<>,
+          EnableIfSequence<Sequence> = true>
+QFuture<void> exclusiveScan(Sequence &&sequence, T &&init, BinaryOperation &&op = {})
+{
+    return startScan<true>(QThreadPool::globalInstance(), std::begin(sequence),
+                           std::end(sequence), std::forward<T>(init),
+                           std::forward<BinaryOperation>(op));
+}
+
+// exclusiveScan() on iterators
+template <typename Iterator, typename T, typename BinaryOperation = std::plus<>,
+          EnableIfRandomAccessIterator<Iterator> = true>
+QFuture<void> exclusiveScan(QThreadPool *pool, Iterator begin, Iterator end, T &&init,
+                            BinaryOperation &&op = {})
+{
+    return startScan<true>(pool, begin, end, std::forward<T>(init),
+                           std::forward<BinaryOperation>(op));
+}
+
+template <typename Iterator, typename T, typename BinaryOperation = std::plus<>,
+          EnableIfRandomAccessIterator<Iterator> = true>
+QFuture<void> exclusiveScan(Iterator begin, Iterator end, T &&init, BinaryOperation &&op = {})
+{
+    return startScan<true>(QThreadPool::globalInstance(), begin, end, std::forward<T>(init),
+                           std::forward<BinaryOperation>(op));
+}
+
+// partition() on sequences
+template <typename Sequence, typename Predicate, EnableIfSequence<Sequence> = true>
+QFuture<qsizetype> partition(QThreadPool *pool, Sequence &&sequence, Predicate &&predicate)
+{
+    return startPartition(pool, std::begin(sequence), std::end(sequence),
+                          std::forward<Predicate>(predicate));
+}
+
+template <typename Sequence, typename Predicate, EnableIfSequence<Sequence> = true>
+QFuture<qsizetype> partition(Sequence &&sequence, Predicate &&predicate)
+{
+    return startPartition(QThreadPool::globalInstance(), std::begin(sequence),
+                          std::end(sequence), std::forward<Predicate>(predicate));
+}
+
+// partition() on iterators
+template <typename Iterator, typename Predicate, EnableIfRandomAccessIterator<Iterator> = true>
+QFuture<qsizetype> partition(QThreadPool *pool, Iterator begin, Iterator end,
+                             Predicate &&predicate)
+{
+    return startPartition(pool, begin, end, std::forward<Predicate>(predicate));
+}
+
+template <typename Iterator, typename Predicate, EnableIfRandomAccessIterator<Iterator> = true>
+QFuture<qsizetype> partition(Iterator begin, Iterator end, Predicate &&predicate)
+{
+    return startPartition(QThreadPool::globalInstance(), begin, end,
+                          std::forward<Predicate>(predicate));
+}
+
+// transformReduce() on sequences
+template <typename Sequence, typename T, typename ReduceOperation, typename TransformOperation,
+          EnableIfSequence<Sequence> = true>
+QFuture<std::decay_t<T>> transformReduce(QThreadPool *pool, Sequence &&sequence, T &&init,
+                                         ReduceOperation &&reduce,
+                                         TransformOperation &&transform)
+{
+    return startTransformReduce(pool, std::begin(sequence), std::end(sequence),
+                                std::forward<T>(init), std::forward<ReduceOperation>(reduce),
+                                std::forward<TransformOperation>(transform));
+}
+
+template <typename Sequence, typename T, typename ReduceOperation, typename TransformOperation,
+          EnableIfSequence<Sequence> = true>
+QFuture<std::decay_t<T>> transformReduce(Sequence &&sequence, T &&init,
+                                         ReduceOperation &&reduce,
+                                         TransformOperation &&transform)
+{
+    return startTransformReduce(QThreadPool::globalInstance(), std::begin(sequence),
+                                std::end(sequence), std::forward<T>(init),
+                                std::forward<ReduceOperation>(reduce),
+                                std::forward<TransformOperation>(transform));
+}
+
+// transformReduce() on iterators
+template <typename Iterator, typename T, typename ReduceOperation, typename TransformOperation,
+          EnableIfRandomAccessIterator<Iterator> = true>
+QFuture<std::decay_t<T>> transformReduce(QThreadPool *pool, Iterator begin, Iterator end,
+                                         T &&init, ReduceOperation &&reduce,
+                                         TransformOperation &&transform)
+{
+    return startTransformReduce(pool, begin, end, std::forward<T>(init),
+                                std::forward<ReduceOperation>(reduce),
+                                std::forward<TransformOperation>(transform));
+}
+
+template <typename Iterator, typename T, typename ReduceOperation, typename TransformOperation,
+          EnableIfRandomAccessIterator<Iterator> = true>
+QFuture<std::decay_t<T>> transformReduce(Iterator begin, Iterator end, T &&init,
+                                         ReduceOperation &&reduce,
+                                         TransformOperation &&transform)
+{
+    return startTransformReduce(QThreadPool::globalInstance(), begin, end, std::forward<T>(init),
+                                std::forward<ReduceOperation>(reduce),
+                                std::forward<TransformOperation>(transform));
+}
+
+// blockingSort()
+template <typename Sequence, typename Compare = std::less<>, EnableIfSequence<Sequence> = true>
+void blockingSort(QThreadPool *pool, Sequence &&sequence, Compare &&compare = {})
+{
+    QFuture<void> future = sort(pool, sequence, std::forward<Compare>(compare));
+    future.waitForFinished();
+}
+
+template <typename Sequence, typename Compare = std::less<>, EnableIfSequence<Sequence> = true>
+void blockingSort(Sequence &&sequence, Compare &&compare = {})
+{
+    QFuture<void> future = sort(sequence, std::forward<Compare>(compare));
+    future.waitForFinished();
+}
+
+template <typename Iterator, typename Compare = std::less<>,
+          EnableIfRandomAccessIterator<Iterator> = true>
+void blockingSort(QThreadPool *pool, Iterator begin, Iterator end, Compare &&compare = {})
+{
+    QFuture<void> future = sort(pool, begin, end, std::forward<Compare>(compare));
+    future.waitForFinished();
+}
+
+template <typename Iterator, typename Compare = std::less<>,
+          EnableIfRandomAccessIterator<Iterator> = true>
+void blockingSort(Iterator begin, Iterator end, Compare &&compare = {})
+{
+    QFuture<void> future = sort(begin, end, std::forward<Compare>(compare));
+    future.waitForFinished();
+}
+
+// blockingInclusiveScan()
+template <typename Sequence, typename BinaryOperation = std::plus<>,
+          EnableIfSequence<Sequence> = true>
+void blockingInclusiveScan(QThreadPool *pool, Sequence &&sequence, BinaryOperation &&op = {})
+{
+    QFuture<void> future = inclusiveScan(pool, sequence, std::forward<BinaryOperation>(op));
+    future.waitForFinished();
+}
+
+template <typename Sequence, typename BinaryOperation = std::plus<>,
+          EnableIfSequence<Sequence> = true>
+void blockingInclusiveScan(Sequence &&sequence, BinaryOperation &&op = {})
+{
+    QFuture<void> future = inclusiveScan(sequence, std::forward<BinaryOperation>(op));
+    future.waitForFinished();
+}
+
+template <typename Iterator, typename BinaryOperation = std::plus<>,
+          EnableIfRandomAccessIterator<Iterator> = true>
+void blockingInclusiveScan(QThreadPool *pool, Iterator begin, Iterator end,
+                           BinaryOperation &&op = {})
+{
+    QFuture<void> future = inclusiveScan(pool, begin, end, std::forward<BinaryOperation>(op));
+    future.waitForFinished();
+}
+
+template <typename Iterator, typename BinaryOperation = std::plus<>,
+          EnableIfRandomAccessIterator<Iterator> = true>
+void blockingInclusiveScan(Iterator begin, Iterator end, BinaryOperation &&op = {})
+{
+    QFuture<void> future = inclusiveScan(begin, end, std::forward<BinaryOperation>(op));
+    future.waitForFinished();
+}
+
+// blockingExclusiveScan()
+template <typename Sequence, typename T, typename BinaryOperation = std::plus<>,
+          EnableIfSequence<Sequence> = true>
+void blockingExclusiveScan(QThreadPool *pool, Sequence &&sequence, T &&init,
+                           BinaryOperation &&op = {})
+{
+    QFuture<void> future = exclusiveScan(pool, sequence, std::forward<T>(init),
+                                         std::forward<BinaryOperation>(op));
+    future.waitForFinished();
+}
+
+template <typename Sequence, typename T, typename BinaryOperation = std::plus<>,
+          EnableIfSequence<Sequence> = true>
+void blockingExclusiveScan(Sequence &&sequence, T &&init, BinaryOperation &&op = {})
+{
+    QFuture<void> future = exclusiveScan(sequence, std::forward<T>(init),
+                                         std::forward<BinaryOperation>(op));
+    future.waitForFinished();
+}
+
+template <typename Iterator, typename T, typename BinaryOperation = std::plus<>,
+          EnableIfRandomAccessIterator<Iterator> = true>
+void blockingExclusiveScan(QThreadPool *pool, Iterator begin, Iterator end, T &&init,
+                           BinaryOperation &&op = {})
+{
+    QFuture<void> future = exclusiveScan(pool, begin, end, std::forward<T>(init),
+                                         std::forward<BinaryOperation>(op));
+    future.waitForFinished();
+}
+
+template <typename Iterator, typename T, typename BinaryOperation = std::plus<>,
+          EnableIfRandomAccessIterator<Iterator> = true>
+void blockingExclusiveScan(Iterator begin, Iterator end, T &&init, BinaryOperation &&op = {})
+{
+    QFuture<void> future = exclusiveScan(begin, end, std::forward<T>(init),
+                                         std::forward<BinaryOperation>(op));
+    future.waitForFinished();
+}
+
+// blockingPartition()
+template <typename Sequence, typename Predicate, EnableIfSequence<Sequence> = true>
+qsizetype blockingPartition(QThreadPool *pool, Sequence &&sequence, Predicate &&predicate)
+{
+    QFuture<qsizetype> future = partition(pool, sequence, std::forward<Predicate>(predicate));
+    return future.takeResult();
+}
+
+template <typename Sequence, typename Predicate, EnableIfSequence<Sequence> = true>
+qsizetype blockingPartition(Sequence &&sequence, Predicate &&predicate)
+{
+    QFuture<qsizetype> future = partition(sequence, std::forward<Predicate>(predicate));
+    return future.takeResult();
+}
+
+template <typename Iterator, typename Predicate, EnableIfRandomAccessIterator<Iterator> = true>
+qsizetype blockingPartition(QThreadPool *pool, Iterator begin, Iterator end,
+                            Predicate &&predicate)
+{
+    QFuture<qsizetype> future = partition(pool, begin, end, std::forward<Predicate>(predicate));
+    return future.takeResult();
+}
+
+template <typename Iterator, typename Predicate, EnableIfRandomAccessIterator<Iterator> = true>
+qsizetype blockingPartition(Iterator begin, Iterator end, Predicate &&predicate)
+{
+    QFuture<qsizetype> future = partition(begin, end, std::forward<Predicate>(predicate));
+    return future.takeResult();
+}
+
+// blockingTransformReduce()
+template <typename Sequence, typename T, typename ReduceOperation, typename TransformOperation,
+          EnableIfSequence<Sequence> = true>
+std::decay_t<T> blockingTransformReduce(QThreadPool *pool, Sequence &&sequence, T &&init,
+                                        ReduceOperation &&reduce,
+                                        TransformOperation &&transform)
+{
+    QFuture<std::decay_t<T>> future =
+            transformReduce(pool, sequence, std::forward<T>(init),
+                            std::forward<ReduceOperation>(reduce),
+                            std::forward<TransformOperation>(transform));
+    return future.takeResult();
+}
+
+template <typename Sequence, typename T, typename ReduceOperation, typename TransformOperation,
+          EnableIfSequence<Sequence> = true>
+std::decay_t<T> blockingTransformReduce(Sequence &&sequence, T &&init, ReduceOperation &&reduce,
+                                        TransformOperation &&transform)
+{
+    QFuture<std::decay_t<T>> future =
+            transformReduce(sequence, std::forward<T>(init),
+                            std::forward<ReduceOperation>(reduce),
+                            std::forward<TransformOperation>(transform));
+    return future.takeResult();
+}
+
+template <typename Iterator, typename T, typename ReduceOperation, typename TransformOperation,
+          EnableIfRandomAccessIterator<Iterator> = true>
+std::decay_t<T> blockingTransformReduce(QThreadPool *pool, Iterator begin, Iterator end,
+                                        T &&init, ReduceOperation &&reduce,
+                                        TransformOperation &&transform)
+{
+    QFuture<std::decay_t<T>> future =
+            transformReduce(pool, begin, end, std::forward<T>(init),
+                            std::forward<ReduceOperation>(reduce),
+                            std::forward<TransformOperation>(transform));
+    return future.takeResult();
+}
+
+template <typename Iterator, typename T, typename ReduceOperation, typename TransformOperation,
+          EnableIfRandomAccessIterator<Iterator> = true>
+std::decay_t<T> blockingTransformReduce(Iterator begin, Iterator end, T &&init,
+                                        ReduceOperation &&reduce,
+                                        TransformOperation &&transform)
+{
+    QFuture<std::decay_t<T>> future =
+            transformReduce(begin, end, std::forward<T>(init),
+                            std::forward<ReduceOperation>(reduce),
+                            std::forward<TransformOperation>(transform));
+    return future.takeResult();
+}
+
+} // namespace QtConcurrent
+
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif
@@ -12,7 +12,9 @@
 #include <QtConcurrent/qtconcurrentmedian.h>
 #include <QtConcurrent/qtconcurrentthreadengine.h>
 
+#include <algorithm>
 #include <iterator>
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
@@ -142,6 +144,15 @@ inline bool selectIteration(std::random_access_iterator_tag)
     return true; // for
 }
 
+// Size of the elements that an iterator refers to, if it declares them
+template <typename Iterator, typename = void>
+constexpr std::size_t iteratorValueSize = sizeof(void *);
+
+template <typename Iterator>
+constexpr std::size_t iteratorValueSize<Iterator,
+        std::void_t<decltype(sizeof(typename std::iterator_traits<Iterator>::value_type))>> =
+        sizeof(typename std::iterator_traits<Iterator>::value_type);
+
 template <typename Iterator, typename T>
 class IterateKernel : public ThreadEngine<T>
 {
@@ -198,11 +209,15 @@ public:
         progressReportingEnabled = this->isProgressReportingEnabled();
         if (progressReportingEnabled && iterationCount > 0)
             this->setProgressRange(0, iterationCount);
+        if (forIteration && iterationCount >= StaticPartitionThreshold)
+            createPartitions();
     }
 
     bool shouldStartThread() override
     {
-        if (forIteration)
+        if (partitions)
+            return hasRemainingIterations() && !this->shouldThrottleThread();
+        else if (forIteration)
             return (currentIndex.loadRelaxed() < iterationCount) && !this->shouldThrottleThread();
         else // whileIteration
             return (iteratorThreads.loadRelaxed() == 0);
@@ -210,7 +225,9 @@ public:
 
     ThreadFunctionResult threadFunction() override
     {
-        if (forIteration)
+        if (partitions)
+            return this->partitionedThreadFunction();
+        else if (forIteration)
             return this->forThreadFunction();
         else // whileIteration
             return this->whileThreadFunction();
@@ -267,6 +284,70 @@ public:
         return ThreadFinished;
     }
 
+    // Used instead of forThreadFunction() for large ranges: rather than
+    // reserving blocks from a shared index, each thread owns a contiguous
+    // partition of the range, and steals half of the remaining iterations
+    // of another partition once its own is done.
+    ThreadFunctionResult partitionedThreadFunction()
+    {
+        Partition *own = claimPartition();
+        if (!own)
+            return ThreadFinished;
+
+        ResultReporter<T> resultReporter = createResultsReporter();
+        int iterationsDone = 0;
+        ThreadFunctionResult result = ThreadFinished;
+
+        for (;;) {
+            if (this->isCanceled())
+                break;
+
+            int beginIndex;
+            int endIndex;
+            if (!takeChunk(own, &beginIndex, &endIndex)) {
+                if (!stealIterations(&beginIndex, &endIndex))
+                    break; // No more work
+                // Only the owner of an empty partition stores into it
+                own->range.storeRelaxed(packRange(beginIndex, endIndex));
+                continue;
+            }
+
+            this->waitForResume(); // (only waits if the qfuture is paused.)
+
+            if (shouldStartThread())
+                this->startThread();
+
+            const int finalBlockSize = endIndex - beginIndex;
+            resultReporter.reserveSpace(finalBlockSize);
+
+            const bool resultsAvailable = this->runIterations(begin, beginIndex, endIndex, resultReporter.getPointer());
+
+            if (resultsAvailable)
+                resultReporter.reportResults(beginIndex);
+
+            iterationsDone += finalBlockSize;
+            if (progressReportingEnabled) {
+                completed.fetchAndAddAcquire(finalBlockSize);
+                this->setProgressValue(this->completed.loadRelaxed());
+            }
+
+            if (this->shouldThrottleThread()) {
+                // The rest of the partition is left for other threads
+                result = ThrottleThread;
+                break;
+            }
+        }
+
+#ifdef QTCONCURRENT_FOR_DEBUG
+        qDebug() << QThread::currentThread() << "partition" << (own - partitions.get())
+                 << "ran" << iterationsDone << "iterations";
+#else
+        Q_UNUSED(iterationsDone);
+#endif
+        own->owned.storeRelease(0);
+        return result;
+    }
+
     ThreadFunctionResult whileThreadFunction()
     {
         if (iteratorThreads.testAndSetAcquire(0, 1) == false)
@@ -304,6 +385,115 @@ public:
     }
 
 private:
+    enum {
+        // Number of iterations from which partitions are used
+        StaticPartitionThreshold = 1 << 16,
+        // Iterations are taken from a partition in chunks that span about
+        // half of a typical L1 data cache
+        ChunkBytes = 16 * 1024
+    };
+
+    // The range of iterations of a partition is packed into a single
+    // atomic, so that its owner can take chunks from the front while other
+    // threads split off its back half. Partitions are aligned to cache
+    // lines so that threads do not contend on unrelated ones.
+    struct alignas(64) Partition
+    {
+        QAtomicInteger<quint64> range;
+        QAtomicInt owned;
+    };
+
+    static quint64 packRange(int beginIndex, int endIndex)
+    {
+        return (quint64(quint32(beginIndex)) << 32) | quint32(endIndex);
+    }
+    static int rangeBegin(quint64 range) { return int(range >> 32); }
+    static int rangeEnd(quint64 range) { return int(quint32(range)); }
+
+    void createPartitions()
+    {
+        partitionCount = std::max(ThreadEngineBase::threadPool->maxThreadCount(), 1);
+        partitions = std::make_unique<Partition[]>(partitionCount);
+        for (int i = 0; i < partitionCount; ++i) {
+            const int beginIndex = int(qint64(iterationCount) * i / partitionCount);
+            const int endIndex = int(qint64(iterationCount) * (i + 1) / partitionCount);
+            partitions[i].range.storeRelaxed(packRange(beginIndex, endIndex));
+        }
+
+        // Keep enough chunks per partition for stealing to balance the load
+        const int maxChunkSize = std::max(iterationCount / partitionCount / 8, 1);
+        chunkSize = std::clamp(int(ChunkBytes / std::max(iteratorValueSize<Iterator>, std::size_t(1))),
+                               1, maxChunkSize);
+    }
+
+    // Threads claim the first free partition, so that the threads started
+    // first get the partitions in order. A thread that is restarted after
+    // throttling may get a different one.
+    Partition *claimPartition()
+    {
+        for (int i = 0; i < partitionCount; ++i) {
+            if (partitions[i].owned.testAndSetAcquire(0, 1))
+                return &partitions[i];
+        }
+        return nullptr;
+    }
+
+    bool takeChunk(Partition *partition, int *beginIndex, int *endIndex)
+    {
+        quint64 range = partition->range.loadRelaxed();
+        for (;;) {
+            const int rb = rangeBegin(range);
+            const int re = rangeEnd(range);
+            if (rb >= re)
+                return false;
+            const int chunkEnd = rb + std::min(chunkSize, re - rb);
+            if (partition->range.testAndSetOrdered(range, packRange(chunkEnd, re), range)) {
+                *beginIndex = rb;
+                *endIndex = chunkEnd;
+                return true;
+            }
+        }
+    }
+
+    // Splits off the back half of the largest remaining range
+    bool stealIterations(int *beginIndex, int *endIndex)
+    {
+        for (;;) {
+            Partition *victim = nullptr;
+            quint64 victimRange = 0;
+            int largest = 0;
+            for (int i = 0; i < partitionCount; ++i) {
+                const quint64 range = partitions[i].range.loadRelaxed();
+                if (rangeEnd(range) - rangeBegin(range) > largest) {
+                    victim = &partitions[i];
+                    victimRange = range;
+                    largest = rangeEnd(range) - rangeBegin(range);
+                }
+            }
+            if (!victim)
+                return false;
+
+            const int rb = rangeBegin(victimRange);
+            const int re = rangeEnd(victimRange);
+            const int middle = rb + (re - rb) / 2;
+            if (victim->range.testAndSetOrdered(victimRange, packRange(rb, middle))) {
+                *beginIndex = middle;
+                *endIndex = re;
+                return true;
+            }
+        }
+    }
+
+    bool hasRemainingIterations() const
+    {
+        for (int i = 0; i < partitionCount; ++i) {
+            const quint64 range = partitions[i].range.loadRelaxed();
+            if (rangeBegin(range) < rangeEnd(range))
+                return true;
+        }
+        return false;
+    }
+
     ResultReporter<T> createResultsReporter()
     {
         if constexpr (!std::is_same_v<T, void>)
@@ -323,6 +513,11 @@ public:
     const bool forIteration;
     bool progressReportingEnabled;
     DefaultValueContainer<ResultType> defaultValue;
+
+private:
+    std::unique_ptr<Partition[]> partitions;
+    int partitionCount = 0;
+    int chunkSize = 1;
 };
 
 } // namespace QtConcurrent
@@ -0,0 +1,567 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qasynclogger_p.h"
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qglobalstatic.h>
+#include <QtCore/qmath.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qwaitcondition.h>
+#include <QtCore/private/qlocking_p.h>
+#include <QtCore/private/qstringconverter_p.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef Q_OS_UNIX
+#  include <errno.h>
+#  include <limits.h>
+#  include <pthread.h>
+#  include <sys/uio.h>
+#  include <unistd.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+/*
+    The asynchronous logger moves the writing of formatted messages to
+    stderr off the logging threads. It is enabled by setting QT_LOGGING_ASYNC
+    to "drop" (or "1") or to "block"; those select what happens when a
+    thread logs faster than the writer can keep up:
+
+     - drop: the message is discarded and counted; the writer reports the
+       number of dropped messages in the output.
+     - block: the logging thread waits until the writer made room.
+
+    In the child of a fork(), the writer thread does not exist:
+    asynchronous logging is disabled there, and messages are written
+    synchronously.
+
+    Each logging thread owns a single-producer/single-consumer ring buffer,
+    so logging takes no lock once the thread's buffer exists. The writer
+    thread collects the records of all buffers and writes them with as few
+    writev() calls as possible. The buffer size per thread can be set in
+    bytes with QT_LOGGING_ASYNC_BUFFER_SIZE.
+
+    The messages of each thread are written in the order they were logged.
+    Across threads, each pass of the writer sorts the records it collected
+    by a global sequence number; a message that was still being queued when
+    the writer collected the others may come out after messages other
+    threads logged later, so the interleaving is only approximate.
+
+    Messages are formatted on the logging thread, because the message
+    pattern can refer to the thread, the time or a backtrace. Messages too
+    large for the buffer and fatal messages are written synchronously, after
+    flushing what is queued.
+*/
+
+namespace {
+
+enum class AsyncLoggingPolicy { Disabled, Drop, Block };
+
+constexpr qsizetype DefaultRingCapacity = 64 * 1024;
+constexpr qsizetype MinimumRingCapacity = 4 * 1024;
+constexpr qsizetype MaximumRingCapacity = 64 * 1024 * 1024;
+
+// Variable-sized records, each preceded by a Header. The owning thread
+// appends; the consumer (whoever holds QAsyncLogger::consumerMutex) removes.
+// Records are aligned to the header size, so the space left before the end
+// of the buffer always fits at least a wrap marker.
+class LogRing
+{
+public:
+    struct Header
+    {
+        quint32 size;       // payload size, or WrapMarker
+        quint32 reserved;
+        quint64 sequence;
+    };
+    static_assert(sizeof(Header) == 16);
+    static constexpr quint32 WrapMarker = ~0u;
+    static constexpr qsizetype Alignment = sizeof(Header);
+
+    explicit LogRing(qsizetype capacity)
+        : data(new char[capacity]), capacity(capacity)
+    {
+        Q_ASSERT(qPopulationCount(quint64(capacity)) == 1);
+    }
+
+    static qsizetype recordSize(qsizetype payload) noexcept
+    { return sizeof(Header) + ((payload + Alignment - 1) & ~(Alignment - 1)); }
+
+    char *at(quint64 position) const noexcept
+    { return data.get() + (position & (capacity - 1)); }
+
+    // Returns room for up to maxPayload bytes, or nullptr if the buffer does
+    // not have enough free space. Producer only.
+    char *reserve(qsizetype maxPayload) noexcept
+    {
+        const quint64 h = head.load(std::memory_order_relaxed);
+        const quint64 t = tail.load(std::memory_order_acquire);
+        const qsizetype needed = recordSize(maxPayload);
+        const qsizetype contiguous = capacity - qsizetype(h & (capacity - 1));
+        const qsizetype skipped = contiguous < needed ? contiguous : 0;
+        if (capacity - qsizetype(h - t) < needed + skipped)
+            return nullptr;
+        if (skipped) {
+            const Header marker = { WrapMarker, 0, 0 };
+            memcpy(at(h), &marker, sizeof(marker));
+        }
+        reservedAt = h + skipped;
+        return at(reservedAt) + sizeof(Header);
+    }
+
+    // Publishes the record started by the last reserve(). Producer only.
+    void commit(quint64 sequence, qsizetype payload) noexcept
+    {
+        const Header header = { quint32(payload), 0, sequence };
+        memcpy(at(reservedAt), &header, sizeof(header));
+        head.store(reservedAt + recordSize(payload), std::memory_order_release);
+    }
+
+    const std::unique_ptr<char[]> data;
+    const qsizetype capacity;
+    quint64 reservedAt = 0;
+    alignas(64) std::atomic<quint64> head = 0;      // written by the producer
+    alignas(64) std::atomic<quint64> tail = 0;      // written by the consumer
+    std::atomic<bool> retired = false;              // the producer has exited
+};
+
+struct LogRingHandle
+{
+    LogRing *ring = nullptr;
+    ~LogRingHandle();
+};
+
+Q_CONSTINIT thread_local LogRingHandle currentRing;
+// Trivially destructible, so it can still be read while thread_local
+// objects are being destroyed
+Q_CONSTINIT thread_local bool currentRingDestroyed = false;
+
+LogRingHandle::~LogRingHandle()
+{
+    currentRingDestroyed = true;
+    if (ring)
+        ring->retired.store(true, std::memory_order_release);
+}
+
+class QAsyncLogger
+{
+public:
+    QAsyncLogger();
+    ~QAsyncLogger();
+
+    bool log(QStringView message);
+    void flush();
+    QtPrivate::QAsyncLoggingStatistics statistics() const noexcept
+    {
+        return { written.load(std::memory_order_relaxed),
+                 dropped.load(std::memory_order_relaxed),
+                 blocked.load(std::memory_order_relaxed) };
+    }
+
+    AsyncLoggingPolicy policy = AsyncLoggingPolicy::Disabled;
+
+#ifdef Q_OS_UNIX
+    static void disableInChild();
+#endif
+
+private:
+    struct Record
+    {
+        quint64 sequence;
+        const char *data;
+        qsizetype size;
+    };
+
+    LogRing *ringForCurrentThread();
+    void wakeWriter();
+    void run();
+    bool hasPendingData();
+    void drain();
+    void write(const std::vector<Record> &records, QByteArrayView notice);
+
+    qsizetype ringCapacity = DefaultRingCapacity;
+
+    QBasicMutex ringsMutex;
+    std::vector<LogRing *> rings;
+
+    QMutex wakeMutex;
+    QWaitCondition wakeCondition;
+    std::atomic<bool> writerSleeping = false;
+    std::atomic<bool> stopping = false;
+
+    // for the threads waiting for space with the block policy
+    QMutex spaceMutex;
+    QWaitCondition spaceCondition;
+    std::atomic<int> waitingForSpace = 0;
+
+    std::atomic<quint64> sequence = 0;
+    std::atomic<quint64> written = 0;
+    std::atomic<quint64> dropped = 0;
+    std::atomic<quint64> blocked = 0;
+
+    // everything below is only used while holding consumerMutex
+    QBasicMutex consumerMutex;
+    quint64 reportedDropped = 0;
+    std::vector<LogRing *> snapshot;
+    std::vector<quint64> snapshotEnds;
+    std::vector<bool> snapshotRetired;
+    std::vector<Record> records;
+
+    std::unique_ptr<std::thread> writer;
+};
+
+QAsyncLogger::QAsyncLogger()
+{
+    const QByteArray mode = qgetenv("QT_LOGGING_ASYNC");
+    if (mode == "block")
+        policy = AsyncLoggingPolicy::Block;
+    else if (mode == "drop" || mode == "1")
+        policy = AsyncLoggingPolicy::Drop;
+    if (policy == AsyncLoggingPolicy::Disabled)
+        return;
+
+    if (const int size = qEnvironmentVariableIntValue("QT_LOGGING_ASYNC_BUFFER_SIZE"); size > 0) {
+        const qsizetype bounded = qBound(MinimumRingCapacity, qsizetype(size), MaximumRingCapacity);
+        ringCapacity = qsizetype(qNextPowerOfTwo(quint64(bounded - 1)));
+    }
+#ifdef Q_OS_UNIX
+    Q_CONSTINIT static bool atForkRegistered = false;
+    if (!std::exchange(atForkRegistered, true))
+        pthread_atfork(nullptr, nullptr, &QAsyncLogger::disableInChild);
+#endif
+    writer = std::make_unique<std::thread>([this] { run(); });
+}
+
+QAsyncLogger::~QAsyncLogger()
+{
+    if (!writer)
+        return;
+
+    stopping.store(true, std::memory_order_release);
+    {
+        QMutexLocker locker(&wakeMutex);
+        wakeCondition.wakeOne();
+    }
+    {
+        QMutexLocker locker(&spaceMutex);
+        spaceCondition.wakeAll();
+    }
+    writer->join();
+    flush();
+
+    // Threads that are still running may hold on to their buffer
+    const auto locker = qt_scoped_lock(ringsMutex);
+    for (LogRing *ring : rings) {
+        if (ring->retired.load(std::memory_order_acquire))
+            delete ring;
+    }
+}
+
+LogRing *QAsyncLogger::ringForCurrentThread()
+{
+    if (currentRingDestroyed)
+        return nullptr;
+    if (Q_LIKELY(currentRing.ring))
+        return currentRing.ring;
+
+    auto ring = new LogRing(ringCapacity);
+    {
+        const auto locker = qt_scoped_lock(ringsMutex);
+        rings.push_back(ring);
+    }
+    currentRing.ring = ring;
+    return ring;
+}
+
+bool QAsyncLogger::log(QStringView message)
+{
+    if (stopping.load(std::memory_order_relaxed))
+        return false;
+
+#ifdef Q_OS_WIN
+    const QByteArray local = message.toLocal8Bit();
+    const qsizetype maxPayload = local.size() + 1;
+#else
+    // worst case of the UTF-8 conversion, and the newline
+    const qsizetype maxPayload = message.size() * 3 + 1;
+#endif
+    if (maxPayload > ringCapacity / 4)
+        return false;
+    LogRing *ring = ringForCurrentThread();
+    if (!ring)
+        return false;
+
+    char *out = ring->reserve(maxPayload);
+    if (!out) {
+        if (policy == AsyncLoggingPolicy::Drop) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        blocked.fetch_add(1, std::memory_order_relaxed);
+        // Pairs with the fence in drain(): either it sees that we are
+        // waiting, or we see the space it freed
+        waitingForSpace.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        QMutexLocker locker(&spaceMutex);
+        while (!(out = ring->reserve(maxPayload))) {
+            if (stopping.load(std::memory_order_relaxed))
+                break;
+            wakeWriter();
+            spaceCondition.wait(&spaceMutex);
+        }
+        locker.unlock();
+        waitingForSpace.fetch_sub(1, std::memory_order_relaxed);
+        if (!out)
+            return false;
+    }
+
+#ifdef Q_OS_WIN
+    memcpy(out, local.constData(), local.size());
+    char *end = out + local.size();
+#else
+    QStringConverter::State state(QStringConverter::Flag::Stateless);
+    char *end = QUtf8::convertFromUnicode(out, message, &state);
+#endif
+    *end++ = '\n';
+    ring->commit(sequence.fetch_add(1, std::memory_order_relaxed), end - out);
+    wakeWriter();
+    return true;
+}
+
+void QAsyncLogger::wakeWriter()
+{
+    // Pairs with the fence in run(): either the writer sees our record
+    // before going to sleep, or we see that it is sleeping
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (writerSleeping.load(std::memory_order_relaxed)
+            && writerSleeping.exchange(false, std::memory_order_relaxed)) {
+        QMutexLocker locker(&wakeMutex);
+        wakeCondition.wakeOne();
+    }
+}
+
+void QAsyncLogger::run()
+{
+    while (true) {
+        flush();
+        if (stopping.load(std::memory_order_acquire))
+            return;
+
+        QMutexLocker locker(&wakeMutex);
+        writerSleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!stopping.load(std::memory_order_relaxed) && !hasPendingData())
+            wakeCondition.wait(&wakeMutex);
+        writerSleeping.store(false, std::memory_order_relaxed);
+    }
+}
+
+bool QAsyncLogger::hasPendingData()
+{
+    const auto locker = qt_scoped_lock(ringsMutex);
+    return std::any_of(rings.cbegin(), rings.cend(), [](const LogRing *ring) {
+        return ring->head.load(std::memory_order_relaxed)
+                != ring->tail.load(std::memory_order_relaxed);
+    });
+}
+
+void QAsyncLogger::flush()
+{
+    const auto locker = qt_scoped_lock(consumerMutex);
+    drain();
+}
+
+void QAsyncLogger::drain()
+{
+    {
+        const auto locker = qt_scoped_lock(ringsMutex);
+        snapshot = rings;
+    }
+    snapshotEnds.resize(snapshot.size());
+    snapshotRetired.resize(snapshot.size());
+    records.clear();
+
+    bool anyRetired = false;
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        LogRing *ring = snapshot[i];
+        // check before reading head, so that a retired buffer is known to
+        // be complete
+        snapshotRetired[i] = ring->retired.load(std::memory_order_acquire);
+        anyRetired |= snapshotRetired[i];
+
+        quint64 position = ring->tail.load(std::memory_order_relaxed);
+        const quint64 end = ring->head.load(std::memory_order_acquire);
+        while (position != end) {
+            LogRing::Header header;
+            memcpy(&header, ring->at(position), sizeof(header));
+            if (header.size == LogRing::WrapMarker) {
+                position += ring->capacity - qsizetype(position & (ring->capacity - 1));
+                continue;
+            }
+            records.push_back({ header.sequence, ring->at(position) + sizeof(header),
+                                qsizetype(header.size) });
+            position += LogRing::recordSize(header.size);
+        }
+        snapshotEnds[i] = end;
+    }
+
+    std::sort(records.begin(), records.end(), [](const Record &lhs, const Record &rhs) {
+        return lhs.sequence < rhs.sequence;
+    });
+
+    char notice[64];
+    qsizetype noticeSize = 0;
+    const quint64 droppedNow = dropped.load(std::memory_order_relaxed);
+    if (droppedNow != reportedDropped) {
+        noticeSize = snprintf(notice, sizeof(notice), "QAsyncLogger: %llu messages dropped\n",
+                               droppedNow - reportedDropped);
+        reportedDropped = droppedNow;
+    }
+    if (!records.empty() || noticeSize)
+        write(records, QByteArrayView(notice, noticeSize));
+    written.fetch_add(records.size(), std::memory_order_relaxed);
+
+    for (size_t i = 0; i < snapshot.size(); ++i)
+        snapshot[i]->tail.store(snapshotEnds[i], std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waitingForSpace.load(std::memory_order_relaxed)) {
+        QMutexLocker locker(&spaceMutex);
+        spaceCondition.wakeAll();
+    }
+
+    if (anyRetired) {
+        const auto locker = qt_scoped_lock(ringsMutex);
+        for (size_t i = 0; i < snapshot.size(); ++i) {
+            if (!snapshotRetired[i])
+                continue;
+            rings.erase(std::find(rings.begin(), rings.end(), snapshot[i]));
+            delete snapshot[i];
+        }
+    }
+}
+
+#ifdef Q_OS_UNIX
+static void writeToStderr(iovec *iov, int count)
+{
+    while (count) {
+        ssize_t n = ::writev(STDERR_FILENO, iov, count);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return;
+        }
+        while (count && size_t(n) >= iov->iov_len) {
+            n -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+        if (count) {
+            iov->iov_base = static_cast<char *>(iov->iov_base) + n;
+            iov->iov_len -= n;
+        }
+    }
+}
+
+void QAsyncLogger::write(const std::vector<Record> &records, QByteArrayView notice)
+{
+#  ifdef IOV_MAX
+    constexpr int MaxVectors = IOV_MAX < 1024 ? IOV_MAX : 1024;
+#  else
+    constexpr int MaxVectors = 16;
+#  endif
+    iovec vectors[MaxVectors];
+    int count = 0;
+    const auto append = [&](const char *data, qsizetype size) {
+        if (count == MaxVectors) {
+            writeToStderr(vectors, count);
+            count = 0;
+        }
+        vectors[count].iov_base = const_cast<char *>(data);
+        vectors[count].iov_len = size_t(size);
+        ++count;
+    };
+    for (const Record &record : records)
+        append(record.data, record.size);
+    if (!notice.isEmpty())
+        append(notice.data(), notice.size());
+    writeToStderr(vectors, count);
+}
+#else
+void QAsyncLogger::write(const std::vector<Record> &records, QByteArrayView notice)
+{
+    for (const Record &record : records)
+        fwrite(record.data, 1, size_t(record.size), stderr);
+    if (!notice.isEmpty())
+        fwrite(notice.data(), 1, size_t(notice.size()), stderr);
+    fflush(stderr);
+}
+#endif
+
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QAsyncLogger, asyncLogger)
+
+#ifdef Q_OS_UNIX
+/*
+    Called in the child process after a fork(). Only the forking thread
+    exists there: there is no writer to queue messages for, and the locks
+    may have been held by threads of the parent. What the parent had queued
+    is written by the parent.
+*/
+void QAsyncLogger::disableInChild()
+{
+    if (!asyncLogger.exists() || asyncLogger.isDestroyed())
+        return;
+    QAsyncLogger *logger = asyncLogger();
+    logger->policy = AsyncLoggingPolicy::Disabled;
+    // the thread handle refers to a thread of the parent; it must neither
+    // be joined nor destroyed
+    Q_UNUSED(logger->writer.release());
+}
+#endif
+
+namespace QtPrivate {
+
+bool asyncLogMessage(QStringView formattedMessage)
+{
+    QAsyncLogger *logger = asyncLogger();
+    return logger && logger->policy != AsyncLoggingPolicy::Disabled
+            && logger->log(formattedMessage);
+}
+
+/*!
+    \internal
+
+    Writes all messages queued for the asynchronous logger, if it is
+    enabled, before returning.
+*/
+void flushAsyncLogging()
+{
+    QAsyncLogger *logger = asyncLogger();
+    if (logger && logger->policy != AsyncLoggingPolicy::Disabled)
+        logger->flush();
+}
+
+/*!
+    \internal
+
+    Returns the counters of the asynchronous logger.
+*/
+QAsyncLoggingStatistics asyncLoggingStatistics()
+{
+    QAsyncLogger *logger = asyncLogger();
+    return logger ? logger->statistics() : QAsyncLoggingStatistics();
+}
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
@@ -0,0 +1,46 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QASYNCLOGGER_P_H
+#define QASYNCLOGGER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of a number of Qt sources files.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qstringview.h>
+
+QT_REQUIRE_CONFIG(thread);
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+struct QAsyncLoggingStatistics
+{
+    quint64 written = 0;    // messages written to stderr by the writer
+    quint64 dropped = 0;    // messages discarded because a buffer was full
+    quint64 blocked = 0;    // messages that had to wait for buffer space
+};
+
+// Queues a formatted message (without the trailing newline) for the
+// background writer. Returns false if asynchronous logging is disabled or
+// the message could not be queued, in which case the caller must write it.
+bool asyncLogMessage(QStringView formattedMessage);
+
+Q_CORE_EXPORT void flushAsyncLogging();
+Q_CORE_EXPORT QAsyncLoggingStatistics asyncLoggingStatistics();
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
+
+#endif // QASYNCLOGGER_P_H
@@ -24,6 +24,12 @@
 #include "private/qloggingregistry_p.h"
 #include "private/qcoreapplication_p.h"
 #include <qtcore_tracepoints_p.h>
+#if QT_CONFIG(thread)
+#include "private/qasynclogger_p.h"
+#endif
+#if QT_CONFIG(cborstreamwriter)
+#include "qstructuredlog_p.h"
+#endif
 #endif
 #ifdef Q_OS_WIN
 #include <qt_windows.h>
@@ -172,6 +178,10 @@ Q_NORETURN
 #endif
 static void qt_message_fatal(QtMsgType, const QMessageLogContext &context, String &&message);
 static void qt_message_print(QtMsgType, const QMessageLogContext &context, const QString &message);
+#if QT_CONFIG(cborstreamwriter) && !defined(QT_BOOTSTRAPPED)
+static bool qt_message_record(QtMsgType, const QMessageLogContext &context, const char *format,
+                              va_list ap);
+#endif
 static void preformattedMessageHandler(QtMsgType type, const QMessageLogContext &context,
                                        const QString &formattedMessage);
 static QString formatLogMessage(QtMsgType type, const QMessageLogContext &context, const QString &str);
@@ -375,6 +385,12 @@ static inline void convert_to_wchar_t_elided(wchar_t *d, size_t space, const cha
 Q_NEVER_INLINE
 static void qt_message(QtMsgType msgType, const QMessageLogContext &context, const char *msg, va_list ap)
 {
+#if QT_CONFIG(cborstreamwriter) && !defined(QT_BOOTSTRAPPED)
+    if (!isFatal(msgType) && QtPrivate::structuredLoggingEnabled()
+            && qt_message_record(msgType, context, msg, ap)) {
+        return;
+    }
+#endif
     QString buf = QString::vasprintf(msg, ap);
     qt_message_print(msgType, context, buf);
 
@@ -940,6 +956,16 @@ static bool isDefaultCategory(const char *category)
     return !category || strcmp(category, "default") == 0;
 }
 
+static bool isDefaultCategoryDisabled(QtMsgType msgType, const char *category)
+{
+    // qDebug, qWarning, ... macros do not check whether category is enabled
+    if (msgType != QtFatalMsg && isDefaultCategory(category)) {
+        if (QLoggingCategory *defaultCategory = QLoggingCategory::defaultCategory())
+            return !defaultCategory->isEnabled(msgType);
+    }
+    return false;
+}
+
 /*!
     \internal
 */
@@ -1960,13 +1986,20 @@ static bool wasm_default_message_handler(QtMsgType type,
 static void stderr_message_handler(QtMsgType type, const QMessageLogContext &context,
                                    const QString &formattedMessage)
 {
-    Q_UNUSED(type);
     Q_UNUSED(context);
 
     // print nothing if message pattern didn't apply / was empty.
     // (still print empty lines, e.g. because message itself was empty)
     if (formattedMessage.isNull())
         return;
+#if QT_CONFIG(thread) && !defined(QT_BOOTSTRAPPED)
+    if (type != QtFatalMsg && QtPrivate::asyncLogMessage(formattedMessage))
+        return;
+    // keep the order with the messages still queued for the writer
+    QtPrivate::flushAsyncLogging();
+#else
+    Q_UNUSED(type);
+#endif
     fprintf(stderr, "%s\n", formattedMessage.toLocal8Bit().constData());
     fflush(stderr);
 }
@@ -2065,13 +2098,8 @@ static void qt_message_print(QtMsgType msgType, const QMessageLogContext &contex
 #ifndef QT_BOOTSTRAPPED
     Q_TRACE(qt_message_print, msgType, context.category, context.function, context.file, context.line, message);
 
-    // qDebug, qWarning, ... macros do not check whether category is enabledgc
-    if (msgType != QtFatalMsg && isDefaultCategory(context.category)) {
-        if (QLoggingCategory *defaultCategory = QLoggingCategory::defaultCategory()) {
-            if (!defaultCategory->isEnabled(msgType))
-                return;
-        }
-    }
+    if (isDefaultCategoryDisabled(msgType, context.category))
+        return;
 #endif
 
     // prevent recursion in case the message handler generates messages
@@ -2079,12 +2107,37 @@ static void qt_message_print(QtMsgType msgType, const QMessageLogContext &contex
     if (grabMessageHandler()) {
         const auto ungrab = qScopeGuard([]{ ungrabMessageHandler(); });
         auto msgHandler = messageHandler.loadAcquire();
+#if QT_CONFIG(cborstreamwriter) && !defined(QT_BOOTSTRAPPED)
+        if (!msgHandler && !isFatal(msgType) && QtPrivate::structuredLoggingEnabled()
+                && QtPrivate::structuredLogMessage(msgType, context, qt_gettid(), message)) {
+            return;
+        }
+#endif
         (msgHandler ? msgHandler : qDefaultMessageHandler)(msgType, context, message);
     } else {
         stderr_message_handler(msgType, context, message);
     }
 }
 
+#if QT_CONFIG(cborstreamwriter) && !defined(QT_BOOTSTRAPPED)
+/*!
+    \internal
+
+    Records a printf-style message in the structured log instead of
+    formatting it, unless a message handler is installed. Returns false if
+    the message still needs to be formatted and printed.
+*/
+static bool qt_message_record(QtMsgType msgType, const QMessageLogContext &context,
+                              const char *format, va_list ap)
+{
+    if (messageHandler.loadAcquire())
+        return false;
+    if (isDefaultCategoryDisabled(msgType, context.category))
+        return true;
+    return QtPrivate::structuredLogMessage(msgType, context, qt_gettid(), format, ap);
+}
+#endif
+
 template <typename String>
 static void qt_message_fatal(QtMsgType, const QMessageLogContext &context, String &&message)
 {
@@ -2113,6 +2166,12 @@ static void qt_message_fatal(QtMsgType, const QMessageLogContext &context, Strin
         message.clear();
     else
         Q_UNUSED(message);
+#if QT_CONFIG(thread) && !defined(QT_BOOTSTRAPPED)
+    QtPrivate::flushAsyncLogging();
+#endif
+#if QT_CONFIG(cborstreamwriter) && !defined(QT_BOOTSTRAPPED)
+    QtPrivate::flushStructuredLogging();
+#endif
     qAbort();
 }
 
@@ -2207,6 +2266,25 @@ void qErrnoWarning(int code, const char *msg, ...)
     operations might block the application. Also, to avoid recursion, any
     logging messages generated in the message handler itself will be ignored.
 
+    When the default message handler writes to stderr, it can do so on a
+    background thread: setting the \c QT_LOGGING_ASYNC environment variable
+    to \c drop or \c block makes the logging threads only format the message
+    and queue it in a per-thread buffer. With \c drop, messages that do not
+    fit in the buffer are discarded, and their number is reported in the
+    output; with \c block, the logging thread waits for the buffer to drain.
+    The size of each buffer, in bytes, can be set with
+    \c QT_LOGGING_ASYNC_BUFFER_SIZE. Queued messages are written before a
+    fatal message, and when the application exits.
+
+    As long as no message handler is installed, messages can also be
+    recorded in a binary file instead of being printed: setting the
+    \c QT_LOGGING_STRUCTURED environment variable to the path of a file
+    makes Qt store the format string and the arguments of printf-style
+    messages without formatting them, and the text of streamed messages,
+    together with their category, location, thread and time stamp. The
+    \c qtlogdecode tool prints the recorded messages as text. Fatal messages
+    are still printed.
+
     The message handler should always return. For
     \l{QtFatalMsg}{fatal messages}, the application aborts immediately after
     handling that message.
@@ -0,0 +1,856 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qstructuredlog_p.h"
+
+#include <QtCore/qbuffer.h>
+#include <QtCore/qcborstreamwriter.h>
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qglobalstatic.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qnumeric.h>
+#include <QtCore/qvarlengtharray.h>
+#include <QtCore/private/qlocking_p.h>
+#include <QtCore/private/qtools_p.h>
+
+#include <limits>
+
+#include <stdio.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+/*
+    Structured logging records messages in a binary file instead of writing
+    them as text. It is enabled by setting QT_LOGGING_STRUCTURED to the path
+    of the file, and only applies when no message handler is installed.
+
+    For printf-style messages (qDebug("%d", i)), the format string and the
+    arguments are recorded, typed by their QMetaType; the message is not
+    formatted at all. Messages streamed with QDebug are recorded as their
+    text. The file is then decoded, and the messages formatted, by
+    qtlogdecode or QStructuredLogReader.
+
+    The file is a CBOR sequence (RFC 8742) of these items:
+
+     - a header map { "qtlog": 1, "pid": <pid>, "start": <ms since epoch> },
+       which also resets the string table;
+     - string definitions [0, id, bytes], which assign the next id to a
+       category, file, function or format string. Later items refer to the
+       string by its id, so each of them is stored only once;
+     - records [1, type, timestamp, thread, category, file, line, function,
+       format, [argument type, argument value, ...]], where the timestamp
+       is in nanoseconds since the header was written, the strings are ids
+       or null, and the argument list has an indefinite length.
+
+    A record without a format holds the streamed text as its only argument.
+*/
+
+namespace {
+
+constexpr int FormatVersion = 1;
+enum ItemKind { StringDefinition = 0, Record = 1 };
+
+enum LengthModifier { lm_none, lm_hh, lm_h, lm_l, lm_ll, lm_L, lm_j, lm_z, lm_t };
+
+struct Conversion
+{
+    const char *flagsBegin = nullptr;
+    const char *flagsEnd = nullptr;
+    const char *widthBegin = nullptr;
+    const char *widthEnd = nullptr;
+    const char *precisionBegin = nullptr;   // at the '.', if any
+    const char *precisionEnd = nullptr;
+    int width = -1;                         // -1 means unspecified
+    int precision = -1;
+    bool widthFromArgument = false;
+    bool precisionFromArgument = false;
+    LengthModifier length = lm_none;
+    char specifier = 0;
+};
+
+static bool isFlagCharacter(char c) noexcept
+{
+    return c == '#' || c == '0' || c == '-' || c == ' ' || c == '+' || c == '\'';
+}
+
+// Like QString::vasprintf(), consumes all digits and treats overflows as 0
+static int parseFieldWidth(const char *&c) noexcept
+{
+    qulonglong result = 0;
+    bool overflow = false;
+    for (; QtMiscUtils::isAsciiDigit(*c); ++c) {
+        overflow |= qMulOverflow(result, qulonglong(10), &result)
+                || qAddOverflow(result, qulonglong(*c - '0'), &result);
+    }
+    return !overflow && result < qulonglong(std::numeric_limits<int>::max()) ? int(result) : 0;
+}
+
+static LengthModifier parseLengthModifier(const char *&c) noexcept
+{
+    switch (*c++) {
+    case 'h': return *c == 'h' ? (++c, lm_hh) : lm_h;
+    case 'l': return *c == 'l' ? (++c, lm_ll) : lm_l;
+    case 'L': return lm_L;
+    case 'j': return lm_j;
+    case 'z':
+    case 'Z': return lm_z;
+    case 't': return lm_t;
+    }
+    --c;
+    return lm_none;
+}
+
+// Walks a printf-style format exactly like QString::vasprintf() does, so
+// that recording and formatting consume the same arguments. The handler is
+// called with the literal text, for each '*' width or precision, and for
+// each conversion.
+template <typename Handler>
+static bool walkFormat(const char *format, Handler &handler)
+{
+    const char *c = format;
+    for (;;) {
+        const char *text = c;
+        while (*c != '\0' && *c != '%')
+            ++c;
+        handler.text(text, c - text);
+        if (*c == '\0')
+            return true;
+
+        const char *escapeStart = c++;
+        if (*c == '\0' || *c == '%') {
+            handler.text("%", 1);
+            if (*c == '\0')
+                return true;
+            ++c;
+            continue;
+        }
+
+        Conversion conversion;
+        conversion.flagsBegin = c;
+        while (isFlagCharacter(*c))
+            ++c;
+        conversion.flagsEnd = c;
+        const auto incomplete = [&] {
+            handler.text(escapeStart, c - escapeStart);
+            return true;
+        };
+        if (*c == '\0')
+            return incomplete();
+
+        conversion.widthBegin = c;
+        if (QtMiscUtils::isAsciiDigit(*c)) {
+            conversion.width = parseFieldWidth(c);
+        } else if (*c == '*') {
+            conversion.widthFromArgument = true;
+            if (!handler.star(&conversion.width))
+                return false;
+            ++c;
+        }
+        conversion.widthEnd = c;
+        if (*c == '\0')
+            return incomplete();
+
+        if (*c == '.') {
+            conversion.precisionBegin = c++;
+            conversion.precision = 0;
+            if (QtMiscUtils::isAsciiDigit(*c)) {
+                conversion.precision = parseFieldWidth(c);
+            } else if (*c == '*') {
+                conversion.precisionFromArgument = true;
+                if (!handler.star(&conversion.precision))
+                    return false;
+                ++c;
+            }
+            conversion.precisionEnd = c;
+        }
+        if (*c == '\0')
+            return incomplete();
+
+        conversion.length = parseLengthModifier(c);
+        if (*c == '\0')
+            return incomplete();
+
+        switch (*c) {
+        case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+        case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+        case 'c': case 's': case 'p': case 'n':
+            conversion.specifier = *c++;
+            if (!handler.conversion(conversion))
+                return false;
+            break;
+        default: // bad escape, treat as non-escape text
+            handler.text(escapeStart, c - escapeStart);
+            break;
+        }
+    }
+}
+
+struct FormatArgument
+{
+    QMetaType::Type type;
+    union {
+        qint64 integer;
+        quint64 unsignedInteger;
+        double real;
+        const char *string;
+        const char16_t *utf16;
+    };
+    qsizetype size = 0;
+};
+using FormatArguments = QVarLengthArray<FormatArgument, 8>;
+
+// Reads the arguments of a format from a va_list, the way vasprintf() does
+struct ArgumentRecorder
+{
+    va_list *ap;
+    FormatArguments &arguments;
+
+    void text(const char *, qsizetype) {}
+
+    bool star(int *value)
+    {
+        *value = va_arg(*ap, int);
+        FormatArgument &argument = arguments.emplace_back();
+        argument.type = QMetaType::Int;
+        argument.integer = *value;
+        if (*value < 0)
+            *value = -1;
+        return true;
+    }
+
+    bool conversion(const Conversion &conversion)
+    {
+        FormatArgument argument;
+        switch (conversion.specifier) {
+        case 'd':
+        case 'i':
+            argument.type = QMetaType::LongLong;
+            switch (conversion.length) {
+            case lm_l: argument.integer = va_arg(*ap, long int); break;
+            case lm_ll: argument.integer = va_arg(*ap, qint64); break;
+            case lm_j: argument.integer = va_arg(*ap, long int); break;
+            case lm_z:
+            case lm_t: argument.integer = va_arg(*ap, qsizetype); break;
+            default: argument.integer = va_arg(*ap, int); break;
+            }
+            break;
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+            argument.type = QMetaType::ULongLong;
+            switch (conversion.length) {
+            case lm_l: argument.unsignedInteger = va_arg(*ap, ulong); break;
+            case lm_ll: argument.unsignedInteger = va_arg(*ap, quint64); break;
+            case lm_z:
+            case lm_t: argument.unsignedInteger = va_arg(*ap, size_t); break;
+            default: argument.unsignedInteger = va_arg(*ap, uint); break;
+            }
+            break;
+        case 'c':
+            argument.type = conversion.length == lm_l ? QMetaType::QChar : QMetaType::Char;
+            argument.integer = va_arg(*ap, int);
+            break;
+        case 's':
+            if (conversion.length == lm_l) {
+                argument.type = QMetaType::QString;
+                argument.utf16 = va_arg(*ap, const char16_t *);
+                qsizetype length = 0;
+                while (length != conversion.precision && argument.utf16[length] != 0)
+                    ++length;
+                argument.size = length;
+            } else {
+                argument.type = QMetaType::QByteArray;
+                argument.string = va_arg(*ap, const char *);
+                if (!argument.string)
+                    argument.string = "";
+                argument.size = conversion.precision < 0 ? qsizetype(qstrlen(argument.string))
+                                                         : qsizetype(qstrnlen(argument.string, conversion.precision));
+            }
+            break;
+        case 'p':
+            argument.type = QMetaType::VoidStar;
+            argument.unsignedInteger = quintptr(va_arg(*ap, void *));
+            break;
+        case 'n':
+            // writes back into the arguments; must be formatted right away
+            return false;
+        default:
+            argument.type = QMetaType::Double;
+            if (conversion.length == lm_L)
+                argument.real = double(va_arg(*ap, long double));
+            else
+                argument.real = va_arg(*ap, double);
+            break;
+        }
+        arguments.append(argument);
+        return true;
+    }
+};
+
+// Formats recorded arguments, one conversion at a time, with QString::asprintf()
+struct ArgumentFormatter
+{
+    const QVariantList &arguments;
+    qsizetype next = 0;
+    QString result;
+
+    QVariant take() { return arguments.value(next++); }
+
+    void text(const char *text, qsizetype size) { result += QUtf8StringView(text, size); }
+
+    bool star(int *value)
+    {
+        *value = take().toInt();
+        if (*value < 0)
+            *value = -1;
+        return true;
+    }
+
+    bool conversion(const Conversion &conversion)
+    {
+        QByteArray spec = "%";
+        spec += QByteArrayView(conversion.flagsBegin, conversion.flagsEnd);
+        if (!conversion.widthFromArgument)
+            spec += QByteArrayView(conversion.widthBegin, conversion.widthEnd);
+        else if (conversion.width >= 0)
+            spec += QByteArray::number(conversion.width);
+        if (conversion.precisionBegin && !conversion.precisionFromArgument)
+            spec += QByteArrayView(conversion.precisionBegin, conversion.precisionEnd);
+        else if (conversion.precisionBegin && conversion.precision >= 0)
+            spec += '.' + QByteArray::number(conversion.precision);
+
+        const char specifier = conversion.specifier;
+        switch (specifier) {
+        case 'd':
+        case 'i':
+            spec += "ll";
+            spec += specifier;
+            result += QString::asprintf(spec.constData(), take().toLongLong());
+            break;
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+            spec += "ll";
+            spec += specifier;
+            result += QString::asprintf(spec.constData(), take().toULongLong());
+            break;
+        case 'c':
+            if (conversion.length == lm_l)
+                spec += 'l';
+            spec += 'c';
+            result += QString::asprintf(spec.constData(), take().toInt());
+            break;
+        case 's':
+            if (conversion.length == lm_l) {
+                const QString string = take().toString();
+                result += QString::asprintf(spec.append("ls").constData(), string.utf16());
+            } else {
+                const QByteArray string = take().toByteArray();
+                result += QString::asprintf(spec.append('s').constData(), string.constData());
+            }
+            break;
+        case 'p':
+            spec += 'p';
+            result += QString::asprintf(spec.constData(),
+                                        reinterpret_cast<void *>(quintptr(take().toULongLong())));
+            break;
+        case 'n':
+            break;
+        default:
+            spec += specifier;
+            result += QString::asprintf(spec.constData(), take().toDouble());
+            break;
+        }
+        return true;
+    }
+};
+
+Q_CONSTINIT thread_local bool writingRecord = false;
+
+class QStructuredLogWriter
+{
+public:
+    QStructuredLogWriter();
+    ~QStructuredLogWriter();
+
+    bool isOpen() const noexcept { return file != nullptr; }
+    qint64 elapsed() const noexcept { return timer.nsecsElapsed(); }
+
+    void write(QtMsgType type, const QMessageLogContext &context, qint64 threadId,
+               qint64 timestamp, const char *format, const FormatArguments &arguments);
+    void write(QtMsgType type, const QMessageLogContext &context, qint64 threadId,
+               qint64 timestamp, QStringView message);
+    void flush();
+
+private:
+    void writeRecordStart(QtMsgType type, const QMessageLogContext &context, qint64 threadId,
+                          qint64 timestamp, const char *format);
+    void writeRecordEnd(QtMsgType type);
+    qint64 intern(const char *string);
+    void appendStringReference(qint64 id);
+
+    FILE *file = nullptr;
+    QElapsedTimer timer;
+    QBasicMutex mutex;
+    QByteArray pending;
+    QBuffer device;
+    QCborStreamWriter cbor;
+    QHash<const char *, qint64> idsByAddress;
+    QHash<QByteArray, qint64> idsByContent;
+    QList<QByteArray> strings;
+};
+
+QStructuredLogWriter::QStructuredLogWriter()
+    : device(&pending), cbor(&device)
+{
+    const QString path = qEnvironmentVariable("QT_LOGGING_STRUCTURED");
+    if (path.isEmpty())
+        return;
+#ifdef Q_OS_WIN
+    file = _wfopen(reinterpret_cast<const wchar_t *>(path.utf16()), L"wb");
+#else
+    file = fopen(path.toLocal8Bit().constData(), "wb");
+#endif
+    if (!file)
+        return;
+    setvbuf(file, nullptr, _IOFBF, 64 * 1024);
+    device.open(QIODevice::WriteOnly | QIODevice::Unbuffered);
+    timer.start();
+
+    cbor.startMap(3);
+    cbor.append("qtlog"_L1);
+    cbor.append(FormatVersion);
+    cbor.append("pid"_L1);
+    cbor.append(QCoreApplication::applicationPid());
+    cbor.append("start"_L1);
+    cbor.append(QDateTime::currentMSecsSinceEpoch());
+    cbor.endMap();
+    flush();
+}
+
+QStructuredLogWriter::~QStructuredLogWriter()
+{
+    if (file)
+        fclose(file);
+}
+
+qint64 QStructuredLogWriter::intern(const char *string)
+{
+    if (!string)
+        return -1;
+    // Category names, files and functions are usually literals: look them
+    // up by address first, and check that the contents didn't change
+    if (auto it = idsByAddress.constFind(string); it != idsByAddress.cend()) {
+        if (qstrcmp(strings.at(*it), string) == 0)
+            return *it;
+    }
+    const QByteArray content(string);
+    qint64 id = idsByContent.value(content, -1);
+    if (id < 0) {
+        id = strings.size();
+        strings.append(content);
+        idsByContent.insert(content, id);
+        cbor.startArray(3);
+        cbor.append(StringDefinition);
+        cbor.append(id);
+        cbor.appendByteString(content.constData(), content.size());
+        cbor.endArray();
+    }
+    idsByAddress.insert(string, id);
+    return id;
+}
+
+void QStructuredLogWriter::appendStringReference(qint64 id)
+{
+    if (id < 0)
+        cbor.appendNull();
+    else
+        cbor.append(id);
+}
+
+void QStructuredLogWriter::writeRecordStart(QtMsgType type, const QMessageLogContext &context,
+                                            qint64 threadId, qint64 timestamp, const char *format)
+{
+    // string definitions go before the record referring to them
+    const qint64 category = intern(context.category);
+    const qint64 fileName = intern(context.file);
+    const qint64 function = intern(context.function);
+    const qint64 formatId = intern(format);
+
+    cbor.startArray(10);
+    cbor.append(Record);
+    cbor.append(int(type));
+    cbor.append(timestamp);
+    cbor.append(threadId);
+    appendStringReference(category);
+    appendStringReference(fileName);
+    cbor.append(context.line);
+    appendStringReference(function);
+    appendStringReference(formatId);
+    cbor.startArray();
+}
+
+void QStructuredLogWriter::writeRecordEnd(QtMsgType type)
+{
+    cbor.endArray();
+    cbor.endArray();
+    fwrite(pending.constData(), 1, size_t(pending.size()), file);
+    pending.clear();
+    device.seek(0);
+    if (type == QtCriticalMsg || type == QtFatalMsg)
+        fflush(file);
+}
+
+void QStructuredLogWriter::write(QtMsgType type, const QMessageLogContext &context,
+                                 qint64 threadId, qint64 timestamp, const char *format,
+                                 const FormatArguments &arguments)
+{
+    const auto locker = qt_scoped_lock(mutex);
+    writeRecordStart(type, context, threadId, timestamp, format);
+    for (const FormatArgument &argument : arguments) {
+        cbor.append(int(argument.type));
+        switch (argument.type) {
+        case QMetaType::ULongLong:
+        case QMetaType::VoidStar:
+            cbor.append(argument.unsignedInteger);
+            break;
+        case QMetaType::Double:
+            cbor.append(argument.real);
+            break;
+        case QMetaType::QByteArray:
+            cbor.appendByteString(argument.string, argument.size);
+            break;
+        case QMetaType::QString:
+            cbor.append(QStringView(argument.utf16, argument.size));
+            break;
+        default:
+            cbor.append(argument.integer);
+            break;
+        }
+    }
+    writeRecordEnd(type);
+}
+
+void QStructuredLogWriter::write(QtMsgType type, const QMessageLogContext &context,
+                                 qint64 threadId, qint64 timestamp, QStringView message)
+{
+    const auto locker = qt_scoped_lock(mutex);
+    writeRecordStart(type, context, threadId, timestamp, nullptr);
+    cbor.append(int(QMetaType::QString));
+    cbor.append(message);
+    writeRecordEnd(type);
+}
+
+void QStructuredLogWriter::flush()
+{
+    if (!pending.isEmpty()) {
+        fwrite(pending.constData(), 1, size_t(pending.size()), file);
+        pending.clear();
+        device.seek(0);
+    }
+    fflush(file);
+}
+
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QStructuredLogWriter, structuredLogWriter)
+
+namespace QtPrivate {
+
+bool structuredLoggingEnabled()
+{
+    static const bool requested = qEnvironmentVariableIsSet("QT_LOGGING_STRUCTURED");
+    return requested;
+}
+
+bool structuredLogMessage(QtMsgType type, const QMessageLogContext &context, qint64 threadId,
+                          const char *format, va_list ap)
+{
+    QStructuredLogWriter *writer = structuredLogWriter();
+    if (!writer || !writer->isOpen() || writingRecord || !format)
+        return false;
+    const qint64 timestamp = writer->elapsed();
+
+    // a va_list parameter may have decayed to a pointer; take a real one
+    va_list args;
+    va_copy(args, ap);
+    FormatArguments arguments;
+    ArgumentRecorder recorder{ &args, arguments };
+    const bool recorded = walkFormat(format, recorder);
+    va_end(args);
+    if (!recorded)
+        return false;
+
+    writingRecord = true;
+    writer->write(type, context, threadId, timestamp, format, arguments);
+    writingRecord = false;
+    return true;
+}
+
+bool structuredLogMessage(QtMsgType type, const QMessageLogContext &context, qint64 threadId,
+                          QStringView message)
+{
+    QStructuredLogWriter *writer = structuredLogWriter();
+    if (!writer || !writer->isOpen() || writingRecord)
+        return false;
+    const qint64 timestamp = writer->elapsed();
+
+    writingRecord = true;
+    writer->write(type, context, threadId, timestamp, message);
+    writingRecord = false;
+    return true;
+}
+
+/*!
+    \internal
+
+    Writes the buffered structured log records to the file.
+*/
+void flushStructuredLogging()
+{
+    if (!structuredLoggingEnabled())
+        return;
+    QStructuredLogWriter *writer = structuredLogWriter();
+    if (writer && writer->isOpen())
+        writer->flush();
+}
+
+/*!
+    \internal
+
+    Formats \a format with the \a arguments recorded for a structured log
+    message, producing the same text as QString::asprintf() would have.
+*/
+QString formatStructuredLogMessage(const char *format, const QVariantList &arguments)
+{
+    if (!format || !*format)
+        return QString::fromLatin1("");
+    ArgumentFormatter formatter{ arguments };
+    walkFormat(format, formatter);
+    return formatter.result;
+}
+
+} // namespace QtPrivate
+
+/*!
+    \internal
+
+    Returns the text of the message.
+*/
+QString QStructuredLogRecord::message() const
+{
+    if (format.isNull())
+        return arguments.value(0).toString();
+    return QtPrivate::formatStructuredLogMessage(format.constData(), arguments);
+}
+
+#if QT_CONFIG(cborstreamreader)
+
+/*!
+    \internal
+    \class QStructuredLogReader
+
+    Reads the records of a structured log file from \a device.
+*/
+QStructuredLogReader::QStructuredLogReader(QIODevice *device)
+    : reader(device)
+{
+}
+
+bool QStructuredLogReader::fail()
+{
+    failed = true;
+    return false;
+}
+
+bool QStructuredLogReader::leaveTopLevelContainer()
+{
+    // Reading from a device, leaving the last item reports the end of the
+    // data, which is only an error in the middle of an item
+    return reader.leaveContainer() || reader.lastError() == QCborError::EndOfFile || fail();
+}
+
+bool QStructuredLogReader::readInteger(qint64 *value)
+{
+    if (!reader.isInteger())
+        return fail();
+    *value = reader.toInteger();
+    return reader.next();
+}
+
+bool QStructuredLogReader::readString(QByteArray *string)
+{
+    if (reader.isByteArray())
+        *string = reader.readAllByteArray();
+    else if (reader.isString())
+        *string = reader.readAllUtf8String();
+    else
+        return fail();
+    if (string->isNull())
+        *string = QByteArray("", 0);
+    return reader.lastError() == QCborError::NoError || fail();
+}
+
+bool QStructuredLogReader::readStringReference(QByteArray *string)
+{
+    if (reader.isNull()) {
+        string->clear();
+        return reader.next();
+    }
+    qint64 id;
+    if (!readInteger(&id) || id < 0 || id >= strings.size())
+        return fail();
+    *string = strings.at(id);
+    return true;
+}
+
+bool QStructuredLogReader::readArgument(QVariantList *arguments)
+{
+    qint64 type;
+    if (!readInteger(&type))
+        return false;
+    switch (type) {
+    case QMetaType::ULongLong:
+    case QMetaType::VoidStar:
+        if (!reader.isUnsignedInteger())
+            return fail();
+        arguments->append(QVariant::fromValue(reader.toUnsignedInteger()));
+        return reader.next();
+    case QMetaType::Double:
+        if (!reader.isDouble())
+            return fail();
+        arguments->append(reader.toDouble());
+        return reader.next();
+    case QMetaType::QByteArray: {
+        QByteArray string;
+        if (!reader.isByteArray() || !readString(&string))
+            return fail();
+        arguments->append(string);
+        return true;
+    }
+    case QMetaType::QString:
+        if (!reader.isString())
+            return fail();
+        arguments->append(reader.readAllString());
+        return reader.lastError() == QCborError::NoError || fail();
+    case QMetaType::LongLong:
+    case QMetaType::Int:
+    case QMetaType::Char:
+    case QMetaType::QChar: {
+        qint64 value;
+        if (!readInteger(&value))
+            return false;
+        if (type == QMetaType::LongLong)
+            arguments->append(value);
+        else if (type == QMetaType::QChar)
+            arguments->append(QChar(char16_t(value)));
+        else
+            arguments->append(int(value));
+        return true;
+    }
+    }
+    return fail();
+}
+
+bool QStructuredLogReader::readHeader()
+{
+    if (!reader.enterContainer())
+        return fail();
+    strings.clear();
+    while (reader.hasNext()) {
+        QString key;
+        if (!reader.isString())
+            return fail();
+        key = reader.readAllString();
+        qint64 value = 0;
+        if (reader.isInteger())
+            value = reader.toInteger();
+        if (!reader.next())
+            return fail();
+        if (key == "qtlog"_L1 && value != FormatVersion)
+            return fail();
+        if (key == "pid"_L1)
+            pid = value;
+        else if (key == "start"_L1)
+            start = value;
+    }
+    return leaveTopLevelContainer();
+}
+
+/*!
+    \internal
+
+    Reads the next record into \a record. Returns false at the end of the
+    data, or if it is not a valid structured log; hasError() tells which.
+*/
+bool QStructuredLogReader::readNext(QStructuredLogRecord *record)
+{
+    while (!failed) {
+        // the file is a sequence of top-level items; start parsing the next
+        if (reader.type() == QCborStreamReader::Invalid && reader.lastError() == QCborError::NoError)
+            reader.reparse();
+        if (reader.lastError() == QCborError::EndOfFile || reader.type() == QCborStreamReader::Invalid)
+            return reader.lastError() == QCborError::EndOfFile ? false : fail();
+        if (reader.isMap()) {
+            if (!readHeader())
+                return false;
+            continue;
+        }
+        if (!reader.isArray() || !reader.enterContainer())
+            return fail();
+
+        qint64 kind;
+        if (!readInteger(&kind))
+            return false;
+        if (kind == StringDefinition) {
+            qint64 id;
+            QByteArray string;
+            if (!readInteger(&id) || id != strings.size() || !readString(&string))
+                return fail();
+            strings.append(string);
+        } else if (kind == Record) {
+            qint64 type, line;
+            *record = QStructuredLogRecord();
+            if (!readInteger(&type) || !readInteger(&record->timestamp)
+                    || !readInteger(&record->threadId)
+                    || !readStringReference(&record->category)
+                    || !readStringReference(&record->file)
+                    || !readInteger(&line)
+                    || !readStringReference(&record->function)
+                    || !readStringReference(&record->format)) {
+                return fail();
+            }
+            record->type = QtMsgType(type);
+            record->line = int(line);
+            if (!reader.isArray() || !reader.enterContainer())
+                return fail();
+            while (reader.hasNext()) {
+                if (!readArgument(&record->arguments))
+                    return false;
+            }
+            if (!reader.leaveContainer())
+                return fail();
+        }
+        // skip what a later version may have added
+        while (reader.hasNext()) {
+            if (!reader.next())
+                return fail();
+        }
+        if (!leaveTopLevelContainer())
+            return false;
+        if (kind == Record)
+            return true;
+    }
+    return false;
+}
+
+#endif // QT_CONFIG(cborstreamreader)
+
+QT_END_NAMESPACE
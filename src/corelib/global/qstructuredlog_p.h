@@ -0,0 +1,102 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSTRUCTUREDLOG_P_H
+#define QSTRUCTUREDLOG_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of a number of Qt sources files.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qlogging.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qvariant.h>
+
+#if QT_CONFIG(cborstreamreader)
+#include <QtCore/qcborstreamreader.h>
+#endif
+
+#include <stdarg.h>
+
+QT_REQUIRE_CONFIG(cborstreamwriter);
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+
+namespace QtPrivate {
+
+bool structuredLoggingEnabled();
+
+// Both return false if the message could not be recorded, in which case the
+// caller must output it as text.
+bool structuredLogMessage(QtMsgType type, const QMessageLogContext &context, qint64 threadId,
+                          const char *format, va_list ap);
+bool structuredLogMessage(QtMsgType type, const QMessageLogContext &context, qint64 threadId,
+                          QStringView message);
+
+Q_CORE_EXPORT void flushStructuredLogging();
+
+// Formats the arguments recorded for a printf-style message the way
+// QString::asprintf() would have
+Q_CORE_EXPORT QString formatStructuredLogMessage(const char *format, const QVariantList &arguments);
+
+} // namespace QtPrivate
+
+struct QStructuredLogRecord
+{
+    QtMsgType type = QtDebugMsg;
+    qint64 timestamp = 0;       // nanoseconds since the process started logging
+    qint64 threadId = 0;
+    QByteArray category;
+    QByteArray file;
+    QByteArray function;
+    int line = 0;
+    QByteArray format;          // null if the message was streamed
+    QVariantList arguments;
+
+    Q_CORE_EXPORT QString message() const;
+};
+
+#if QT_CONFIG(cborstreamreader)
+class Q_CORE_EXPORT QStructuredLogReader
+{
+public:
+    explicit QStructuredLogReader(QIODevice *device);
+
+    bool readNext(QStructuredLogRecord *record);
+    bool hasError() const noexcept { return failed; }
+
+    qint64 processId() const noexcept { return pid; }
+    qint64 startTime() const noexcept { return start; }  // milliseconds since the epoch
+
+private:
+    bool readHeader();
+    bool readString(QByteArray *string);
+    bool readInteger(qint64 *value);
+    bool readStringReference(QByteArray *string);
+    bool readArgument(QVariantList *arguments);
+    bool fail();
+    bool leaveTopLevelContainer();
+
+    QCborStreamReader reader;
+    QList<QByteArray> strings;
+    qint64 pid = 0;
+    qint64 start = 0;
+    bool failed = false;
+};
+#endif // QT_CONFIG(cborstreamreader)
+
+QT_END_NAMESPACE
+
+#endif // QSTRUCTUREDLOG_P_H
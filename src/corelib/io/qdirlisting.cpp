@@ -118,6 +118,17 @@
         When combined with Recursive, symbolic links to directories will be
         iterated too. Symbolic link loops (e.g., link => . or link => ..) are
         automatically detected and ignored.
+
+    \value [since 6.9] Parallel
+        When combined with Recursive, sub-directories are scanned concurrently
+        by tasks running on the global QThreadPool, while the thread that
+        advances the iterator consumes the results. Entries are returned in
+        no particular order; for example, the entries of a sub-directory may
+        be listed before its parent directory itself. Scanning pauses while
+        many entries are waiting to be returned, so memory use stays
+        bounded even if the caller processes them slowly. This flag is ignored
+        for directories handled by a custom file engine (e.g. Qt resources)
+        and when Qt was built without thread support.
 */
 
 #include "qdirlisting.h"
@@ -138,7 +149,16 @@
 #include <QtCore/private/qfileinfo_p.h>
 #include <QtCore/private/qduplicatetracker_p.h>
 
+#if QT_CONFIG(thread) && !defined(QT_NO_FILESYSTEMITERATOR)
+#include <QtCore/qmutex.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qwaitcondition.h>
+
+#include <deque>
+#endif
+
 #include <memory>
+#include <optional>
 #include <vector>
 
 QT_BEGIN_NAMESPACE
@@ -163,6 +183,8 @@ static QDirListing::IteratorFlags toDirListingFlags(QDirIterator::IteratorFlags
 class QDirListingPrivate
 {
 public:
+    ~QDirListingPrivate();
+
     void init(bool resolveEngine);
     void advance();
     void beginIterating();
@@ -171,6 +193,7 @@ public:
     void pushDirectory(QDirEntryInfo &info);
     void pushInitialDirectory();
 
+    bool shouldRecurseInto(QDirEntryInfo &info) const;
     void checkAndPushDirectory(QDirEntryInfo &info);
     bool matchesFilters(QDirEntryInfo &data) const;
     bool hasIterators() const;
@@ -212,8 +235,48 @@ public:
 
     // Loop protection
     QDuplicateTracker<QString> visitedLinks;
+
+#if QT_CONFIG(thread) && !defined(QT_NO_FILESYSTEMITERATOR)
+    // State shared between the iterating thread and the QThreadPool tasks
+    // when iterating with IteratorFlag::Parallel. All members are guarded
+    // by `mutex`, as is visitedLinks while parallel iteration is active,
+    // except for ownScan, which only the iterating thread uses.
+    struct ParallelState
+    {
+        // Helpers stop scanning while this many entries are waiting to be
+        // returned, and resume once half of them have been consumed
+        static constexpr size_t MaxPendingResults = 4096;
+
+        QMutex mutex;
+        QWaitCondition cond;
+        std::deque<QFileSystemEntry> pendingDirs; // waiting to be scanned
+        std::deque<QDirEntryInfo> results; // scanned, waiting to be returned
+        // the directory the iterating thread is scanning itself, if any
+        std::optional<QFileSystemIterator> ownScan;
+        int activeScanners = 0;
+        int helpers = 0;
+        bool canceled = false;
+        bool hasCurrent = false;
+    };
+    std::unique_ptr<ParallelState> parallel;
+
+    bool canIterateInParallel() const;
+    void beginParallelIterating();
+    void stopParallelIterating();
+    void advanceParallel();
+    void runParallelHelper();
+    bool scanDirectory(QFileSystemIterator &it, bool isIteratingThread);
+    void enqueueDirectory(QFileSystemEntry &&dirEntry, const QString &canonicalPath);
+#endif
 };
 
+QDirListingPrivate::~QDirListingPrivate()
+{
+#if QT_CONFIG(thread) && !defined(QT_NO_FILESYSTEMITERATOR)
+    stopParallelIterating();
+#endif
+}
+
 void QDirListingPrivate::init(bool resolveEngine = true)
 {
     if (nameFilters.contains("*"_L1))
@@ -252,11 +315,20 @@ void QDirListingPrivate::init(bool resolveEngine = true)
 */
 void QDirListingPrivate::beginIterating()
 {
+#if QT_CONFIG(thread) && !defined(QT_NO_FILESYSTEMITERATOR)
+    stopParallelIterating();
+#endif
 #ifndef QT_NO_FILESYSTEMITERATOR
     nativeIterators.clear();
 #endif
     fileEngineIterators.clear();
     visitedLinks.clear();
+#if QT_CONFIG(thread) && !defined(QT_NO_FILESYSTEMITERATOR)
+    if (canIterateInParallel()) {
+        beginParallelIterating();
+        return;
+    }
+#endif
     pushDirectory(initialEntryInfo);
 }
 
@@ -322,6 +394,13 @@ bool QDirListingPrivate::entryMatches(QDirEntryInfo &entryInfo)
 */
 void QDirListingPrivate::advance()
 {
+#if QT_CONFIG(thread) && !defined(QT_NO_FILESYSTEMITERATOR)
+    if (parallel) {
+        advanceParallel();
+        return;
+    }
+#endif
+
     // Use get() in both code paths below because the iterator returned by back()
     // may be invalidated due to reallocation when appending new iterators in
     // pushDirectory().
@@ -367,20 +446,20 @@ static bool isDotOrDotDot(QStringView fileName)
     return fileName == "."_L1 || fileName == ".."_L1;
 }
 
-void QDirListingPrivate::checkAndPushDirectory(QDirEntryInfo &entryInfo)
+bool QDirListingPrivate::shouldRecurseInto(QDirEntryInfo &entryInfo) const
 {
     using F = QDirListing::IteratorFlag;
     // If we're doing flat iteration, we're done.
     if (!iteratorFlags.testAnyFlags(F::Recursive))
-        return;
+        return false;
 
     // Follow symlinks only when asked
     if (!iteratorFlags.testAnyFlags(F::FollowDirSymlinks) && entryInfo.isSymLink())
-        return;
+        return false;
 
     // Never follow . and ..
     if (isDotOrDotDot(entryInfo.fileName()))
-        return;
+        return false;
 
     // No hidden directories unless requested
     const bool includeHidden = [this]() {
@@ -389,13 +468,16 @@ void QDirListingPrivate::checkAndPushDirectory(QDirEntryInfo &entryInfo)
         return iteratorFlags.testAnyFlags(QDirListing::IteratorFlag::IncludeHidden);
     }();
     if (!includeHidden && entryInfo.isHidden())
-        return;
+        return false;
 
     // Never follow non-directory entries
-    if (!entryInfo.isDir())
-        return;
+    return entryInfo.isDir();
+}
 
-    pushDirectory(entryInfo);
+void QDirListingPrivate::checkAndPushDirectory(QDirEntryInfo &entryInfo)
+{
+    if (shouldRecurseInto(entryInfo))
+        pushDirectory(entryInfo);
 }
 
 /*!
@@ -534,6 +616,11 @@ bool QDirListingPrivate::matchesFilters(QDirEntryInfo &entryInfo) const
 
 bool QDirListingPrivate::hasIterators() const
 {
+#if QT_CONFIG(thread) && !defined(QT_NO_FILESYSTEMITERATOR)
+    if (parallel)
+        return parallel->hasCurrent;
+#endif
+
     if (engine)
         return !fileEngineIterators.empty();
 
@@ -544,6 +631,224 @@ bool QDirListingPrivate::hasIterators() const
     return false;
 }
 
+#if QT_CONFIG(thread) && !defined(QT_NO_FILESYSTEMITERATOR)
+bool QDirListingPrivate::canIterateInParallel() const
+{
+    using F = QDirListing::IteratorFlag;
+    return !engine && !useLegacyFilters && iteratorFlags.testAnyFlags(F::Parallel)
+            && iteratorFlags.testAnyFlags(F::Recursive);
+}
+
+/*!
+    \internal
+
+    Sets up the shared state for IteratorFlag::Parallel and queues the
+    initial directory; helper tasks on the global QThreadPool are started
+    as soon as there are directories waiting to be scanned.
+*/
+void QDirListingPrivate::beginParallelIterating()
+{
+    parallel = std::make_unique<ParallelState>();
+    QString canonicalPath;
+    if (iteratorFlags.testAnyFlags(QDirListing::IteratorFlag::FollowDirSymlinks))
+        canonicalPath = initialEntryInfo.canonicalFilePath();
+
+    QMutexLocker locker(&parallel->mutex);
+    enqueueDirectory(QFileSystemEntry(initialEntryInfo.entry), canonicalPath);
+}
+
+/*!
+    \internal
+
+    Cancels a parallel iteration (if any) and waits for the helper tasks
+    to finish, as they access this object.
+*/
+void QDirListingPrivate::stopParallelIterating()
+{
+    if (!parallel)
+        return;
+
+    {
+        QMutexLocker locker(&parallel->mutex);
+        parallel->canceled = true;
+        parallel->pendingDirs.clear();
+        // wake up the helpers waiting for the results to be consumed
+        parallel->cond.wakeAll();
+        while (parallel->helpers > 0)
+            parallel->cond.wait(&parallel->mutex);
+    }
+    parallel.reset();
+}
+
+/*!
+    \internal
+
+    Must be called with parallel->mutex locked. Queues \a dirEntry for
+    scanning, unless \a canonicalPath has been visited already, and
+    starts another helper task if the thread pool has room for it. If no
+    helper can be started, the iterating thread scans the directory itself
+    in advanceParallel(), so progress is guaranteed even if the pool is
+    saturated (e.g. when iterating from inside a pool thread).
+*/
+void QDirListingPrivate::enqueueDirectory(QFileSystemEntry &&dirEntry,
+                                          const QString &canonicalPath)
+{
+    ParallelState &p = *parallel;
+    if (iteratorFlags.testAnyFlags(QDirListing::IteratorFlag::FollowDirSymlinks)) {
+        // Stop link loops
+        if (visitedLinks.hasSeen(canonicalPath))
+            return;
+    }
+
+    p.pendingDirs.push_back(std::move(dirEntry));
+
+    // The iterating thread does its share of the work too
+    QThreadPool *pool = QThreadPool::globalInstance();
+    if (p.helpers < pool->maxThreadCount() - 1
+        && pool->tryStart([this] { runParallelHelper(); })) {
+        ++p.helpers;
+    }
+}
+
+/*!
+    \internal
+
+    Reads the directory \a it iterates over (without holding the lock),
+    applying the filters and queuing sub-directories for recursion.
+    Matching entries are handed over to the iterating thread in batches, so
+    that it can start consuming them before large directories have been
+    read entirely.
+
+    A helper task waits while too many entries are pending. The iterating
+    thread cannot wait for itself: if \a isIteratingThread is true, this
+    function returns after handing over the first batch instead, and is
+    called again with the same \a it once that batch has been consumed.
+
+    Returns true once the directory has been read entirely, or iterating
+    has been canceled.
+*/
+bool QDirListingPrivate::scanDirectory(QFileSystemIterator &it, bool isIteratingThread)
+{
+    constexpr size_t BatchSize = 256;
+    const bool followDirSymlinks =
+            iteratorFlags.testAnyFlags(QDirListing::IteratorFlag::FollowDirSymlinks);
+    // only the filters that canIterateInParallel() accepts
+    Q_ASSERT(!useLegacyFilters);
+
+    std::vector<QDirEntryInfo> batch;
+    // Only the entry and canonical path of sub-directories are handed over,
+    // a QFileInfo must not be shared with the consumer of the results
+    std::vector<std::pair<QFileSystemEntry, QString>> subDirs;
+    auto flush = [&](bool done) {
+        ParallelState &p = *parallel;
+        QMutexLocker locker(&p.mutex);
+        if (!isIteratingThread) {
+            while (!p.canceled && p.results.size() >= ParallelState::MaxPendingResults)
+                p.cond.wait(&p.mutex);
+        }
+        if (!p.canceled) {
+            for (auto &[subDirEntry, canonicalPath] : subDirs)
+                enqueueDirectory(std::move(subDirEntry), canonicalPath);
+            std::move(batch.begin(), batch.end(), std::back_inserter(p.results));
+        }
+        batch.clear();
+        subDirs.clear();
+        if (done)
+            --p.activeScanners;
+        p.cond.wakeAll();
+        return !p.canceled;
+    };
+
+    QDirEntryInfo entryInfo;
+    while (it.advance(entryInfo.entry, entryInfo.metaData)) {
+        if (shouldRecurseInto(entryInfo)) {
+            // Resolved here, rather than in enqueueDirectory(), so as not to
+            // hold the lock during the system calls
+            subDirs.emplace_back(entryInfo.entry, followDirSymlinks
+                                                  ? entryInfo.canonicalFilePath() : QString());
+        }
+        if (matchesFilters(entryInfo))
+            batch.push_back(std::move(entryInfo));
+        entryInfo = {};
+
+        if (batch.size() >= BatchSize) {
+            if (!flush(false)) {
+                flush(true);
+                return true;
+            }
+            if (isIteratingThread)
+                return false;
+        }
+    }
+    flush(true);
+    return true;
+}
+
+void QDirListingPrivate::runParallelHelper()
+{
+    ParallelState &p = *parallel;
+    QMutexLocker locker(&p.mutex);
+    while (!p.canceled && !p.pendingDirs.empty()) {
+        const QFileSystemEntry dirEntry = std::move(p.pendingDirs.front());
+        p.pendingDirs.pop_front();
+        ++p.activeScanners;
+        locker.unlock();
+        QFileSystemIterator it(dirEntry, iteratorFlags);
+        scanDirectory(it, false);
+        locker.relock();
+    }
+    --p.helpers;
+    p.cond.wakeAll();
+}
+
+/*!
+    \internal
+
+    The IteratorFlag::Parallel counterpart of advance(): takes the next
+    entry scanned by any thread. If none is available yet, the iterating
+    thread scans a pending directory itself instead of waiting idly, one
+    batch at a time; it only blocks while other threads are still scanning.
+*/
+void QDirListingPrivate::advanceParallel()
+{
+    ParallelState &p = *parallel;
+    QMutexLocker locker(&p.mutex);
+    for (;;) {
+        if (!p.results.empty()) {
+            currentEntryInfo = std::move(p.results.front());
+            p.results.pop_front();
+            p.hasCurrent = true;
+            if (p.results.size() == ParallelState::MaxPendingResults / 2)
+                p.cond.wakeAll();
+            return;
+        }
+
+        if (!p.ownScan && !p.pendingDirs.empty()) {
+            p.ownScan.emplace(p.pendingDirs.front(), iteratorFlags);
+            p.pendingDirs.pop_front();
+            ++p.activeScanners;
+        }
+        if (p.ownScan) {
+            locker.unlock();
+            const bool done = scanDirectory(*p.ownScan, true);
+            locker.relock();
+            if (done)
+                p.ownScan.reset();
+            continue;
+        }
+
+        if (p.activeScanners == 0) {
+            // All done
+            p.hasCurrent = false;
+            currentEntryInfo = {};
+            return;
+        }
+
+        p.cond.wait(&p.mutex);
+    }
+}
+#endif // QT_CONFIG(thread) && !QT_NO_FILESYSTEMITERATOR
+
 /*!
     Constructs a QDirListing that can iterate over \a path.
 
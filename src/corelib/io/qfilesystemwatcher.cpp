@@ -6,9 +6,11 @@
 
 #include <qdatetime.h>
 #include <qdir.h>
+#include <qdirlisting.h>
 #include <qfileinfo.h>
 #include <qloggingcategory.h>
 #include <qset.h>
+#include <qtimer.h>
 
 #if (defined(Q_OS_LINUX) || defined(Q_OS_QNX)) && QT_CONFIG(inotify)
 #define USE_INOTIFY
@@ -63,6 +65,8 @@ void QFileSystemWatcherPrivate::connectEngine(QFileSystemWatcherEngine *engine)
                             this, &QFileSystemWatcherPrivate::fileChanged);
     QObjectPrivate::connect(engine, &QFileSystemWatcherEngine::directoryChanged,
                             this, &QFileSystemWatcherPrivate::directoryChanged);
+    QObjectPrivate::connect(engine, &QFileSystemWatcherEngine::eventQueueOverflowed,
+                            this, &QFileSystemWatcherPrivate::eventQueueOverflowed);
 }
 
 void QFileSystemWatcherPrivate::init()
@@ -104,6 +108,10 @@ void QFileSystemWatcherPrivate::fileChanged(const QString &path, bool removed)
     }
     if (removed)
         files.removeAll(path);
+    if (coalescingTimer) {
+        queueChange(path, false);
+        return;
+    }
     emit q->fileChanged(path, QFileSystemWatcher::QPrivateSignal());
 }
 
@@ -117,9 +125,112 @@ void QFileSystemWatcherPrivate::directoryChanged(const QString &path, bool remov
     }
     if (removed)
         directories.removeAll(path);
+    if (coalescingTimer) {
+        // new sub-directories are looked for once the interval elapsed
+        queueChange(path, true);
+        return;
+    }
+    if (!removed && isInRecursiveTree(path))
+        watchNewSubdirectories(path);
     emit q->directoryChanged(path, QFileSystemWatcher::QPrivateSignal());
 }
 
+void QFileSystemWatcherPrivate::eventQueueOverflowed()
+{
+    Q_Q(QFileSystemWatcher);
+    qCDebug(lcWatcher) << "event queue overflowed";
+    emit q->eventQueueOverflowed(QFileSystemWatcher::QPrivateSignal());
+}
+
+bool QFileSystemWatcherPrivate::isInRecursiveTree(const QString &path) const
+{
+    return std::any_of(recursiveRoots.cbegin(), recursiveRoots.cend(), [&path](const QString &root) {
+        return path.startsWith(root)
+                && (path.size() == root.size() || root.endsWith(u'/')
+                    || path.at(root.size()) == u'/');
+    });
+}
+
+/*!
+    \internal
+
+    Called when \a path, a directory inside a tree added with
+    addPathsRecursively(), changed: starts watching its sub-directories
+    that aren't watched yet, and, as they may have been moved in along
+    with their contents, everything below them.
+*/
+void QFileSystemWatcherPrivate::watchNewSubdirectories(const QString &path)
+{
+    Q_Q(QFileSystemWatcher);
+    using F = QDirListing::IteratorFlag;
+    QStringList subDirectories;
+    for (const auto &dirEntry : QDirListing(path, F::DirsOnly | F::IncludeHidden))
+        subDirectories.append(dirEntry.filePath());
+    if (subDirectories.isEmpty())
+        return;
+
+    // Already watched directories are returned as unhandled
+    const QStringList unhandled = q->addPaths(subDirectories);
+    if (unhandled.size() == subDirectories.size())
+        return;
+    const QSet<QString> skip(unhandled.cbegin(), unhandled.cend());
+
+    QStringList descendants;
+    for (const QString &subDirectory : std::as_const(subDirectories)) {
+        if (skip.contains(subDirectory))
+            continue;
+        for (const auto &dirEntry : QDirListing(subDirectory, F::DirsOnly | F::IncludeHidden
+                                                              | F::Recursive)) {
+            descendants.append(dirEntry.filePath());
+        }
+    }
+    if (!descendants.isEmpty())
+        q->addPaths(descendants);
+}
+
+void QFileSystemWatcherPrivate::queueChange(const QString &path, bool isDirectory)
+{
+    if (!pendingPaths.contains(path)) {
+        pendingPaths.insert(path);
+        pendingChanges.append({path, isDirectory});
+    }
+    if (!coalescingTimer->isActive())
+        coalescingTimer->start();
+}
+
+void QFileSystemWatcherPrivate::removePendingChanges(const QStringList &paths)
+{
+    if (pendingPaths.isEmpty())
+        return;
+    bool found = false;
+    for (const QString &path : paths)
+        found |= pendingPaths.remove(path);
+    if (found) {
+        pendingChanges.removeIf([this](const PendingChange &change) {
+            return !pendingPaths.contains(change.path);
+        });
+    }
+}
+
+void QFileSystemWatcherPrivate::emitPendingChanges()
+{
+    Q_Q(QFileSystemWatcher);
+    // Slots may remove paths, and thereby their pending changes, so don't
+    // iterate over a copy
+    while (!pendingChanges.isEmpty()) {
+        const PendingChange change = pendingChanges.takeFirst();
+        pendingPaths.remove(change.path);
+        if (change.isDirectory) {
+            // Scan once for all the changes coalesced, rather than per event
+            if (directories.contains(change.path) && isInRecursiveTree(change.path))
+                watchNewSubdirectories(change.path);
+            emit q->directoryChanged(change.path, QFileSystemWatcher::QPrivateSignal());
+        } else {
+            emit q->fileChanged(change.path, QFileSystemWatcher::QPrivateSignal());
+        }
+    }
+}
+
 #if defined(Q_OS_WIN)
 
 void QFileSystemWatcherPrivate::winDriveLockForRemoval(const QString &path)
@@ -395,6 +506,23 @@ QStringList QFileSystemWatcher::removePaths(const QStringList &paths)
     }
     qCDebug(lcWatcher) << "removing" << paths;
 
+    if (!d->recursiveRoots.isEmpty()) {
+        // Removing the top-level directory of a recursively watched tree
+        // stops watching the whole tree
+        const qsizetype count = p.size();
+        for (qsizetype i = 0; i < count; ++i) {
+            const QString path = p.at(i);
+            if (!d->recursiveRoots.removeOne(path))
+                continue;
+            const QString prefix = path.endsWith(u'/') ? path : path + u'/';
+            for (const QString &directory : std::as_const(d->directories)) {
+                if (directory.startsWith(prefix) && !d->isInRecursiveTree(directory))
+                    p.append(directory);
+            }
+        }
+    }
+    d->removePendingChanges(p);
+
     if (d->native)
         p = d->native->removePaths(p, &d->files, &d->directories);
     if (d->poller)
@@ -403,6 +531,139 @@ QStringList QFileSystemWatcher::removePaths(const QStringList &paths)
     return p;
 }
 
+/*!
+    \since 6.9
+
+    Adds each directory in \a directories to the file system watcher,
+    together with all of its sub-directories, including hidden ones.
+    Symbolic links to directories are not followed. Paths that are not
+    directories are added as if by addPaths().
+
+    The paths are cleaned with QDir::cleanPath() first, and the
+    sub-directories are reported by directories() and in the
+    directoryChanged() signal with the cleaned path as prefix.
+
+    Sub-directories created (or moved) below a recursively watched
+    directory later on are watched automatically, when the change to their
+    parent directory is reported. Removing a directory passed to this
+    function with removePath() or removePaths() stops watching the whole
+    tree.
+
+    All paths are registered in one batch; this is considerably faster
+    than adding them one by one, in particular with the inotify backend
+    on Linux.
+
+    The return value is a list of paths that could not be watched.
+
+    \note The system dependent limit to the number of paths that can be
+    monitored simultaneously applies to each sub-directory. On Linux,
+    see \c{/proc/sys/fs/inotify/max_user_watches}.
+
+    \sa addPaths(), directories(), eventQueueOverflowed()
+*/
+QStringList QFileSystemWatcher::addPathsRecursively(const QStringList &directories)
+{
+    Q_D(QFileSystemWatcher);
+
+    const QStringList p = empty_paths_pruned(directories);
+    if (p.isEmpty()) {
+        qWarning("QFileSystemWatcher::addPathsRecursively: list is empty");
+        return p;
+    }
+
+    using F = QDirListing::IteratorFlag;
+    QStringList paths;
+    QStringList roots;
+    for (const QString &path : p) {
+        const QString cleanPath = QDir::cleanPath(path);
+        paths.append(cleanPath);
+        if (!QFileInfo(cleanPath).isDir())
+            continue;
+        roots.append(cleanPath);
+        for (const auto &dirEntry : QDirListing(cleanPath, F::DirsOnly | F::IncludeHidden
+                                                           | F::Recursive)) {
+            paths.append(dirEntry.filePath());
+        }
+    }
+
+    const QStringList unhandled = addPaths(paths);
+    for (const QString &root : std::as_const(roots)) {
+        if (d->directories.contains(root) && !d->recursiveRoots.contains(root))
+            d->recursiveRoots.append(root);
+    }
+    return unhandled;
+}
+
+/*!
+    \since 6.9
+
+    Sets the interval over which changes are coalesced to \a interval.
+
+    If \a interval is greater than zero, a change does not cause the
+    fileChanged() or directoryChanged() signal to be emitted immediately.
+    Instead, the signals are emitted when the interval has elapsed after
+    the first change, once for each path that changed during that time,
+    no matter how often it changed. This reduces the number of signal
+    emissions, for example, when a build or a checkout modifies a tree
+    of watched directories.
+
+    If \a interval is zero (the default), the signals are emitted as soon
+    as a change is reported by the system, and any changes that are
+    still pending are emitted now.
+
+    \sa coalescingInterval()
+*/
+void QFileSystemWatcher::setCoalescingInterval(std::chrono::milliseconds interval)
+{
+    Q_D(QFileSystemWatcher);
+    if (interval < std::chrono::milliseconds::zero())
+        interval = std::chrono::milliseconds::zero();
+    d->coalescingInterval = interval;
+
+    if (interval > std::chrono::milliseconds::zero()) {
+        if (!d->coalescingTimer) {
+            d->coalescingTimer = new QTimer(this);
+            d->coalescingTimer->setSingleShot(true);
+            QObjectPrivate::connect(d->coalescingTimer, &QTimer::timeout,
+                                    d, &QFileSystemWatcherPrivate::emitPendingChanges);
+        }
+        d->coalescingTimer->setInterval(interval);
+    } else if (d->coalescingTimer) {
+        delete std::exchange(d->coalescingTimer, nullptr);
+        d->emitPendingChanges();
+    }
+}
+
+/*!
+    \since 6.9
+
+    Returns the interval over which changes are coalesced. The default
+    is zero, that is, changes are not coalesced.
+
+    \sa setCoalescingInterval()
+*/
+std::chrono::milliseconds QFileSystemWatcher::coalescingInterval() const
+{
+    Q_D(const QFileSystemWatcher);
+    return d->coalescingInterval;
+}
+
+/*!
+    \fn void QFileSystemWatcher::eventQueueOverflowed()
+    \since 6.9
+
+    This signal is emitted when the system reported that its queue of
+    change notifications overflowed, so changes to any of the watched
+    paths may have been missed, without fileChanged() or directoryChanged()
+    being emitted for them.
+
+    Applications that need to know about every change should rescan the
+    watched files and directories when receiving this signal.
+
+    Currently, only the inotify backend on Linux reports this condition
+    (see \c{/proc/sys/fs/inotify/max_queued_events}).
+*/
+
 /*!
     \fn void QFileSystemWatcher::fileChanged(const QString &path)
 
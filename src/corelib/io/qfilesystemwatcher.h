@@ -27,13 +27,18 @@ public:
     QStringList addPaths(const QStringList &files);
     bool removePath(const QString &file);
     QStringList removePaths(const QStringList &files);
+    QStringList addPathsRecursively(const QStringList &directories);
 
     QStringList files() const;
     QStringList directories() const;
 
+    void setCoalescingInterval(std::chrono::milliseconds interval);
+    std::chrono::milliseconds coalescingInterval() const;
+
 Q_SIGNALS:
     void fileChanged(const QString &path, QPrivateSignal);
     void directoryChanged(const QString &path, QPrivateSignal);
+    void eventQueueOverflowed(QPrivateSignal);
 };
 
 QT_END_NAMESPACE
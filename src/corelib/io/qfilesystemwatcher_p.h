@@ -23,9 +23,14 @@ QT_REQUIRE_CONFIG(filesystemwatcher);
 
 #include <QtCore/qstringlist.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qset.h>
+
+#include <chrono>
 
 QT_BEGIN_NAMESPACE
 
+class QTimer;
+
 class QFileSystemWatcherEngine : public QObject
 {
     Q_OBJECT
@@ -52,6 +57,8 @@ public:
 Q_SIGNALS:
     void fileChanged(const QString &path, bool removed);
     void directoryChanged(const QString &path, bool removed);
+    // emitted when the engine knows that change notifications were lost
+    void eventQueueOverflowed();
 };
 
 class QFileSystemWatcherPrivate : public QObjectPrivate
@@ -68,9 +75,29 @@ public:
     QFileSystemWatcherEngine *native, *poller;
     QStringList files, directories;
 
+    // directories added with addPathsRecursively()
+    QStringList recursiveRoots;
+    bool isInRecursiveTree(const QString &path) const;
+    void watchNewSubdirectories(const QString &path);
+
+    // changes waiting for the coalescing interval to elapse
+    struct PendingChange
+    {
+        QString path;
+        bool isDirectory;
+    };
+    std::chrono::milliseconds coalescingInterval{0};
+    QTimer *coalescingTimer = nullptr;
+    QList<PendingChange> pendingChanges;
+    QSet<QString> pendingPaths;
+    void queueChange(const QString &path, bool isDirectory);
+    void removePendingChanges(const QStringList &paths);
+    void emitPendingChanges();
+
     // private slots
     void fileChanged(const QString &path, bool removed);
     void directoryChanged(const QString &path, bool removed);
+    void eventQueueOverflowed();
 
     void connectEngine(QFileSystemWatcherEngine *e);
 
@@ -75,7 +75,7 @@ int QLoggingRule::pass(QLatin1StringView cat, QtMsgType msgType) const
                 return (enabled ? 1 : -1);
         } else if (flags == RightFilter) {
             // matches right
-            if (idx == (cat.size() - category.size()))
+            if (cat.endsWith(category))
                 return (enabled ? 1 : -1);
         }
     }
@@ -131,6 +131,155 @@ void QLoggingRule::parse(QStringView pattern)
     category = p.toString();
 }
 
+/*!
+    \class QLoggingRuleMatcher
+    \internal
+
+    Evaluates all logging rules for a category name at once. The rules are
+    compiled into a character trie of the patterns matching at the start
+    of a category name and one of the reversed patterns matching at its
+    end, so that matching a category walks its name once per trie instead
+    of testing every rule. Patterns matching in the middle of a name
+    (\c{*.core.*}) are rare, and are tested one by one.
+
+    Of all rules that match a message type, the last one wins.
+*/
+
+/*!
+    \internal
+    Compiles \a ruleSets, given in increasing order of priority.
+*/
+QLoggingRuleMatcher::QLoggingRuleMatcher(QSpan<const QList<QLoggingRule>> ruleSets)
+{
+    int priority = 0;
+    for (const QList<QLoggingRule> &ruleSet : ruleSets) {
+        for (const QLoggingRule &rule : ruleSet) {
+            switch (rule.flags.toInt()) {
+            case QLoggingRule::FullText:
+                addRule(verdicts[verdictsFor(prefixTrie, rule.category, false, true)],
+                        priority, rule);
+                break;
+            case QLoggingRule::LeftFilter:
+                addRule(verdicts[verdictsFor(prefixTrie, rule.category, false, false)],
+                        priority, rule);
+                break;
+            case QLoggingRule::RightFilter:
+                addRule(verdicts[verdictsFor(suffixTrie, rule.category, true, false)],
+                        priority, rule);
+                break;
+            case QLoggingRule::MidFilter:
+                midRules.push_back({ rule.category, {} });
+                addRule(midRules.back().verdicts, priority, rule);
+                break;
+            default:    // malformed, never matches
+                break;
+            }
+            ++priority;
+        }
+    }
+}
+
+static QLoggingRuleMatcher::Level levelForMessageType(int messageType)
+{
+    switch (messageType) {
+    case QtDebugMsg:
+        return QLoggingRuleMatcher::Debug;
+    case QtInfoMsg:
+        return QLoggingRuleMatcher::Info;
+    case QtWarningMsg:
+        return QLoggingRuleMatcher::Warning;
+    case QtCriticalMsg:
+        return QLoggingRuleMatcher::Critical;
+    }
+    return QLoggingRuleMatcher::NumLevels;
+}
+
+void QLoggingRuleMatcher::addRule(Verdicts &verdicts, int priority, const QLoggingRule &rule)
+{
+    const Verdict verdict{ priority, rule.enabled };
+    if (rule.messageType < 0)
+        verdicts.fill(verdict);
+    else if (Level level = levelForMessageType(rule.messageType); level != NumLevels)
+        verdicts[level] = verdict;
+}
+
+void QLoggingRuleMatcher::merge(Verdicts &result, const Verdicts &other)
+{
+    for (int i = 0; i < NumLevels; ++i) {
+        if (other[i].priority > result[i].priority)
+            result[i] = other[i];
+    }
+}
+
+/*!
+    \internal
+    Returns the index of the verdicts of the node for \a path in \a trie,
+    creating the node and the verdicts if needed.
+*/
+int &QLoggingRuleMatcher::verdictsFor(std::vector<Node> &trie, QStringView path, bool reversed,
+                                      bool exact)
+{
+    int node = 0;
+    for (qsizetype i = 0; i < path.size(); ++i) {
+        const char16_t ch = path[reversed ? path.size() - 1 - i : i].unicode();
+        int child = trie[node].firstChild;
+        while (child >= 0 && trie[child].ch != ch)
+            child = trie[child].nextSibling;
+        if (child < 0) {
+            child = int(trie.size());
+            Node added;
+            added.nextSibling = trie[node].firstChild;
+            added.ch = ch;
+            trie.push_back(added);
+            trie[node].firstChild = child;
+        }
+        node = child;
+    }
+    int &index = exact ? trie[node].exactVerdicts : trie[node].prefixVerdicts;
+    if (index < 0) {
+        index = int(verdicts.size());
+        verdicts.emplace_back();
+    }
+    return index;
+}
+
+void QLoggingRuleMatcher::walk(const std::vector<Node> &trie, QLatin1StringView name,
+                               bool reversed, Verdicts &result) const
+{
+    int node = 0;
+    for (qsizetype i = 0; ; ++i) {
+        if (trie[node].prefixVerdicts >= 0)
+            merge(result, verdicts[trie[node].prefixVerdicts]);
+        if (i == name.size()) {
+            if (trie[node].exactVerdicts >= 0)
+                merge(result, verdicts[trie[node].exactVerdicts]);
+            return;
+        }
+        const char16_t ch = name[reversed ? name.size() - 1 - i : i].unicode();
+        node = trie[node].firstChild;
+        while (node >= 0 && trie[node].ch != ch)
+            node = trie[node].nextSibling;
+        if (node < 0)
+            return;
+    }
+}
+
+/*!
+    \internal
+    Returns, for each message type, the last rule matching \a categoryName.
+*/
+QLoggingRuleMatcher::Verdicts QLoggingRuleMatcher::match(QLatin1StringView categoryName) const
+{
+    Verdicts result;
+    walk(prefixTrie, categoryName, false, result);
+    walk(suffixTrie, categoryName, true, result);
+    for (const MidRule &rule : midRules) {
+        if (categoryName.contains(rule.category))
+            merge(result, rule.verdicts);
+    }
+    return result;
+}
+
 /*!
     \class QLoggingSettingsParser
     \since 5.3
@@ -335,14 +484,28 @@ void QLoggingRegistry::initializeRules()
 */
 void QLoggingRegistry::registerCategory(QLoggingCategory *cat, QtMsgType enableForLevel)
 {
-    const auto locker = qt_scoped_lock(registryMutex);
+    CategoryShard &shard = shardFor(cat);
+    std::unique_lock<QMutex> filterLocker;
+    while (true) {
+        auto locker = qt_unique_lock(shard.mutex);
+        // installFilter() sets the filter before it locks the shards, so
+        // if we see the old one, it will pass the category to the new one
+        const auto filter = categoryFilter.load(std::memory_order_relaxed);
+        if (filter != defaultCategoryFilter && !filterLocker.owns_lock()) {
+            // custom filters must not run concurrently
+            locker.unlock();
+            filterLocker = qt_unique_lock(registryMutex);
+            continue;
+        }
 
-    const auto oldSize = categories.size();
-    auto &e = categories[cat];
-    if (categories.size() != oldSize) {
-        // new entry
-        e = enableForLevel;
-        (*categoryFilter)(cat);
+        const auto oldSize = shard.categories.size();
+        auto &e = shard.categories[cat];
+        if (shard.categories.size() != oldSize) {
+            // new entry
+            e = enableForLevel;
+            (*filter)(cat);
+        }
+        return;
     }
 }
 
@@ -352,8 +515,14 @@ void QLoggingRegistry::registerCategory(QLoggingCategory *cat, QtMsgType enableF
 */
 void QLoggingRegistry::unregisterCategory(QLoggingCategory *cat)
 {
-    const auto locker = qt_scoped_lock(registryMutex);
-    categories.remove(cat);
+    CategoryShard &shard = shardFor(cat);
+    const auto locker = qt_scoped_lock(shard.mutex);
+    shard.categories.remove(cat);
+}
+
+QLoggingRegistry::CategoryShard &QLoggingRegistry::shardFor(const QLoggingCategory *cat)
+{
+    return categoryShards[qHash(cat) % NumCategoryShards];
 }
 
 /*!
@@ -392,14 +561,25 @@ void QLoggingRegistry::setApiRules(const QString &content)
 
 /*!
     \internal
-    Activates a new set of logging rules for the default filter.
+    Activates a new set of logging rules for the default filter, and passes
+    all categories to the filter.
 
     (The caller must lock registryMutex to make sure the API is thread safe.)
 */
 void QLoggingRegistry::updateRules()
 {
-    for (auto it = categories.keyBegin(), end = categories.keyEnd(); it != end; ++it)
-        (*categoryFilter)(*it);
+    auto matcher = std::make_unique<const QLoggingRuleMatcher>(ruleSets);
+    currentRuleMatcher.store(matcher.get(), std::memory_order_release);
+    const QLoggingCategory::CategoryFilter filter = categoryFilter.load(std::memory_order_relaxed);
+    for (CategoryShard &shard : categoryShards) {
+        const auto locker = qt_scoped_lock(shard.mutex);
+        const auto end = shard.categories.keyEnd();
+        for (auto it = shard.categories.keyBegin(); it != end; ++it)
+            (*filter)(*it);
+    }
+    // Filters only run with a shard locked, so none can still use the old
+    // matcher now
+    ruleMatcher = std::move(matcher);
 }
 
 /*!
@@ -414,8 +594,8 @@ QLoggingRegistry::installFilter(QLoggingCategory::CategoryFilter filter)
     if (!filter)
         filter = defaultCategoryFilter;
 
-    QLoggingCategory::CategoryFilter old = categoryFilter;
-    categoryFilter = filter;
+    QLoggingCategory::CategoryFilter old =
+            categoryFilter.exchange(filter, std::memory_order_relaxed);
 
     updateRules();
 
@@ -431,13 +611,15 @@ QLoggingRegistry *QLoggingRegistry::instance()
     \internal
     Updates category settings according to rules.
 
-    As a category filter, it is run with registryMutex held.
+    As a category filter, it is run with the mutex of the shard of \a cat
+    held, but not necessarily registryMutex.
 */
 void QLoggingRegistry::defaultCategoryFilter(QLoggingCategory *cat)
 {
-    const QLoggingRegistry *reg = QLoggingRegistry::instance();
-    Q_ASSERT(reg->categories.contains(cat));
-    QtMsgType enableForLevel = reg->categories.value(cat);
+    QLoggingRegistry *reg = QLoggingRegistry::instance();
+    const CategoryShard &shard = reg->shardFor(cat);
+    Q_ASSERT(shard.categories.contains(cat));
+    QtMsgType enableForLevel = shard.categories.value(cat);
 
     // NB: note that the numeric values of the Qt*Msg constants are
     //     not in severity order.
@@ -463,23 +645,17 @@ void QLoggingRegistry::defaultCategoryFilter(QLoggingCategory *cat)
         }
     }
 
-    const auto categoryName = QLatin1StringView(cat->categoryName());
-
-    for (const auto &ruleSet : reg->ruleSets) {
-        for (const auto &rule : ruleSet) {
-            int filterpass = rule.pass(categoryName, QtDebugMsg);
-            if (filterpass != 0)
-                debug = (filterpass > 0);
-            filterpass = rule.pass(categoryName, QtInfoMsg);
-            if (filterpass != 0)
-                info = (filterpass > 0);
-            filterpass = rule.pass(categoryName, QtWarningMsg);
-            if (filterpass != 0)
-                warning = (filterpass > 0);
-            filterpass = rule.pass(categoryName, QtCriticalMsg);
-            if (filterpass != 0)
-                critical = (filterpass > 0);
-        }
+    const auto *matcher = reg->currentRuleMatcher.load(std::memory_order_acquire);
+    if (matcher) {
+        const auto verdicts = matcher->match(QLatin1StringView(cat->categoryName()));
+        const auto apply = [&verdicts](QLoggingRuleMatcher::Level level, bool &enabled) {
+            if (verdicts[level].priority >= 0)
+                enabled = verdicts[level].enabled;
+        };
+        apply(QLoggingRuleMatcher::Debug, debug);
+        apply(QLoggingRuleMatcher::Info, info);
+        apply(QLoggingRuleMatcher::Warning, warning);
+        apply(QLoggingRuleMatcher::Critical, critical);
     }
 
     cat->setEnabled(QtDebugMsg, debug);
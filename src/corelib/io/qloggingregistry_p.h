@@ -20,10 +20,15 @@
 #include <QtCore/qlist.h>
 #include <QtCore/qhash.h>
 #include <QtCore/qmutex.h>
+#include <QtCore/qspan.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qtextstream.h>
 
+#include <array>
+#include <atomic>
 #include <map>
+#include <memory>
+#include <vector>
 
 class tst_QLoggingRegistry;
 
@@ -88,6 +93,50 @@ private:
 Q_DECLARE_OPERATORS_FOR_FLAGS(QLoggingRule::PatternFlags)
 Q_DECLARE_TYPEINFO(QLoggingRule, Q_RELOCATABLE_TYPE);
 
+class Q_AUTOTEST_EXPORT QLoggingRuleMatcher
+{
+public:
+    QLoggingRuleMatcher() = default;
+    explicit QLoggingRuleMatcher(QSpan<const QList<QLoggingRule>> ruleSets);
+
+    // message types in the order of QLoggingRegistry::defaultCategoryFilter
+    enum Level { Debug, Info, Warning, Critical, NumLevels };
+    struct Verdict
+    {
+        int priority = -1;      // index of the rule, -1 if none matched
+        bool enabled = false;
+    };
+    using Verdicts = std::array<Verdict, NumLevels>;
+
+    Verdicts match(QLatin1StringView categoryName) const;
+
+private:
+    struct Node
+    {
+        int firstChild = -1;
+        int nextSibling = -1;
+        int prefixVerdicts = -1;    // index into verdicts, or -1
+        int exactVerdicts = -1;
+        char16_t ch = 0;
+    };
+    struct MidRule
+    {
+        QString category;
+        Verdicts verdicts;
+    };
+
+    static void addRule(Verdicts &verdicts, int priority, const QLoggingRule &rule);
+    static void merge(Verdicts &result, const Verdicts &other);
+    int &verdictsFor(std::vector<Node> &trie, QStringView path, bool reversed, bool exact);
+    void walk(const std::vector<Node> &trie, QLatin1StringView name, bool reversed,
+              Verdicts &result) const;
+
+    std::vector<Node> prefixTrie = std::vector<Node>(1);
+    std::vector<Node> suffixTrie = std::vector<Node>(1);    // of reversed patterns
+    std::vector<Verdicts> verdicts;
+    std::vector<MidRule> midRules;
+};
+
 class Q_AUTOTEST_EXPORT QLoggingSettingsParser
 {
 public:
@@ -134,6 +183,14 @@ private:
 
     static void defaultCategoryFilter(QLoggingCategory *category);
 
+    struct CategoryShard
+    {
+        QMutex mutex;
+        QHash<QLoggingCategory *, QtMsgType> categories;
+    };
+    static constexpr int NumCategoryShards = 16;
+    CategoryShard &shardFor(const QLoggingCategory *category);
+
     enum RuleSet {
         // sorted by order in which defaultCategoryFilter considers them:
         QtConfigRules,
@@ -144,14 +201,23 @@ private:
         NumRuleSets
     };
 
+    // Serializes changes of the rules and of the filter, and calls of
+    // custom filters. Registering a category with the default filter only
+    // locks the shard of the category.
     QMutex registryMutex;
 
-    // protected by mutex:
+    // protected by registryMutex:
     QList<QLoggingRule> ruleSets[NumRuleSets];
-    QHash<QLoggingCategory *, QtMsgType> categories;
-    QLoggingCategory::CategoryFilter categoryFilter;
+    std::unique_ptr<const QLoggingRuleMatcher> ruleMatcher;
     std::map<QByteArrayView, const char *> qtCategoryEnvironmentOverrides;
 
+    // written with registryMutex held, read with a shard mutex held;
+    // updateRules() locks every shard after changing them
+    std::atomic<QLoggingCategory::CategoryFilter> categoryFilter;
+    std::atomic<const QLoggingRuleMatcher *> currentRuleMatcher = nullptr;
+
+    CategoryShard categoryShards[NumCategoryShards];
+
     friend class ::tst_QLoggingRegistry;
 };
 
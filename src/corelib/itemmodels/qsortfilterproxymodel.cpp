@@ -9,6 +9,7 @@
 #include <qstringlist.h>
 #include <private/qabstractitemmodel_p.h>
 #include <private/qabstractproxymodel_p.h>
+#include <private/qcollator_p.h>
 #include <private/qproperty_p.h>
 
 #include <algorithm>
@@ -208,6 +209,12 @@ public:
             &QSortFilterProxyModelPrivate::setSortLocaleAwareForwarder,
             &QSortFilterProxyModelPrivate::sortLocaleAwareChangedForwarder, false)
 
+#if QT_CONFIG(icu)
+    // Sorting compares each string many times; with ICU, comparing through
+    // sort keys gives the same order as QString::localeAwareCompare()
+    mutable QCollatorSortKeyCache sortKeyCache;
+#endif
+
     Q_OBJECT_COMPAT_PROPERTY_WITH_ARGS(
             QSortFilterProxyModelPrivate, bool, filter_recursive,
             &QSortFilterProxyModelPrivate::setRecursiveFilteringEnabledForwarder,
@@ -2766,6 +2773,10 @@ void QSortFilterProxyModel::setSortLocaleAware(bool on)
         return;
 
     d->sort_localeaware.setValueBypassingBindings(on);
+#if QT_CONFIG(icu)
+    if (!on)
+        d->sortKeyCache.clear();
+#endif
     d->sort();
     d->sort_localeaware.notify(); // also emits a signal
 }
@@ -3205,6 +3216,12 @@ bool QSortFilterProxyModel::lessThan(const QModelIndex &source_left, const QMode
     Q_D(const QSortFilterProxyModel);
     const QVariant l = source_left.data(d->sort_role);
     const QVariant r = source_right.data(d->sort_role);
+#if QT_CONFIG(icu)
+    if (d->sort_localeaware && l.userType() == QMetaType::QString
+        && r.userType() == QMetaType::QString) {
+        return d->sortKeyCache.compare(l.toString(), r.toString()) < 0;
+    }
+#endif
     return QAbstractItemModelPrivate::isVariantLessThan(l, r, d->sort_casesensitivity, d->sort_localeaware);
 }
 
@@ -1686,6 +1686,65 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         dispatcher->wakeUp();
 }
 
+/*!
+    \internal
+
+    Posts \a events like postEvent() does, taking the lock of the event queue
+    of each receiving thread once. The events to receivers in the same thread
+    are posted in the order they have in \a events.
+*/
+void QCoreApplicationPrivate::postEvents(QSpan<QPostEvent> events)
+{
+    QVarLengthArray<bool, 32> posted(events.size(), false);
+    for (qsizetype first = 0; first < events.size(); ++first) {
+        if (posted[first])
+            continue;
+
+        auto locker = lockThreadPostEventList(events[first].receiver);
+        QThreadData *data = locker.threadData;
+        // While the queue of a thread is locked, its objects cannot be moved
+        // to another thread, nor other objects to it
+        for (qsizetype i = first; i < events.size(); ++i) {
+            const QPostEvent &postEvent = events[i];
+            if (posted[i]
+                || QObjectPrivate::get(postEvent.receiver)->threadData.loadAcquire() != data) {
+                continue;
+            }
+            posted[i] = true;
+
+            QObject *receiver = postEvent.receiver;
+            QEvent *event = postEvent.event;
+            Q_TRACE_SCOPE(QCoreApplication_postEvent, receiver, event, event->type());
+            if (!data) {
+                // posting during destruction? just delete the event to prevent a leak
+                delete event;
+                continue;
+            }
+            QCoreApplication *app = QCoreApplication::self;
+            if (QObjectPrivate::get(receiver)->postedEvents
+                && app && app->compressEvent(event, receiver, &data->postEventList)) {
+                Q_TRACE(QCoreApplication_postEvent_event_compressed, receiver, event);
+                continue;
+            }
+
+            std::unique_ptr<QEvent> eventDeleter(event);
+            Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type());
+            data->postEventList.addEvent(postEvent);
+            Q_UNUSED(eventDeleter.release());
+            event->m_posted = true;
+            ++QObjectPrivate::get(receiver)->postedEvents;
+        }
+        if (!data)
+            continue;
+        data->canWait = false;
+        locker.unlock();
+
+        QAbstractEventDispatcher* dispatcher = data->eventDispatcher.loadAcquire();
+        if (dispatcher)
+            dispatcher->wakeUp();
+    }
+}
+
 /*!
   \internal
   Returns \c true if \a event was compressed away (possibly deleted) and should not be added to the list.
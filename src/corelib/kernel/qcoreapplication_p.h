@@ -20,6 +20,7 @@
 #include "QtCore/qcommandlineoption.h"
 #endif
 #include "QtCore/qreadwritelock.h"
+#include "QtCore/qspan.h"
 #include "QtCore/qtranslator.h"
 #if QT_CONFIG(settings)
 #include "QtCore/qsettings.h"
@@ -38,6 +39,8 @@ QT_BEGIN_NAMESPACE
 
 #ifndef QT_NO_QOBJECT
 Q_DECLARE_LOGGING_CATEGORY(lcDeleteLater)
+
+class QPostEvent;
 #endif
 
 typedef QList<QTranslator*> QTranslatorList;
@@ -128,6 +131,7 @@ public:
         void unlock() { locker.unlock(); }
     };
     static QPostEventListLocker lockThreadPostEventList(QObject *object);
+    static void postEvents(QSpan<QPostEvent> events);
 #endif // QT_NO_QOBJECT
 
     int &argc;
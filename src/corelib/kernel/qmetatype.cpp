@@ -9,6 +9,7 @@
 #include "qdatetime.h"
 #include "qbytearray.h"
 #include "qreadwritelock.h"
+#include "qmutex.h"
 #include "qhash.h"
 #include "qmap.h"
 #include "qstring.h"
@@ -56,8 +57,12 @@
 # include "qline.h"
 #endif
 
+#include <private/qlocking_p.h>
+
+#include <memory>
 #include <new>
 #include <cstring>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -81,8 +86,54 @@ struct QMetaTypeDeleter
     }
 };
 
+/*
+    The registry of custom types is read far more often than it is written:
+    QMetaType::fromName() and the interface lookups by id run for every
+    queued connection and QVariant conversion involving a custom type, while
+    types are registered a few times per process. Reads therefore take no
+    lock at all; writers serialize on a mutex.
+
+    Both tables only grow, and nothing they point to is freed before the
+    registry itself is destroyed, so a reader can never observe freed memory:
+    - The interfaces by id live in chunks of doubling size, so an id maps to
+      a fixed slot that stays where it is.
+    - The aliases live in an open-addressing hash table of pointers to
+      nodes that hold a name and an interface. Unregistering a type clears
+      the interface of its nodes. Growing the table publishes a new table
+      and retires the old one, which readers may still be probing.
+*/
 struct QMetaTypeCustomRegistry
 {
+    using Interface = const QtPrivate::QMetaTypeInterface;
+
+    struct Alias
+    {
+        QByteArray name;
+        size_t hash;
+        QAtomicPointer<Interface> iface;
+    };
+
+    struct AliasTable
+    {
+        explicit AliasTable(qsizetype capacity)
+            : capacity(capacity), entries(new QAtomicPointer<Alias>[capacity])
+        {
+        }
+
+        qsizetype capacity;     // a power of two
+        std::unique_ptr<QAtomicPointer<Alias>[]> entries;
+    };
+
+    // chunk n holds the indexes [FirstChunkSize * (2^n - 1), FirstChunkSize * (2^(n + 1) - 1))
+    static constexpr int FirstChunkSize = 64;
+    static constexpr int ChunkCount = 26;   // more than INT_MAX ids
+
+    static std::pair<int, qsizetype> chunkAndOffset(qsizetype index) noexcept
+    {
+        const quint64 biased = quint64(index) / FirstChunkSize + 1;
+        const int chunk = 63 - qCountLeadingZeroBits(biased);
+        return { chunk, qsizetype(index - FirstChunkSize * ((qsizetype(1) << chunk) - 1)) };
+    }
 
 #if QT_VERSION < QT_VERSION_CHECK(7, 0, 0) && !defined(QT_BOOTSTRAPPED)
     QMetaTypeCustomRegistry()
@@ -93,23 +144,113 @@ struct QMetaTypeCustomRegistry
           will get the correct built-in type-id (the interface pointers
           might still not match, but we already deal with that case.
         */
-        aliases.insert("qfloat16", QtPrivate::qMetaTypeInterfaceForType<qfloat16>());
+        setAlias("qfloat16", QtPrivate::qMetaTypeInterfaceForType<qfloat16>());
     }
+#else
+    QMetaTypeCustomRegistry() = default;
 #endif
+    ~QMetaTypeCustomRegistry()
+    {
+        for (auto &chunk : chunks)
+            delete[] chunk.loadRelaxed();
+        delete aliases.loadRelaxed();
+    }
 
-    QReadWriteLock lock;
-    QList<const QtPrivate::QMetaTypeInterface *> registry;
-    QHash<QByteArray, const QtPrivate::QMetaTypeInterface *> aliases;
+    QBasicMutex lock;       // serializes writers
+    QBasicAtomicPointer<QAtomicPointer<Interface>> chunks[ChunkCount] = {};
+    QBasicAtomicPointer<AliasTable> aliases = {};
+    // all nodes and the tables replaced by larger ones, guarded by lock
+    std::vector<std::unique_ptr<Alias>> aliasNodes;
+    std::vector<std::unique_ptr<AliasTable>> retiredAliasTables;
+    qsizetype usedAliasSlots = 0;
+    int size = 0;           // one past the highest id ever used, minus User + 1
     // index of first empty (unregistered) type in registry, if any.
     int firstEmpty = 0;
 
+    static size_t hashName(QByteArrayView name) noexcept
+    {
+        // not seeded: the table is shared by all threads for the life time
+        // of the process, and only ever contains type names
+        return qHash(name, 0);
+    }
+
+    Interface *alias(QByteArrayView name) const noexcept
+    {
+        const AliasTable *table = aliases.loadAcquire();
+        if (!table)
+            return nullptr;
+        const size_t hash = hashName(name);
+        const size_t mask = size_t(table->capacity) - 1;
+        for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+            const Alias *node = table->entries[i].loadAcquire();
+            if (!node)
+                return nullptr;
+            if (node->hash == hash && node->name == name)
+                return node->iface.loadAcquire();
+        }
+    }
+
+    // the slot of name in table, or the empty slot where it belongs
+    static QAtomicPointer<Alias> &findSlot(const AliasTable &table, QByteArrayView name,
+                                           size_t hash) noexcept
+    {
+        const size_t mask = size_t(table.capacity) - 1;
+        for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+            const Alias *node = table.entries[i].loadRelaxed();
+            if (!node || (node->hash == hash && node->name == name))
+                return table.entries[i];
+        }
+    }
+
+    // Requires lock. Returns the node for name, creating it if needed.
+    Alias *aliasNode(const QByteArray &name)
+    {
+        AliasTable *table = aliases.loadRelaxed();
+        const size_t hash = hashName(name);
+        if (table) {
+            if (Alias *node = findSlot(*table, name, hash).loadRelaxed())
+                return node;
+        }
+        if (!table || 2 * (usedAliasSlots + 1) > table->capacity) {
+            auto grown = std::make_unique<AliasTable>(table ? 2 * table->capacity : 64);
+            for (const auto &node : aliasNodes)
+                findSlot(*grown, node->name, node->hash).storeRelaxed(node.get());
+            aliases.storeRelease(grown.get());
+            if (table)
+                retiredAliasTables.emplace_back(table);
+            table = grown.release();
+        }
+        auto node = std::make_unique<Alias>(Alias{ name, hash, nullptr });
+        findSlot(*table, name, hash).storeRelease(node.get());
+        ++usedAliasSlots;
+        return aliasNodes.emplace_back(std::move(node)).get();
+    }
+
+    // Requires lock
+    void setAlias(const QByteArray &name, Interface *iface)
+    {
+        aliasNode(name)->iface.storeRelease(iface);
+    }
+
+    // Requires lock
+    QAtomicPointer<Interface> &slotForIndex(qsizetype index)
+    {
+        const auto [chunk, offset] = chunkAndOffset(index);
+        QAtomicPointer<Interface> *storage = chunks[chunk].loadRelaxed();
+        if (!storage) {
+            storage = new QAtomicPointer<Interface>[FirstChunkSize << chunk];
+            chunks[chunk].storeRelease(storage);
+        }
+        return storage[offset];
+    }
+
     int registerCustomType(const QtPrivate::QMetaTypeInterface *cti)
     {
         // we got here because cti->typeId is 0, so this is a custom meta type
         // (not read-only)
         auto ti = const_cast<QtPrivate::QMetaTypeInterface *>(cti);
         {
-            QWriteLocker l(&lock);
+            const auto l = qt_scoped_lock(lock);
             if (int id = ti->typeId.loadRelaxed())
                 return id;
             QByteArray name =
@@ -117,23 +258,20 @@ struct QMetaTypeCustomRegistry
                     QMetaObject::normalizedType
 #endif
                     (ti->name);
-            if (auto ti2 = aliases.value(name)) {
+            Alias *node = aliasNode(name);
+            if (auto ti2 = node->iface.loadRelaxed()) {
                 const auto id = ti2->typeId.loadRelaxed();
                 ti->typeId.storeRelaxed(id);
                 return id;
             }
-            aliases[name] = ti;
-            int size = registry.size();
-            while (firstEmpty < size && registry[firstEmpty])
-                ++firstEmpty;
-            if (firstEmpty < size) {
-                registry[firstEmpty] = ti;
+            while (firstEmpty < size && slotForIndex(firstEmpty).loadRelaxed())
                 ++firstEmpty;
-            } else {
-                registry.append(ti);
-                firstEmpty = registry.size();
-            }
-            ti->typeId.storeRelaxed(firstEmpty + QMetaType::User);
+            // the id must be set before readers can find the interface
+            ti->typeId.storeRelaxed(firstEmpty + 1 + QMetaType::User);
+            slotForIndex(firstEmpty).storeRelease(ti);
+            node->iface.storeRelease(ti);
+            ++firstEmpty;
+            size = std::max(size, firstEmpty);
         }
         if (ti->legacyRegisterOp)
             ti->legacyRegisterOp();
@@ -145,22 +283,30 @@ struct QMetaTypeCustomRegistry
         if (!id)
             return;
         Q_ASSERT(id > QMetaType::User);
-        QWriteLocker l(&lock);
+        const auto l = qt_scoped_lock(lock);
         int idx = id - QMetaType::User - 1;
-        auto &ti = registry[idx];
+        auto &slot = slotForIndex(idx);
+        Interface *ti = slot.loadRelaxed();
 
         // We must unregister all names.
-        aliases.removeIf([ti] (const auto &kv) { return kv.value() == ti; });
+        for (const auto &node : aliasNodes)
+            node->iface.testAndSetRelease(ti, nullptr);
 
-        ti = nullptr;
+        slot.storeRelease(nullptr);
 
         firstEmpty = std::min(firstEmpty, idx);
     }
 
-    const QtPrivate::QMetaTypeInterface *getCustomType(int id)
+    const QtPrivate::QMetaTypeInterface *getCustomType(int id) const noexcept
     {
-        QReadLocker l(&lock);
-        return registry.value(id - QMetaType::User - 1);
+        const qsizetype index = qsizetype(id) - QMetaType::User - 1;
+        if (index < 0)
+            return nullptr;
+        const auto [chunk, offset] = chunkAndOffset(index);
+        if (chunk >= ChunkCount)
+            return nullptr;
+        const QAtomicPointer<Interface> *storage = chunks[chunk].loadAcquire();
+        return storage ? storage[offset].loadAcquire() : nullptr;
     }
 };
 
@@ -178,15 +324,15 @@ const char *QtMetaTypePrivate::typedefNameForType(const QtPrivate::QMetaTypeInte
     QMetaTypeCustomRegistry *r = &*customTypeRegistry;
 
     QByteArrayView officialName(type_d->name);
-    QReadLocker l(&r->lock);
-    auto it = r->aliases.constBegin();
-    auto end = r->aliases.constEnd();
+    auto l = qt_unique_lock(r->lock);
+    auto it = r->aliasNodes.cbegin();
+    const auto end = r->aliasNodes.cend();
     for ( ; it != end; ++it) {
-        if (it.value() != type_d)
+        if ((*it)->iface.loadRelaxed() != type_d)
             continue;
-        if (it.key() == officialName)
+        if ((*it)->name == officialName)
             continue;               // skip the official name
-        name = it.key().constData();
+        name = (*it)->name.constData();
         ++it;
         break;
     }
@@ -194,8 +340,8 @@ const char *QtMetaTypePrivate::typedefNameForType(const QtPrivate::QMetaTypeInte
 #ifndef QT_NO_DEBUG
     QByteArrayList otherNames;
     for ( ; it != end; ++it) {
-        if (it.value() == type_d && it.key() != officialName)
-            otherNames << it.key();
+        if ((*it)->iface.loadRelaxed() == type_d && (*it)->name != officialName)
+            otherNames << (*it)->name;
     }
     l.unlock();
     if (!otherNames.isEmpty())
@@ -2755,19 +2901,13 @@ static inline int qMetaTypeStaticType(const char *typeName, int length)
 
 /*
     Similar to QMetaType::type(), but only looks in the custom set of
-    types, and doesn't lock the mutex.
-
+    types. Takes no lock.
 */
-static int qMetaTypeCustomType_unlocked(const char *typeName, int length)
+static int qMetaTypeCustomType(const char *typeName, int length)
 {
     if (customTypeRegistry.exists()) {
-        auto reg = &*customTypeRegistry;
-#if QT_CONFIG(thread)
-        Q_ASSERT(!reg->lock.tryLockForWrite());
-#endif
-        if (auto ti = reg->aliases.value(QByteArray::fromRawData(typeName, length), nullptr)) {
+        if (auto ti = customTypeRegistry->alias(QByteArrayView(typeName, length)))
             return ti->typeId.loadRelaxed();
-        }
     }
     return QMetaType::UnknownType;
 }
@@ -2785,11 +2925,8 @@ void QMetaType::registerNormalizedTypedef(const NS(QByteArray) & normalizedTypeN
     if (!metaType.isValid())
         return;
     if (auto reg = customTypeRegistry()) {
-        QWriteLocker lock(&reg->lock);
-        auto &al = reg->aliases[normalizedTypeName];
-        if (al)
-            return;
-        al = metaType.d_ptr;
+        const auto lock = qt_scoped_lock(reg->lock);
+        reg->aliasNode(normalizedTypeName)->iface.testAndSetRelease(nullptr, metaType.d_ptr);
     }
 }
 
@@ -2831,16 +2968,15 @@ static inline int qMetaTypeTypeImpl(const char *typeName, int length)
         return QMetaType::UnknownType;
     int type = qMetaTypeStaticType(typeName, length);
     if (type == QMetaType::UnknownType) {
-        QReadLocker locker(&customTypeRegistry()->lock);
-        type = qMetaTypeCustomType_unlocked(typeName, length);
+        type = qMetaTypeCustomType(typeName, length);
 #ifndef QT_NO_QOBJECT
         if ((type == QMetaType::UnknownType) && tryNormalizedType) {
             const NS(QByteArray) normalizedTypeName = QMetaObject::normalizedType(typeName);
             type = qMetaTypeStaticType(normalizedTypeName.constData(),
                                        normalizedTypeName.size());
             if (type == QMetaType::UnknownType) {
-                type = qMetaTypeCustomType_unlocked(normalizedTypeName.constData(),
-                                                    normalizedTypeName.size());
+                type = qMetaTypeCustomType(normalizedTypeName.constData(),
+                                           normalizedTypeName.size());
             }
         }
 #endif
@@ -480,6 +480,64 @@ QAbstractMetaCallEvent::~QAbstractMetaCallEvent()
 #endif
 }
 
+/*!
+    \internal
+
+    The arguments of one emission of a signal, copied once and shared by the
+    events posted to all of its queued receivers. Slots only read queued
+    arguments, so the receivers can use them concurrently; the last event to
+    be destroyed destroys them.
+*/
+class QSharedMetaCallArguments
+{
+public:
+    Q_DISABLE_COPY_MOVE(QSharedMetaCallArguments)
+
+    static QSharedMetaCallArguments *create(const int *argumentTypes, int nargs, void **argv)
+    {
+        constexpr size_t each = sizeof(void *) + sizeof(QMetaType);
+        void *memory = malloc(sizeof(QSharedMetaCallArguments) + nargs * each);
+        Q_CHECK_PTR(memory);
+        auto *arguments = new (memory) QSharedMetaCallArguments(nargs);
+
+        void **args = arguments->args();
+        QMetaType *types = arguments->types();
+        new (types) QMetaType(); // return type
+        args[0] = nullptr; // return value
+        for (int n = 1; n < nargs; ++n)
+            new (types + n) QMetaType(argumentTypes[n - 1]);
+        for (int n = 1; n < nargs; ++n)
+            args[n] = types[n].create(argv[n]);
+        return arguments;
+    }
+
+    void ref() { refCount.ref(); }
+    void deref()
+    {
+        if (refCount.deref())
+            return;
+        QMetaType *t = types();
+        for (int i = 1; i < nargs; ++i) {
+            if (t[i].isValid() && args()[i])
+                t[i].destroy(args()[i]);
+        }
+        this->~QSharedMetaCallArguments();
+        free(this);
+    }
+
+    int count() const { return nargs; }
+    void **args() { return reinterpret_cast<void **>(this + 1); }
+    QMetaType *types() { return reinterpret_cast<QMetaType *>(args() + nargs); }
+
+private:
+    explicit QSharedMetaCallArguments(int nargs) : refCount(1), nargs(nargs) { }
+    ~QSharedMetaCallArguments() = default;
+
+    QAtomicInt refCount;
+    int nargs;
+};
+static_assert(sizeof(QSharedMetaCallArguments) % alignof(void *) == 0);
+
 /*!
     \internal
  */
@@ -595,12 +653,47 @@ QMetaCallEvent::QMetaCallEvent(QtPrivate::SlotObjUniquePtr slotO,
     allocArgs();
 }
 
+/*!
+    \internal
+
+    Uses the arguments in \a sharedArgs, which the event keeps a reference to.
+ */
+QMetaCallEvent::QMetaCallEvent(ushort method_offset, ushort method_relative,
+                               QObjectPrivate::StaticMetaCallFunction callFunction,
+                               const QObject *sender, int signalId,
+                               QSharedMetaCallArguments *sharedArgs)
+    : QAbstractMetaCallEvent(sender, signalId),
+      d({nullptr, sharedArgs->args(), callFunction, sharedArgs->count(), method_offset,
+         method_relative, sharedArgs}),
+      prealloc_()
+{
+    sharedArgs->ref();
+}
+
+/*!
+    \internal
+
+    Uses the arguments in \a sharedArgs, which the event keeps a reference to.
+ */
+QMetaCallEvent::QMetaCallEvent(QtPrivate::SlotObjUniquePtr slotO,
+                               const QObject *sender, int signalId,
+                               QSharedMetaCallArguments *sharedArgs)
+    : QAbstractMetaCallEvent(sender, signalId),
+      d{std::move(slotO), sharedArgs->args(), nullptr, sharedArgs->count(), 0, ushort(-1),
+        sharedArgs},
+      prealloc_()
+{
+    sharedArgs->ref();
+}
+
 /*!
     \internal
  */
 QMetaCallEvent::~QMetaCallEvent()
 {
-    if (d.nargs_) {
+    if (d.sharedArgs_) {
+        d.sharedArgs_->deref();
+    } else if (d.nargs_) {
         QMetaType *t = types();
         for (int i = 0; i < d.nargs_; ++i) {
             if (t[i].isValid() && d.args_[i])
@@ -3932,9 +4025,12 @@ private:
 /*!
     \internal
 
+    Returns the types of the arguments that \a c queues, or \nullptr if they
+    cannot be queued.
+
     \a signal must be in the signal index range (see QObjectPrivate::signalIndex()).
 */
-static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connection *c, void **argv)
+static const int *queuedArgumentTypes(QObject *sender, int signal, QObjectPrivate::Connection *c)
 {
     const int *argumentTypes = c->argumentTypes.loadRelaxed();
     if (!argumentTypes) {
@@ -3949,10 +4045,29 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
         }
     }
     if (argumentTypes == &DIRECT_CONNECTION_ONLY) // cannot activate
-        return;
+        return nullptr;
+    return argumentTypes;
+}
+
+static int queuedArgumentCount(const int *argumentTypes)
+{
     int nargs = 1; // include return type
     while (argumentTypes[nargs - 1])
         ++nargs;
+    return nargs;
+}
+
+/*!
+    \internal
+
+    \a signal must be in the signal index range (see QObjectPrivate::signalIndex()).
+*/
+static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connection *c, void **argv)
+{
+    const int *argumentTypes = queuedArgumentTypes(sender, signal, c);
+    if (!argumentTypes)
+        return;
+    const int nargs = queuedArgumentCount(argumentTypes);
 
     QMutexLocker locker(signalSlotLock(c->receiver.loadRelaxed()));
     QObject *receiver = c->receiver.loadRelaxed();
@@ -3998,6 +4113,151 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
     QCoreApplication::postEvent(receiver, ev);
 }
 
+/*!
+    \internal
+
+    Collects the queued connections activated by one emission of a signal,
+    and posts their events together when flushed. The arguments are copied
+    once for all connections with the same argument types, and the events are
+    posted with one lock of the event queue of each receiving thread.
+
+    The locks of all receivers are held while posting, so that none of them
+    can be destroyed in the meantime; they are taken in the order of their
+    addresses, like QOrderedMutexLocker does.
+*/
+class QueuedActivations
+{
+public:
+    QueuedActivations(QObject *sender, int signal, void **argv)
+        : sender(sender), signal(signal), argv(argv)
+    { }
+
+    void add(QObjectPrivate::Connection *c) { connections.append(c); }
+
+    void flush()
+    {
+        if (connections.size() == 1)
+            queued_activate(sender, signal, connections.first(), argv);
+        else if (!connections.isEmpty())
+            activate();
+        connections.clear();
+    }
+
+private:
+    struct Call
+    {
+        QObjectPrivate::Connection *connection;
+        QObject *receiver;
+        QMetaCallEvent *event;
+    };
+
+    void lockReceivers()
+    {
+        for (QBasicMutex *mutex : std::as_const(mutexes))
+            mutex->lock();
+    }
+
+    void unlockReceivers()
+    {
+        for (auto it = mutexes.crbegin(); it != mutexes.crend(); ++it)
+            (*it)->unlock();
+    }
+
+    static bool sameTypes(const int *types, const int *other)
+    {
+        for (; *types == *other; ++types, ++other) {
+            if (!*types)
+                return true;
+        }
+        return false;
+    }
+
+    void activate()
+    {
+        QVarLengthArray<Call, 16> calls;
+        QVarLengthArray<QtPrivate::SlotObjUniquePtr, 16> slotObjects;
+        for (QObjectPrivate::Connection *c : std::as_const(connections)) {
+            if (QObject *receiver = c->receiver.loadRelaxed()) {
+                calls.append(Call{ c, nullptr, nullptr });
+                mutexes.append(signalSlotLock(receiver));
+            }
+        }
+        std::sort(mutexes.begin(), mutexes.end());
+        mutexes.erase(std::unique(mutexes.begin(), mutexes.end()), mutexes.end());
+
+        // The receivers may have been disconnected before we got the locks
+        lockReceivers();
+        for (Call &call : calls) {
+            call.receiver = call.connection->receiver.loadRelaxed();
+            QtPrivate::QSlotObjectBase *slotObj =
+                    call.receiver && call.connection->isSlotObject ? call.connection->slotObj
+                                                                   : nullptr;
+            if (slotObj)
+                slotObj->ref();
+            slotObjects.emplace_back(slotObj);
+        }
+        unlockReceivers();
+
+        QSharedMetaCallArguments *sharedArgs = nullptr;
+        const int *sharedTypes = nullptr;
+        auto releaseSharedArgs = qScopeGuard([&] {
+            if (sharedArgs)
+                sharedArgs->deref();
+        });
+        for (qsizetype i = 0; i < calls.size(); ++i) {
+            Call &call = calls[i];
+            QObjectPrivate::Connection *c = call.connection;
+            const int *argumentTypes = call.receiver
+                    ? queuedArgumentTypes(sender, signal, c) : nullptr;
+            if (!argumentTypes)
+                continue;
+            if (!sharedArgs || !sameTypes(argumentTypes, sharedTypes)) {
+                if (sharedArgs)
+                    sharedArgs->deref();
+                sharedArgs = QSharedMetaCallArguments::create(
+                        argumentTypes, queuedArgumentCount(argumentTypes), argv);
+                sharedTypes = argumentTypes;
+            }
+
+            call.event = c->isSlotObject
+                    ? new QMetaCallEvent(std::move(slotObjects[i]), sender, signal, sharedArgs)
+                    : new QMetaCallEvent(c->method_offset, c->method_relative, c->callFunction,
+                                         sender, signal, sharedArgs);
+            if (c->isSingleShot && !QObjectPrivate::removeConnection(c)) {
+                delete std::exchange(call.event, nullptr);
+                continue;
+            }
+        }
+
+        // Events are deleted without holding the locks, as deleting them may
+        // destroy slot objects and arguments
+        QVarLengthArray<QPostEvent, 16> events;
+        lockReceivers();
+        for (Call &call : calls) {
+            if (!call.event)
+                continue;
+            if (!call.connection->isSingleShot && !call.connection->receiver.loadRelaxed()) {
+                // the connection has been disconnected while we were unlocked
+                continue;
+            }
+            events.emplace_back(call.receiver, std::exchange(call.event, nullptr),
+                                int(Qt::NormalEventPriority));
+        }
+        QCoreApplicationPrivate::postEvents(events);
+        unlockReceivers();
+
+        for (Call &call : calls)
+            delete call.event;
+        mutexes.clear();
+    }
+
+    QObject *sender;
+    int signal;
+    void **argv;
+    QVarLengthArray<QObjectPrivate::Connection *, 16> connections;
+    QVarLengthArray<QBasicMutex *, 16> mutexes;
+};
+
 template <bool callbacks_enabled>
 void doActivate(QObject *sender, int signal_index, void **argv)
 {
@@ -4048,6 +4308,11 @@ void doActivate(QObject *sender, int signal_index, void **argv)
     Qt::HANDLE currentThreadId = QThread::currentThreadId();
     bool inSenderThread = currentThreadId == QObjectPrivate::get(sender)->threadData.loadRelaxed()->threadId.loadRelaxed();
 
+    // Consecutive queued connections are activated together; they are
+    // flushed before calling any other connection, which might post events
+    // of its own
+    QueuedActivations queuedActivations(sender, signal_index, argv);
+
     // We need to check against the highest connection id to ensure that signals added
     // during the signal emission are not emitted in this emission.
     uint highestConnectionId = connections->currentConnectionId.loadRelaxed();
@@ -4079,10 +4344,13 @@ void doActivate(QObject *sender, int signal_index, void **argv)
             // put into the event queue
             if ((c->connectionType == Qt::AutoConnection && !receiverInSameThread)
                 || (c->connectionType == Qt::QueuedConnection)) {
-                queued_activate(sender, signal_index, c, argv);
+                queuedActivations.add(c);
                 continue;
+            }
+
+            queuedActivations.flush();
 #if QT_CONFIG(thread)
-            } else if (c->connectionType == Qt::BlockingQueuedConnection) {
+            if (c->connectionType == Qt::BlockingQueuedConnection) {
                 if (receiverInSameThread) {
                     qWarning("Qt: Dead lock detected while activating a BlockingQueuedConnection: "
                     "Sender is %s(%p), receiver is %s(%p)",
@@ -4106,8 +4374,8 @@ void doActivate(QObject *sender, int signal_index, void **argv)
                 }
                 semaphore.acquire();
                 continue;
-#endif
             }
+#endif
 
             if (c->isSingleShot && !QObjectPrivate::removeConnection(c))
                 continue;
@@ -4159,6 +4427,7 @@ void doActivate(QObject *sender, int signal_index, void **argv)
         //start over for all signals;
         ((list = &signalVector->at(-1)), true));
 
+        queuedActivations.flush();
         if (connections->currentConnectionId.loadRelaxed() == 0)
             senderDeleted = true;
     }
@@ -341,6 +341,7 @@ bool QObjectPrivate::disconnect(const typename QtPrivate::FunctionPointer< Func1
 }
 
 class QSemaphore;
+class QSharedMetaCallArguments;
 class Q_CORE_EXPORT QAbstractMetaCallEvent : public QEvent
 {
 public:
@@ -392,6 +393,15 @@ public:
                    const QObject *sender, int signalId,
                    int nargs);
 
+    // queued - args shared with the other events of the same emission
+    QMetaCallEvent(ushort method_offset, ushort method_relative,
+                   QObjectPrivate::StaticMetaCallFunction callFunction,
+                   const QObject *sender, int signalId,
+                   QSharedMetaCallArguments *sharedArgs);
+    QMetaCallEvent(QtPrivate::SlotObjUniquePtr slotObj,
+                   const QObject *sender, int signalId,
+                   QSharedMetaCallArguments *sharedArgs);
+
     ~QMetaCallEvent() override;
 
     template<typename ...Args>
@@ -443,6 +453,7 @@ private:
         int nargs_;
         ushort method_offset_;
         ushort method_relative_;
+        QSharedMetaCallArguments *sharedArgs_ = nullptr;
     } d;
     // preallocate enough space for three arguments
     alignas(void *) char prealloc_[3 * sizeof(void *) + 3 * sizeof(QMetaType)];
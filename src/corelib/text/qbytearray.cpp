@@ -4352,6 +4352,23 @@ QByteArray QByteArray::number(qulonglong n, int base)
     return s;
 }
 
+static QLocaleData::DoubleForm doubleFormForNumber(char format)
+{
+    switch (QtMiscUtils::toAsciiLower(format)) {
+        case 'f':
+            return QLocaleData::DFDecimal;
+        case 'e':
+            return QLocaleData::DFExponent;
+        case 'g':
+            return QLocaleData::DFSignificantDigits;
+        default:
+#if defined(QT_CHECK_RANGE)
+            qWarning("QByteArray::setNum: Invalid format char '%c'", format);
+#endif
+            return QLocaleData::DFDecimal;
+    }
+}
+
 /*!
     \overload
     Returns a byte-array representing the floating-point number \a n as text.
@@ -4366,26 +4383,25 @@ QByteArray QByteArray::number(qulonglong n, int base)
 */
 QByteArray QByteArray::number(double n, char format, int precision)
 {
-    QLocaleData::DoubleForm form = QLocaleData::DFDecimal;
+    return qdtoAscii(n, doubleFormForNumber(format), precision, isUpperCaseAscii(format));
+}
 
-    switch (QtMiscUtils::toAsciiLower(format)) {
-        case 'f':
-            form = QLocaleData::DFDecimal;
-            break;
-        case 'e':
-            form = QLocaleData::DFExponent;
-            break;
-        case 'g':
-            form = QLocaleData::DFSignificantDigits;
-            break;
-        default:
-#if defined(QT_CHECK_RANGE)
-            qWarning("QByteArray::setNum: Invalid format char '%c'", format);
-#endif
-            break;
-    }
+/*!
+    \since 6.10
+    \overload
 
-    return qdtoAscii(n, form, precision, isUpperCaseAscii(format));
+    Writes the text that number(\a n, \a format, \a precision) returns to
+    \a buffer, without allocating memory, and returns its length. If it
+    doesn't fit in \a buffer, returns -1 and leaves \a buffer unspecified.
+
+    With QLocale::FloatingPointShortest as \a precision, 25 bytes are always
+    enough for the \c{'e'} and \c{'g'} formats.
+
+    \sa QString::number()
+*/
+qsizetype QByteArray::number(double n, QSpan<char> buffer, char format, int precision)
+{
+    return qdtoAscii(n, doubleFormForNumber(format), precision, isUpperCaseAscii(format), buffer);
 }
 
 /*!
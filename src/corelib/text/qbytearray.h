@@ -13,6 +13,7 @@
 #include <QtCore/qcontainerfwd.h>
 #include <QtCore/qbytearrayalgorithms.h>
 #include <QtCore/qbytearrayview.h>
+#include <QtCore/qspan.h>
 
 #include <stdlib.h>
 #include <string.h>
@@ -406,6 +407,7 @@ public:
     [[nodiscard]] static QByteArray number(qlonglong, int base = 10);
     [[nodiscard]] static QByteArray number(qulonglong, int base = 10);
     [[nodiscard]] static QByteArray number(double, char format = 'g', int precision = 6);
+    static qsizetype number(double, QSpan<char> buffer, char format = 'g', int precision = 6);
     [[nodiscard]] static QByteArray fromRawData(const char *data, qsizetype size)
     {
         return QByteArray(DataPointer(nullptr, const_cast<char *>(data), size));
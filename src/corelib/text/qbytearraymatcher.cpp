@@ -2,12 +2,15 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qbytearraymatcher.h"
+#include "qbytearraymatcher_p.h"
 
 #include <qtconfiginclude.h>
 #ifndef QT_BOOTSTRAPPED
 #  include <private/qtcore-config_p.h>
 #endif
 
+#include <private/qsimd_p.h>
+
 #include <limits.h>
 
 QT_BEGIN_NAMESPACE
@@ -56,6 +59,134 @@ static inline qsizetype bm_find(const uchar *cc, qsizetype l, qsizetype index, c
     return -1; // not found
 }
 
+/*
+    SIMD search for needles of two or more bytes, as used by many memmem()
+    implementations: for a whole block of candidate positions at once,
+    compare the haystack against the first and the last byte of the needle,
+    and only compare the bytes in between for the candidates that match
+    both. Unlike Boyer-Moore, this doesn't depend on the needle's last byte
+    being rare in the haystack to be fast.
+
+    Returns the position of the first match at or after \a from, or -1.
+    In the latter case, \a *resumeFrom is set to the first candidate
+    position that hasn't been examined; the caller must search the rest
+    (which is shorter than a block plus the needle) with scalar code.
+*/
+#if defined(__SSE2__)
+static qsizetype simd_find_sse2(const uchar *cc, qsizetype l, qsizetype from, const uchar *puc,
+                                qsizetype pl, qsizetype *resumeFrom) noexcept
+{
+    const __m128i first = _mm_set1_epi8(char(puc[0]));
+    const __m128i last = _mm_set1_epi8(char(puc[pl - 1]));
+    qsizetype i = from;
+    for ( ; i + pl - 1 + qsizetype(sizeof(__m128i)) <= l; i += sizeof(__m128i)) {
+        const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cc + i));
+        const __m128i blockLast =
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(cc + i + pl - 1));
+        uint mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, blockFirst),
+                                                    _mm_cmpeq_epi8(last, blockLast)));
+        while (mask) {
+            const uint idx = qCountTrailingZeroBits(mask);
+            if (memcmp(cc + i + idx + 1, puc + 1, pl - 2) == 0)
+                return i + idx;
+            mask &= mask - 1;
+        }
+    }
+    *resumeFrom = i;
+    return -1;
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+static QT_FUNCTION_TARGET(ARCH_HASWELL)
+qsizetype simd_find_avx2(const uchar *cc, qsizetype l, qsizetype from, const uchar *puc,
+                         qsizetype pl, qsizetype *resumeFrom) noexcept
+{
+    const __m256i first = _mm256_set1_epi8(char(puc[0]));
+    const __m256i last = _mm256_set1_epi8(char(puc[pl - 1]));
+    qsizetype i = from;
+    for ( ; i + pl - 1 + qsizetype(sizeof(__m256i)) <= l; i += sizeof(__m256i)) {
+        const __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(cc + i));
+        const __m256i blockLast =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i *>(cc + i + pl - 1));
+        uint mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst),
+                                                          _mm256_cmpeq_epi8(last, blockLast)));
+        while (mask) {
+            const uint idx = qCountTrailingZeroBits(mask);
+            if (memcmp(cc + i + idx + 1, puc + 1, pl - 2) == 0)
+                return i + idx;
+            mask &= mask - 1;
+        }
+    }
+    *resumeFrom = i;
+    return -1;
+}
+#endif
+
+#if defined(__ARM_NEON__)
+static qsizetype simd_find_neon(const uchar *cc, qsizetype l, qsizetype from, const uchar *puc,
+                                qsizetype pl, qsizetype *resumeFrom) noexcept
+{
+    const uint8x16_t first = vdupq_n_u8(puc[0]);
+    const uint8x16_t last = vdupq_n_u8(puc[pl - 1]);
+    qsizetype i = from;
+    for ( ; i + pl - 1 + qsizetype(sizeof(uint8x16_t)) <= l; i += sizeof(uint8x16_t)) {
+        const uint8x16_t match = vandq_u8(vceqq_u8(first, vld1q_u8(cc + i)),
+                                          vceqq_u8(last, vld1q_u8(cc + i + pl - 1)));
+        // narrow each byte of the comparison result to a nibble of the mask
+        const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(match), 4);
+        quint64 mask = vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+        while (mask) {
+            const uint idx = qCountTrailingZeroBits(mask) / 4;
+            if (memcmp(cc + i + idx + 1, puc + 1, pl - 2) == 0)
+                return i + idx;
+            mask &= ~(Q_UINT64_C(0xf) << (idx * 4));
+        }
+    }
+    *resumeFrom = i;
+    return -1;
+}
+#endif
+
+/*!
+    \internal
+
+    Dispatches to the best SIMD implementation available for the CPU. Also
+    used by QLatin1StringMatcher.
+*/
+qsizetype QtPrivate::qFindByteArraySimd(const uchar *cc, qsizetype l, qsizetype from,
+                                        const uchar *puc, qsizetype pl,
+                                        qsizetype *resumeFrom) noexcept
+{
+    Q_ASSERT(pl >= 2);
+    *resumeFrom = from;
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(ArchHaswell))
+        return simd_find_avx2(cc, l, from, puc, pl, resumeFrom);
+#endif
+#if defined(__SSE2__)
+    return simd_find_sse2(cc, l, from, puc, pl, resumeFrom);
+#elif defined(__ARM_NEON__)
+    return simd_find_neon(cc, l, from, puc, pl, resumeFrom);
+#else
+    Q_UNUSED(cc);
+    Q_UNUSED(l);
+    Q_UNUSED(puc);
+    return -1;
+#endif
+}
+
+static inline qsizetype find_pattern(const uchar *cc, qsizetype l, qsizetype index,
+                                     const uchar *puc, qsizetype pl, const uchar *skiptable)
+{
+    if (pl >= 2) {
+        const qsizetype found = QtPrivate::qFindByteArraySimd(cc, l, index, puc, pl, &index);
+        if (found >= 0)
+            return found;
+    }
+    return bm_find(cc, l, index, puc, pl, skiptable);
+}
+
 /*! \class QByteArrayMatcher
     \inmodule QtCore
     \brief The QByteArrayMatcher class holds a sequence of bytes that
@@ -185,8 +316,8 @@ qsizetype QByteArrayMatcher::indexIn(const char *str, qsizetype len, qsizetype f
 {
     if (from < 0)
         from = 0;
-    return bm_find(reinterpret_cast<const uchar *>(str), len, from,
-                   p.p, p.l, p.q_skiptable);
+    return find_pattern(reinterpret_cast<const uchar *>(str), len, from,
+                        p.p, p.l, p.q_skiptable);
 }
 
 /*!
@@ -204,8 +335,8 @@ qsizetype QByteArrayMatcher::indexIn(QByteArrayView data, qsizetype from) const
 {
     if (from < 0)
         from = 0;
-    return bm_find(reinterpret_cast<const uchar *>(data.data()), data.size(), from,
-                   p.p, p.l, p.q_skiptable);
+    return find_pattern(reinterpret_cast<const uchar *>(data.data()), data.size(), from,
+                        p.p, p.l, p.q_skiptable);
 }
 
 /*!
@@ -229,8 +360,8 @@ static qsizetype qFindByteArrayBoyerMoore(
     bm_init_skiptable((const uchar *)needle, needleLen, skiptable);
     if (haystackOffset < 0)
         haystackOffset = 0;
-    return bm_find((const uchar *)haystack, haystackLen, haystackOffset,
-                   (const uchar *)needle, needleLen, skiptable);
+    return find_pattern((const uchar *)haystack, haystackLen, haystackOffset,
+                        (const uchar *)needle, needleLen, skiptable);
 }
 
 /*!
@@ -384,8 +515,8 @@ qsizetype QStaticByteArrayMatcherBase::indexOfIn(const char *needle, size_t nlen
 {
     if (from < 0)
         from = 0;
-    return bm_find(reinterpret_cast<const uchar *>(haystack), hlen, from,
-                   reinterpret_cast<const uchar *>(needle),   nlen, m_skiptable.data);
+    return find_pattern(reinterpret_cast<const uchar *>(haystack), hlen, from,
+                        reinterpret_cast<const uchar *>(needle), nlen, m_skiptable.data);
 }
 
 /*!
@@ -0,0 +1,35 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QBYTEARRAYMATCHER_P_H
+#define QBYTEARRAYMATCHER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of internal files.  This header file may change from version to version
+// without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+// Searches for the pl >= 2 bytes at puc in the l bytes at cc, starting at
+// from. Returns the index of the first match, or -1; in the latter case
+// *resumeFrom is where the caller has to continue the search with a scalar
+// algorithm, as the tail of the haystack is not examined.
+qsizetype qFindByteArraySimd(const uchar *cc, qsizetype l, qsizetype from, const uchar *puc,
+                             qsizetype pl, qsizetype *resumeFrom) noexcept;
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
+
+#endif // QBYTEARRAYMATCHER_P_H
@@ -10,6 +10,9 @@
 #include "qlocale_p.h"
 #include "qthreadstorage.h"
 
+#include <algorithm>
+#include <numeric>
+
 QT_BEGIN_NAMESPACE
 QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QCollatorSortKeyPrivate)
 
@@ -390,6 +393,82 @@ QCollatorSortKey QCollator::defaultSortKey(QStringView key)
     \note Not supported with the C (a.k.a. POSIX) locale on Darwin.
 */
 
+/*!
+    \since 6.10
+
+    Sorts \a strings in place, in the order of compare(). Strings that
+    compare equal keep their relative order.
+
+    This is faster than sorting with compare(), or with sort keys made one
+    by one by sortKey(), as the sort keys of all strings are made at once,
+    in parallel for long lists, and packed together.
+
+    \sa sortKey(), compare()
+*/
+void QCollator::sort(QSpan<QString> strings) const
+{
+    if (strings.size() < 2)
+        return;
+    d->ensureInitialized();
+#if QT_CONFIG(icu)
+    if (d->collator) {
+        d->sortByKeys(strings);
+        return;
+    }
+#else
+    if (!d->isC()) {
+        QList<QCollatorSortKey> keys;
+        keys.reserve(strings.size());
+        for (const QString &string : strings)
+            keys.append(sortKey(string));
+        QList<qsizetype> order(strings.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&keys](qsizetype lhs, qsizetype rhs) {
+            return keys.at(lhs).compare(keys.at(rhs)) < 0;
+        });
+        QStringList sorted;
+        sorted.reserve(strings.size());
+        for (qsizetype i : order)
+            sorted.append(std::move(strings[i]));
+        std::move(sorted.begin(), sorted.end(), strings.begin());
+        return;
+    }
+#endif
+    std::stable_sort(strings.begin(), strings.end(), *this);
+}
+
+/*!
+    \internal
+    \class QCollatorSortKeyCache
+
+    Compares strings with the default collator, like
+    QString::localeAwareCompare(), through the sort keys of up to the given
+    number of recently compared strings. The keys are dropped when the
+    default locale changes.
+*/
+int QCollatorSortKeyCache::compare(const QString &s1, const QString &s2)
+{
+    const int currentGeneration = QLocalePrivate::s_generation.loadRelaxed();
+    if (Q_UNLIKELY(generation != currentGeneration)) {
+        generation = currentGeneration;
+        collator = QCollator();
+        keys.clear();
+    }
+    // compare() special-cases these, and the C locale's keys needn't match it
+    if (s1.isEmpty() || s2.isEmpty() || collator.locale().language() == QLocale::C)
+        return collator.compare(s1, s2);
+    return sortKey(s1).compare(sortKey(s2));
+}
+
+QCollatorSortKey QCollatorSortKeyCache::sortKey(const QString &string)
+{
+    if (const QCollatorSortKey *key = keys.object(string))
+        return *key;
+    QCollatorSortKey key = collator.sortKey(string);
+    keys.insert(string, new QCollatorSortKey(key));
+    return key;
+}
+
 /*!
     \class QCollatorSortKey
     \inmodule QtCore
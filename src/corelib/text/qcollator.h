@@ -84,6 +84,7 @@ public:
     { return compare(s1, s2) < 0; }
 
     QCollatorSortKey sortKey(const QString &string) const;
+    void sort(QSpan<QString> strings) const;
 
     static int defaultCompare(QStringView s1, QStringView s2);
     static QCollatorSortKey defaultSortKey(QStringView key);
@@ -13,6 +13,16 @@
 #include <unicode/ures.h>
 
 #include "qdebug.h"
+#if QT_CONFIG(thread)
+#include "qsemaphore.h"
+#include "qthread.h"
+#include "qthreadpool.h"
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -114,6 +124,122 @@ QCollatorSortKey QCollator::sortKey(const QString &string) const
     return QCollatorSortKey(new QCollatorSortKeyPrivate(QByteArray()));
 }
 
+namespace {
+// The sort keys of a run of strings, packed one after another without their
+// terminating NUL bytes, which ICU's keys never contain elsewhere
+struct PackedSortKeys
+{
+    QByteArray bytes;
+    QList<qsizetype> ends;
+
+    QByteArrayView key(qsizetype i) const
+    {
+        const qsizetype begin = i ? ends.at(i - 1) : 0;
+        return QByteArrayView(bytes).sliced(begin, ends.at(i) - begin);
+    }
+};
+}
+
+static void packSortKeys(const UCollator *collator, QSpan<const QString> strings,
+                         PackedSortKeys *keys)
+{
+    keys->ends.reserve(strings.size());
+    for (const QString &string : strings) {
+        const qsizetype offset = keys->bytes.size();
+        // truncating sizes (QTBUG-105038)
+        const int length = int(string.size());
+        int room = 16 + length + (length >> 2);
+        keys->bytes.resize(offset + room);
+        int size = ucol_getSortKey(collator, reinterpret_cast<const UChar *>(string.constData()),
+                                   length, reinterpret_cast<uint8_t *>(keys->bytes.data() + offset),
+                                   room);
+        if (size > room) {
+            room = size;
+            keys->bytes.resize(offset + room);
+            size = ucol_getSortKey(collator, reinterpret_cast<const UChar *>(string.constData()),
+                                   length,
+                                   reinterpret_cast<uint8_t *>(keys->bytes.data() + offset), room);
+        }
+        keys->bytes.resize(offset + qMax(size - 1, 0));
+        keys->ends.append(keys->bytes.size());
+    }
+}
+
+void QCollatorPrivate::sortByKeys(QSpan<QString> strings) const
+{
+    Q_ASSERT(collator);
+    // Each chunk's keys are computed with its own clone of the collator,
+    // on the thread pool when there are enough of them
+    constexpr qsizetype MinChunkSize = 4096;
+    qsizetype chunkCount = 1;
+#if QT_CONFIG(thread)
+    chunkCount = qBound(1, QThread::idealThreadCount(), int(strings.size() / MinChunkSize));
+#endif
+    const qsizetype chunkSize = (strings.size() + chunkCount - 1) / chunkCount;
+    std::vector<PackedSortKeys> chunks(chunkCount);
+    const auto chunkStrings = [&](qsizetype chunk) {
+        const qsizetype begin = chunk * chunkSize;
+        return QSpan<const QString>(strings).sliced(begin,
+                                                    qMin(chunkSize, strings.size() - begin));
+    };
+#if QT_CONFIG(thread)
+    if (chunkCount > 1) {
+        QThreadPool *pool = QThreadPool::globalInstance();
+        QSemaphore done;
+        std::vector<std::unique_ptr<QRunnable>> tasks;
+        for (qsizetype chunk = 1; chunk < chunkCount; ++chunk) {
+            tasks.emplace_back(QRunnable::create([&, chunk] {
+                UErrorCode status = U_ZERO_ERROR;
+#if U_ICU_VERSION_MAJOR_NUM >= 71
+                UCollator *clone = ucol_clone(collator, &status);
+#else
+                UCollator *clone = ucol_safeClone(collator, nullptr, nullptr, &status);
+#endif
+                if (U_SUCCESS(status)) {
+                    packSortKeys(clone, chunkStrings(chunk), &chunks[chunk]);
+                    ucol_close(clone);
+                }
+                done.release();
+            }));
+            tasks.back()->setAutoDelete(false);
+            pool->start(tasks.back().get());
+        }
+        packSortKeys(collator, chunkStrings(0), &chunks[0]);
+        // Don't wait for tasks the pool hasn't started, as it may be busy
+        // with ones that wait for us
+        for (const auto &task : tasks) {
+            if (pool->tryTake(task.get()))
+                task->run();
+        }
+        done.acquire(int(chunkCount - 1));
+    } else
+#endif
+    {
+        packSortKeys(collator, strings, &chunks[0]);
+    }
+
+    // A clone that failed leaves its chunk without keys
+    for (qsizetype chunk = 0; chunk < chunkCount; ++chunk) {
+        if (chunks[chunk].ends.size() != chunkStrings(chunk).size()) {
+            chunks[chunk] = {};
+            packSortKeys(collator, chunkStrings(chunk), &chunks[chunk]);
+        }
+    }
+
+    const auto key = [&](qsizetype i) { return chunks[i / chunkSize].key(i % chunkSize); };
+    std::vector<qsizetype> order(strings.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](qsizetype lhs, qsizetype rhs) {
+        return QtPrivate::compareMemory(key(lhs), key(rhs)) < 0;
+    });
+
+    std::vector<QString> sorted;
+    sorted.reserve(strings.size());
+    for (qsizetype i : order)
+        sorted.push_back(std::move(strings[i]));
+    std::move(sorted.begin(), sorted.end(), strings.begin());
+}
+
 int QCollatorSortKey::compare(const QCollatorSortKey &otherKey) const
 {
     return qstrcmp(d->m_key, otherKey.d->m_key);
@@ -19,6 +19,7 @@
 #include <QtCore/private/qglobal_p.h>
 #include "qcollator.h"
 #include <QList>
+#include <QtCore/qcache.h>
 #if QT_CONFIG(icu)
 #include <unicode/ucol.h>
 #elif defined(Q_OS_MACOS)
@@ -83,6 +84,9 @@ public:
     // Implemented by each back-end, in its own way:
     void init();
     void cleanup();
+#if QT_CONFIG(icu)
+    void sortByKeys(QSpan<QString> strings) const;
+#endif
 
 private:
     Q_DISABLE_COPY_MOVE(QCollatorPrivate)
@@ -105,6 +109,25 @@ private:
     Q_DISABLE_COPY_MOVE(QCollatorSortKeyPrivate)
 };
 
+// Compares strings like QString::localeAwareCompare(), keeping the sort keys
+// of the most recently used ones, for callers that compare the same strings
+// over and over, such as a sorting model.
+class Q_AUTOTEST_EXPORT QCollatorSortKeyCache
+{
+public:
+    explicit QCollatorSortKeyCache(qsizetype maxKeys = 4096) : keys(maxKeys) {}
+
+    int compare(const QString &s1, const QString &s2);
+    void clear() { keys.clear(); }
+
+private:
+    QCollatorSortKey sortKey(const QString &string);
+
+    QCollator collator;
+    int generation = -1;
+    QCache<QString, QCollatorSortKey> keys;
+};
+
 
 QT_END_NAMESPACE
 
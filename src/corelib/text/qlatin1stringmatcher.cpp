@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qlatin1stringmatcher.h"
+#include "qbytearraymatcher_p.h"
 #include <limits.h>
 
 QT_BEGIN_NAMESPACE
@@ -203,6 +204,18 @@ qsizetype QLatin1StringMatcher::indexIn_helper(String haystack, qsizetype from)
     auto end = start + haystack.size();
     auto found = begin;
     if (m_cs == Qt::CaseSensitive) {
+        if constexpr (std::is_same_v<String, QLatin1StringView>) {
+            if (m_pattern.size() >= 2) {
+                qsizetype resumeFrom;
+                const qsizetype index = QtPrivate::qFindByteArraySimd(
+                        reinterpret_cast<const uchar *>(start), haystack.size(), from,
+                        reinterpret_cast<const uchar *>(m_pattern.data()), m_pattern.size(),
+                        &resumeFrom);
+                if (index >= 0)
+                    return index;
+                begin = start + resumeFrom;
+            }
+        }
         found = m_caseSensitiveSearcher(begin, end, m_pattern.begin(), m_pattern.end()).begin;
         if (found == end)
             return -1;
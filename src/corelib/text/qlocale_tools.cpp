@@ -41,6 +41,7 @@
 QT_BEGIN_NAMESPACE
 
 using namespace QtMiscUtils;
+using namespace Qt::StringLiterals;
 
 QT_CLOCALE_HOLDER
 
@@ -86,6 +87,35 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision,
     if (form == QLocaleData::DFSignificantDigits && precision == 0)
         precision = 1; // 0 significant digits is silently converted to 1
 
+#if defined(__cpp_lib_to_chars) && !defined(QT_BOOTSTRAPPED)
+    if (precision == QLocale::FloatingPointShortest) {
+        // std::to_chars() finds the shortest digits that read back as d
+        // directly, without libdouble-conversion's bignum fallback.
+        char chars[std::numeric_limits<double>::max_digits10 + 8]; // -d.ddd...e-308
+        const auto res = std::to_chars(chars, chars + sizeof chars, d,
+                                       std::chars_format::scientific);
+        Q_ASSERT(res.ec == std::errc{});
+        const char *p = chars;
+        sign = *p == '-';
+        if (sign)
+            ++p;
+        length = 0;
+        for (; *p != 'e'; ++p) {
+            if (*p != '.' && length < bufSize)
+                buf[length++] = *p;
+        }
+        ++p; // 'e'
+        if (*p == '+')
+            ++p; // which std::from_chars() doesn't accept
+        int exponent = 0;
+        std::from_chars(p, res.ptr, exponent);
+        decpt = exponent + 1;
+        while (length > 1 && buf[length - 1] == '0') // only zero itself has any
+            --length;
+        return;
+    }
+#endif
+
 #if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED)
     // one digit before the decimal dot, counts as significant digit for DoubleToStringConverter
     if (form == QLocaleData::DFExponent && precision >= 0)
@@ -295,6 +325,20 @@ QSimpleParsedNumber<double> qt_asciiToDouble(const char *num, qsizetype numLen,
     }
 
     double d = 0.0;
+#if defined(__cpp_lib_to_chars) && !defined(QT_BOOTSTRAPPED)
+    {
+        // Fast path for plain decimal numbers. Anything std::from_chars()
+        // doesn't take, including overflow and underflow, is left to the
+        // code below, which has the final say on what we accept.
+        const char *begin = num;
+        const char *const end = num + numLen;
+        if (*begin == '+' && numLen > 1 && begin[1] != '-')
+            ++begin;
+        const auto res = std::from_chars(begin, end, d);
+        if (res.ec == std::errc{} && (res.ptr == end || strayCharMode == TrailingJunkAllowed))
+            return { d, res.ptr - num };
+    }
+#endif
     int processed;
 #if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED)
     int conv_flags = double_conversion::StringToDoubleConverter::NO_FLAGS;
@@ -649,9 +693,13 @@ static constexpr int digits(int number)
     return i;
 }
 
-// Used generically for both QString and QByteArray
-template <typename T>
-static T dtoString(double d, QLocaleData::DoubleForm form, int precision, bool uppercase)
+// Used generically for QString, QByteArray and caller-supplied buffers of
+// char16_t or char: formats d into the buffer that allocate(total) returns,
+// which must have room for total characters, and returns the number of
+// characters written.
+template <typename Char, typename Allocate>
+static qsizetype dtoChars(double d, QLocaleData::DoubleForm form, int precision, bool uppercase,
+                          Allocate allocate)
 {
     // Undocumented: aside from F.P.Shortest, precision < 0 is treated as
     // default, 6 - same as printf().
@@ -715,79 +763,73 @@ static T dtoString(double d, QLocaleData::DoubleForm form, int precision, bool u
         }
     }
 
-    constexpr bool IsQString = std::is_same_v<T, QString>;
-    using Char = std::conditional_t<IsQString, char16_t, char>;
-
-    T result;
-    result.reserve(total);
+    Char *const begin = allocate(total);
+    Char *p = begin;
+    const auto append = [&p](QLatin1StringView chars) {
+        for (char c : chars)
+            *p++ = Char(uchar(c));
+    };
+    const auto appendZeros = [&p](qsizetype count) {
+        for (; count > 0; --count)
+            *p++ = Char('0');
+    };
 
     if (negative && !qIsNull(d)) // We don't return "-0"
-        result.append(Char('-'));
+        *p++ = Char('-');
     if (!qt_is_finite(d)) {
-        result.append(view);
-        if (uppercase)
-            result = std::move(result).toUpper();
+        for (char c : view)
+            *p++ = Char(uppercase ? toAsciiUpper(c) : c);
     } else {
         switch (form) {
         case QLocaleData::DFExponent: {
-            result.append(view.first(1));
+            append(view.first(1));
             view = view.sliced(1);
             if (!view.isEmpty() || (!succinct && precision > 0)) {
-                result.append(Char('.'));
-                result.append(view);
-                if (qsizetype pad = precision - view.size(); !succinct && pad > 0) {
-                    for (int i = 0; i < pad; ++i)
-                        result.append(Char('0'));
-                }
+                *p++ = Char('.');
+                append(view);
+                if (!succinct)
+                    appendZeros(precision - view.size());
             }
             int exponent = decpt - 1;
-            result.append(Char(uppercase ? 'E' : 'e'));
-            result.append(Char(exponent < 0 ? '-' : '+'));
+            *p++ = Char(uppercase ? 'E' : 'e');
+            *p++ = Char(exponent < 0 ? '-' : '+');
             exponent = std::abs(exponent);
             Q_ASSERT(exponent <= D::max_exponent10 + D::max_digits10);
             int exponentDigits = digits(exponent);
             // C's printf guarantees a two-digit exponent, and so do we:
             if (exponentDigits == 1)
-                result.append(Char('0'));
-            result.resize(result.size() + exponentDigits);
-            auto location = reinterpret_cast<Char *>(result.end());
+                *p++ = Char('0');
+            p += exponentDigits;
+            Char *location = p;
             qulltoString_helper<Char>(exponent, 10, location);
             break;
         }
         case QLocaleData::DFDecimal:
             if (decpt < 0) {
-                if constexpr (IsQString)
-                    result.append(u"0.0");
-                else
-                    result.append("0.0");
-                while (++decpt < 0)
-                    result.append(Char('0'));
-                result.append(view);
+                append("0.0"_L1);
+                appendZeros(-1 - decpt);
+                append(view);
                 if (!succinct) {
-                    auto numDecimals = result.size() - 2 - (negative ? 1 : 0);
-                    for (qsizetype i = numDecimals; i < precision; ++i)
-                        result.append(Char('0'));
+                    auto numDecimals = (p - begin) - 2 - (negative ? 1 : 0);
+                    appendZeros(precision - numDecimals);
                 }
             } else {
                 if (decpt > view.size()) {
-                    result.append(view);
+                    append(view);
                     const int sign = negative ? 1 : 0;
-                    while (result.size() - sign < decpt)
-                        result.append(Char('0'));
+                    appendZeros(decpt - ((p - begin) - sign));
                     view = {};
                 } else if (decpt) {
-                    result.append(view.first(decpt));
+                    append(view.first(decpt));
                     view = view.sliced(decpt);
                 } else {
-                    result.append(Char('0'));
+                    *p++ = Char('0');
                 }
                 if (!view.isEmpty() || (!succinct && view.size() < precision)) {
-                    result.append(Char('.'));
-                    result.append(view);
-                    if (!succinct) {
-                        for (qsizetype i = view.size(); i < precision; ++i)
-                            result.append(Char('0'));
-                    }
+                    *p++ = Char('.');
+                    append(view);
+                    if (!succinct)
+                        appendZeros(precision - view.size());
                 }
             }
             break;
@@ -796,20 +838,66 @@ static T dtoString(double d, QLocaleData::DoubleForm form, int precision, bool u
             break;
         }
     }
-    Q_ASSERT(total >= result.size()); // No reallocations are needed
+    Q_ASSERT(total >= p - begin); // No reallocations are needed
+    return p - begin;
+}
+
+template <typename T>
+static T dtoString(double d, QLocaleData::DoubleForm form, int precision, bool uppercase)
+{
+    using Char = std::conditional_t<std::is_same_v<T, QString>, char16_t, char>;
+    T result;
+    const qsizetype length = dtoChars<Char>(d, form, precision, uppercase, [&](qsizetype total) {
+        result.resize(total);
+        return reinterpret_cast<Char *>(result.data());
+    });
+    result.truncate(length);
     return result;
 }
 
+// Returns the length written to out, or -1, writing nothing, if it doesn't fit
+template <typename Char>
+static qsizetype dtoSpan(double d, QLocaleData::DoubleForm form, int precision, bool uppercase,
+                         QSpan<Char> out)
+{
+    // The size computed up front can exceed the actual length by one, so
+    // a result that only just fits is formatted on the stack and copied
+    QVarLengthArray<Char, 64> spill;
+    const qsizetype length = dtoChars<Char>(d, form, precision, uppercase, [&](qsizetype total) {
+        if (total <= out.size())
+            return out.data();
+        spill.resize(total);
+        return spill.data();
+    });
+    if (length > out.size())
+        return -1;
+    if (!spill.isEmpty())
+        std::copy_n(spill.data(), length, out.data());
+    return length;
+}
+
 QString qdtoBasicLatin(double d, QLocaleData::DoubleForm form, int precision, bool uppercase)
 {
     return dtoString<QString>(d, form, precision, uppercase);
 }
 
+qsizetype qdtoBasicLatin(double d, QLocaleData::DoubleForm form, int precision, bool uppercase,
+                         QSpan<char16_t> out)
+{
+    return dtoSpan(d, form, precision, uppercase, out);
+}
+
 QByteArray qdtoAscii(double d, QLocaleData::DoubleForm form, int precision, bool uppercase)
 {
     return dtoString<QByteArray>(d, form, precision, uppercase);
 }
 
+qsizetype qdtoAscii(double d, QLocaleData::DoubleForm form, int precision, bool uppercase,
+                    QSpan<char> out)
+{
+    return dtoSpan(d, form, precision, uppercase, out);
+}
+
 #if defined(QT_SUPPORTS_INT128) || defined(QT_USE_MSVC_INT128)
 static inline quint64 toUInt64(qinternaluint128 v)
 {
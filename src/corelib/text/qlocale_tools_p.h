@@ -16,6 +16,7 @@
 //
 
 #include "qlocale_p.h"
+#include "qspan.h"
 #include "qstring.h"
 
 #if !defined(QT_SUPPORTS_INT128) && (defined(Q_CC_MSVC) && (_MSC_VER >= 1930) && __has_include(<__msvc_int128.hpp>))
@@ -53,8 +54,12 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision,
 [[nodiscard]] Q_CORE_EXPORT QString qdtoa(qreal d, int *decpt, int *sign);
 [[nodiscard]] QString qdtoBasicLatin(double d, QLocaleData::DoubleForm form,
                                      int precision, bool uppercase);
+[[nodiscard]] qsizetype qdtoBasicLatin(double d, QLocaleData::DoubleForm form,
+                                       int precision, bool uppercase, QSpan<char16_t> out);
 [[nodiscard]] QByteArray qdtoAscii(double d, QLocaleData::DoubleForm form,
                                    int precision, bool uppercase);
+[[nodiscard]] qsizetype qdtoAscii(double d, QLocaleData::DoubleForm form,
+                                  int precision, bool uppercase, QSpan<char> out);
 
 #if defined(QT_SUPPORTS_INT128) || defined(QT_USE_MSVC_INT128)
 [[nodiscard]] Q_CORE_EXPORT QString quint128toBasicLatin(qinternaluint128 number,
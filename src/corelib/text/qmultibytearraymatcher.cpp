@@ -0,0 +1,390 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qmultibytearraymatcher.h"
+#include "qmultimatcher_p.h"
+
+#include <QtCore/qhash.h>
+
+#include <private/qsimd_p.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+// Beyond this many entries (4 MiB), the automaton keeps the sparse trie and
+// follows failure links at match time instead of using a full table.
+static constexpr qsizetype MaxDenseTransitions = 1 << 20;
+
+void QMultiMatcherAutomaton::build(const std::vector<std::vector<qint32>> &patterns,
+                                   qint32 classes)
+{
+    classCount = classes;
+    const qsizetype patternCount = qsizetype(patterns.size());
+    lengths.assign(patternCount, 0);
+    nextSame.assign(patternCount, -1);
+    maxLength = 0;
+
+    // Build the trie; edges are looked up by (state, class)
+    const auto key = [](qint32 state, qint32 cls) {
+        return (quint64(quint32(state)) << 32) | quint32(cls);
+    };
+    QHash<quint64, qint32> edges;
+    std::vector<std::vector<std::pair<qint32, qint32>>> children(1);
+    std::vector<qint32> outputTail(1, -1);
+    output.assign(1, -1);
+    for (qsizetype i = 0; i < patternCount; ++i) {
+        const std::vector<qint32> &pattern = patterns[i];
+        lengths[i] = qsizetype(pattern.size());
+        if (pattern.empty())
+            continue; // never matches
+        maxLength = (std::max)(maxLength, lengths[i]);
+        qint32 state = 0;
+        for (qint32 cls : pattern) {
+            auto it = edges.constFind(key(state, cls));
+            if (it != edges.cend()) {
+                state = *it;
+                continue;
+            }
+            const qint32 target = qint32(output.size());
+            output.push_back(-1);
+            outputTail.push_back(-1);
+            children.emplace_back();
+            children[state].emplace_back(cls, target);
+            edges.insert(key(state, cls), target);
+            state = target;
+        }
+        if (output[state] < 0)
+            output[state] = qint32(i);
+        else
+            nextSame[outputTail[state]] = qint32(i);
+        outputTail[state] = qint32(i);
+    }
+
+    // Compute the failure and output links in breadth-first order, so that
+    // the failure target of a state is always complete before the state
+    const qint32 stateCount = qint32(output.size());
+    fail.assign(stateCount, 0);
+    outputLink.assign(stateCount, -1);
+    std::vector<qint32> order;
+    order.reserve(stateCount);
+    order.push_back(0);
+    for (size_t k = 0; k < order.size(); ++k) {
+        const qint32 state = order[k];
+        for (const auto &[cls, target] : children[state]) {
+            order.push_back(target);
+            qint32 f = 0;
+            if (state != 0) {
+                f = fail[state];
+                qint32 g;
+                while ((g = edges.value(key(f, cls), -1)) < 0 && f)
+                    f = fail[f];
+                f = g < 0 ? 0 : g;
+            }
+            fail[target] = f;
+            outputLink[target] = output[f] >= 0 ? f : outputLink[f];
+        }
+    }
+
+    delta.clear();
+    rootRow.clear();
+    edgeBegin.clear();
+    edgeClass.clear();
+    edgeTarget.clear();
+    if (qsizetype(stateCount) * classCount <= MaxDenseTransitions) {
+        delta.assign(size_t(stateCount) * size_t(classCount), 0);
+        for (qint32 state : order) {
+            qint32 *row = delta.data() + size_t(state) * size_t(classCount);
+            if (state != 0) {
+                const qint32 *failRow = delta.data() + size_t(fail[state]) * size_t(classCount);
+                std::copy(failRow, failRow + classCount, row);
+            }
+            for (const auto &[cls, target] : children[state])
+                row[cls] = target;
+        }
+    } else {
+        rootRow.assign(classCount, 0);
+        for (const auto &[cls, target] : children[0])
+            rootRow[cls] = target;
+        edgeBegin.reserve(stateCount + 1);
+        edgeClass.reserve(stateCount);
+        edgeTarget.reserve(stateCount);
+        for (auto &stateEdges : children) {
+            std::sort(stateEdges.begin(), stateEdges.end());
+            edgeBegin.push_back(qint32(edgeClass.size()));
+            for (const auto &[cls, target] : stateEdges) {
+                edgeClass.push_back(cls);
+                edgeTarget.push_back(target);
+            }
+        }
+        edgeBegin.push_back(qint32(edgeClass.size()));
+    }
+}
+
+} // namespace QtPrivate
+
+class QMultiByteArrayMatcherPrivate : public QSharedData
+{
+public:
+    QMultiByteArrayMatcherPrivate(const QList<QByteArray> &patterns, Qt::CaseSensitivity cs);
+
+    qsizetype nextCandidate(const uchar *data, qsizetype from, qsizetype size) const noexcept;
+
+    QList<QByteArray> patterns;
+    QtPrivate::QMultiMatcherAutomaton automaton;
+    Qt::CaseSensitivity cs;
+    quint16 classes[256] = {};
+    bool isStartByte[256] = {};
+    // With only a few possible first bytes, the text is scanned for them
+    // with SIMD while the automaton is in its root state
+    static constexpr int MaxStartBytes = 4;
+    int startByteCount = 0;
+    uchar startBytes[MaxStartBytes] = {};
+};
+
+QMultiByteArrayMatcherPrivate::QMultiByteArrayMatcherPrivate(const QList<QByteArray> &patterns,
+                                                             Qt::CaseSensitivity cs)
+    : patterns(patterns), cs(cs)
+{
+    uchar fold[256];
+    for (int b = 0; b < 256; ++b) {
+        const char32_t lower = QChar::toLower(char32_t(b));
+        fold[b] = cs == Qt::CaseInsensitive && lower < 256 ? uchar(lower) : uchar(b);
+    }
+
+    qint32 classCount = 1;
+    std::vector<std::vector<qint32>> sequences;
+    sequences.reserve(patterns.size());
+    for (const QByteArray &pattern : patterns) {
+        std::vector<qint32> sequence;
+        sequence.reserve(pattern.size());
+        for (char c : pattern) {
+            const uchar f = fold[uchar(c)];
+            if (!classes[f])
+                classes[f] = quint16(classCount++);
+            sequence.push_back(classes[f]);
+        }
+        sequences.push_back(std::move(sequence));
+    }
+    if (cs == Qt::CaseInsensitive) {
+        for (int b = 0; b < 256; ++b)
+            classes[b] = classes[fold[b]];
+    }
+    automaton.build(sequences, classCount);
+
+    std::vector<bool> isFirstClass(classCount, false);
+    for (const std::vector<qint32> &sequence : sequences) {
+        if (!sequence.empty())
+            isFirstClass[sequence.front()] = true;
+    }
+    int count = 0;
+    for (int b = 0; b < 256; ++b) {
+        if (!classes[b] || !isFirstClass[classes[b]])
+            continue;
+        isStartByte[b] = true;
+        if (count < MaxStartBytes)
+            startBytes[count] = uchar(b);
+        ++count;
+    }
+    startByteCount = count <= MaxStartBytes ? count : 0;
+}
+
+/*!
+    \internal
+
+    Returns the first position at or after \a from in \a data where a match
+    can start, or \a size if there is none.
+*/
+qsizetype QMultiByteArrayMatcherPrivate::nextCandidate(const uchar *data, qsizetype from,
+                                                       qsizetype size) const noexcept
+{
+    qsizetype i = from;
+#ifdef __SSE2__
+    if (startByteCount) {
+        // unused slots repeat the first byte, which does not change the result
+        const __m128i b0 = _mm_set1_epi8(char(startBytes[0]));
+        const __m128i b1 = _mm_set1_epi8(char(startBytes[startByteCount > 1 ? 1 : 0]));
+        const __m128i b2 = _mm_set1_epi8(char(startBytes[startByteCount > 2 ? 2 : 0]));
+        const __m128i b3 = _mm_set1_epi8(char(startBytes[startByteCount > 3 ? 3 : 0]));
+        for (; i + 16 <= size; i += 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            const __m128i eq = _mm_or_si128(
+                        _mm_or_si128(_mm_cmpeq_epi8(v, b0), _mm_cmpeq_epi8(v, b1)),
+                        _mm_or_si128(_mm_cmpeq_epi8(v, b2), _mm_cmpeq_epi8(v, b3)));
+            if (const uint mask = uint(_mm_movemask_epi8(eq)))
+                return i + qCountTrailingZeroBits(mask);
+        }
+    }
+#endif
+    while (i < size && !isStartByte[data[i]])
+        ++i;
+    return i;
+}
+
+/*!
+    \class QMultiByteArrayMatcher
+    \inmodule QtCore
+    \since 6.9
+    \brief The QMultiByteArrayMatcher class holds a set of byte sequences
+    that can be matched in a byte array in a single pass.
+
+    \ingroup tools
+    \ingroup shared
+    \ingroup string-processing
+
+    This class is useful when you need to find any of a large number of
+    keywords in some data. Instead of running one QByteArrayMatcher per
+    keyword, or building a QRegularExpression alternation, the patterns are
+    compiled once into an Aho-Corasick automaton that examines every byte of
+    the searched data only once, no matter how many patterns there are.
+
+    Create the QMultiByteArrayMatcher with the list of patterns you want to
+    search for. Then call indexIn() to find the leftmost occurrence of any of
+    them, or matchesIn() to find all of their occurrences. Each match reports
+    the index of the pattern in the list passed to the constructor. Empty
+    patterns never match.
+
+    With Qt::CaseInsensitive, the bytes are compared as Latin-1 characters,
+    ignoring case.
+
+    \sa QByteArrayMatcher, QMultiStringMatcher
+*/
+
+/*!
+    \class QMultiByteArrayMatcher::Match
+    \inmodule QtCore
+    \since 6.9
+    \brief Describes one occurrence of a pattern found by QMultiByteArrayMatcher.
+
+    \variable QMultiByteArrayMatcher::Match::position
+    \brief The index of the first byte of the match in the searched data.
+
+    \variable QMultiByteArrayMatcher::Match::length
+    \brief The length of the match, which is the size of the pattern.
+
+    \variable QMultiByteArrayMatcher::Match::patternIndex
+    \brief The index of the matched pattern in patterns().
+*/
+
+/*!
+    \fn QMultiByteArrayMatcher::QMultiByteArrayMatcher()
+
+    Constructs a matcher without any pattern, that won't match anything.
+*/
+
+/*!
+    Constructs a matcher that searches for all of \a patterns, with case
+    sensitivity \a cs.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QList<QByteArray> &patterns,
+                                               Qt::CaseSensitivity cs)
+    : d(new QMultiByteArrayMatcherPrivate(patterns, cs))
+{
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QMultiByteArrayMatcher &other) noexcept = default;
+
+/*!
+    \fn QMultiByteArrayMatcher::QMultiByteArrayMatcher(QMultiByteArrayMatcher &&other)
+
+    Move-constructs a matcher from \a other.
+*/
+
+/*!
+    \fn QMultiByteArrayMatcher &QMultiByteArrayMatcher::operator=(const QMultiByteArrayMatcher &other)
+
+    Assigns \a other to this matcher and returns a reference to it.
+*/
+
+/*!
+    \fn QMultiByteArrayMatcher &QMultiByteArrayMatcher::operator=(QMultiByteArrayMatcher &&other)
+
+    Move-assigns \a other to this matcher and returns a reference to it.
+*/
+
+/*!
+    Destroys the matcher.
+*/
+QMultiByteArrayMatcher::~QMultiByteArrayMatcher() = default;
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QMultiByteArrayMatcherPrivate)
+
+/*!
+    \fn void QMultiByteArrayMatcher::swap(QMultiByteArrayMatcher &other)
+    \memberswap{matcher}
+*/
+
+/*!
+    Returns the patterns this matcher searches for.
+*/
+QList<QByteArray> QMultiByteArrayMatcher::patterns() const
+{
+    return d ? d->patterns : QList<QByteArray>();
+}
+
+/*!
+    Returns the case sensitivity this matcher uses.
+*/
+Qt::CaseSensitivity QMultiByteArrayMatcher::caseSensitivity() const noexcept
+{
+    return d ? d->cs : Qt::CaseSensitive;
+}
+
+/*!
+    Searches \a data for the leftmost occurrence of any of the patterns,
+    starting at position \a from. If \a from is negative, the search starts
+    at the beginning of \a data.
+
+    Returns the position where the match starts, or -1 if there is none. If
+    \a patternIndex is not \nullptr, it is set to the index of the matched
+    pattern, or to -1 if nothing matched. If several patterns match at the
+    same position, the longest one wins; among identical patterns, the first
+    one in the list does.
+*/
+qsizetype QMultiByteArrayMatcher::indexIn(QByteArrayView data, qsizetype from,
+                                          qsizetype *patternIndex) const
+{
+    if (!d || d->automaton.maxLength == 0 || from >= data.size()) {
+        if (patternIndex)
+            *patternIndex = -1;
+        return -1;
+    }
+    const uchar *bytes = reinterpret_cast<const uchar *>(data.data());
+    const qsizetype size = data.size();
+    return d->automaton.indexIn(size, (std::max)(from, qsizetype(0)), patternIndex,
+                                [&](qsizetype i) { return d->classes[bytes[i]]; },
+                                [&](qsizetype i) { return d->nextCandidate(bytes, i, size); });
+}
+
+/*!
+    Returns all occurrences of the patterns in \a data that start at or
+    after position \a from, including overlapping ones. If \a from is
+    negative, the search starts at the beginning of \a data.
+
+    The matches are ordered by the position of their end. Matches ending at
+    the same position are ordered from the longest to the shortest.
+*/
+QList<QMultiByteArrayMatcher::Match> QMultiByteArrayMatcher::matchesIn(QByteArrayView data,
+                                                                      qsizetype from) const
+{
+    QList<Match> result;
+    if (!d || d->automaton.maxLength == 0 || from >= data.size())
+        return result;
+    const uchar *bytes = reinterpret_cast<const uchar *>(data.data());
+    const qsizetype size = data.size();
+    const auto &lengths = d->automaton.lengths;
+    d->automaton.forEachMatch(size, (std::max)(from, qsizetype(0)),
+                              [&](qsizetype i) { return d->classes[bytes[i]]; },
+                              [&](qsizetype i) { return d->nextCandidate(bytes, i, size); },
+                              [&](qsizetype end, qint32 p) {
+                                  result.append(Match{end - lengths[p], lengths[p], p});
+                              });
+    return result;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,57 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QMULTIBYTEARRAYMATCHER_H
+#define QMULTIBYTEARRAYMATCHER_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qshareddata.h>
+
+QT_BEGIN_NAMESPACE
+
+class QMultiByteArrayMatcherPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QMultiByteArrayMatcherPrivate, Q_CORE_EXPORT)
+
+class QMultiByteArrayMatcher
+{
+public:
+    struct Match
+    {
+        qsizetype position = -1;
+        qsizetype length = 0;
+        qsizetype patternIndex = -1;
+    };
+
+    QMultiByteArrayMatcher() noexcept = default;
+    Q_CORE_EXPORT explicit QMultiByteArrayMatcher(const QList<QByteArray> &patterns,
+                                                  Qt::CaseSensitivity cs = Qt::CaseSensitive);
+    Q_CORE_EXPORT QMultiByteArrayMatcher(const QMultiByteArrayMatcher &other) noexcept;
+    QMultiByteArrayMatcher(QMultiByteArrayMatcher &&other) noexcept = default;
+    QMultiByteArrayMatcher &operator=(const QMultiByteArrayMatcher &other) noexcept
+    {
+        QMultiByteArrayMatcher{other}.swap(*this);
+        return *this;
+    }
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_MOVE_AND_SWAP(QMultiByteArrayMatcher)
+    Q_CORE_EXPORT ~QMultiByteArrayMatcher();
+
+    void swap(QMultiByteArrayMatcher &other) noexcept { d.swap(other.d); }
+
+    Q_CORE_EXPORT QList<QByteArray> patterns() const;
+    Q_CORE_EXPORT Qt::CaseSensitivity caseSensitivity() const noexcept;
+
+    Q_CORE_EXPORT qsizetype indexIn(QByteArrayView data, qsizetype from = 0,
+                                    qsizetype *patternIndex = nullptr) const;
+    Q_CORE_EXPORT QList<Match> matchesIn(QByteArrayView data, qsizetype from = 0) const;
+
+private:
+    QExplicitlySharedDataPointer<QMultiByteArrayMatcherPrivate> d;
+};
+
+Q_DECLARE_SHARED(QMultiByteArrayMatcher)
+
+QT_END_NAMESPACE
+
+#endif // QMULTIBYTEARRAYMATCHER_H
@@ -0,0 +1,151 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QMULTIMATCHER_P_H
+#define QMULTIMATCHER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of internal files.  This header file may change from version to version
+// without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+// Aho-Corasick automaton shared by QMultiByteArrayMatcher and
+// QMultiStringMatcher. It does not know about code units: the patterns are
+// given as sequences of symbol classes in [1, classCount), class 0 being
+// reserved for code units that do not occur in any pattern. Mapping code
+// units to classes (and folding case) is up to the caller.
+class QMultiMatcherAutomaton
+{
+public:
+    void build(const std::vector<std::vector<qint32>> &patterns, qint32 classCount);
+
+    // the root state is always 0, and a state has matches iff hasOutput()
+    bool hasOutput(qint32 state) const noexcept
+    { return output[state] >= 0 || outputLink[state] >= 0; }
+
+    qint32 next(qint32 state, qint32 cls) const noexcept
+    {
+        if (!delta.empty())
+            return delta[size_t(state) * size_t(classCount) + size_t(cls)];
+        while (state) {
+            const qint32 *begin = edgeClass.data() + edgeBegin[state];
+            const qint32 *end = edgeClass.data() + edgeBegin[state + 1];
+            // edges are sorted by class; states rarely have more than a few
+            for (const qint32 *e = begin; e != end && *e <= cls; ++e) {
+                if (*e == cls)
+                    return edgeTarget[e - edgeClass.data()];
+            }
+            state = fail[state];
+        }
+        return rootRow[cls];
+    }
+
+    // Calls f(patternIndex) for every pattern ending in \a state, innermost
+    // (longest) first. Stops and returns false as soon as f returns false.
+    template <typename F>
+    bool forEachOutput(qint32 state, F &&f) const
+    {
+        if (output[state] < 0)
+            state = outputLink[state];
+        for (; state >= 0; state = outputLink[state]) {
+            for (qint32 p = output[state]; p >= 0; p = nextSame[p]) {
+                if (!f(p))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    // Leftmost match starting at or after \a from; ties are broken in favor
+    // of the longest pattern, then of the lowest pattern index.
+    template <typename ClassOf, typename Skip>
+    qsizetype indexIn(qsizetype size, qsizetype from, qsizetype *patternIndex,
+                      ClassOf classOf, Skip skipToCandidate) const
+    {
+        qsizetype bestStart = -1;
+        qint32 bestPattern = -1;
+        qint32 state = 0;
+        for (qsizetype i = from; i < size; ++i) {
+            if (bestStart >= 0 && i + 1 - maxLength > bestStart)
+                break;
+            if (state == 0) {
+                i = skipToCandidate(i);
+                if (i >= size)
+                    break;
+            }
+            state = next(state, classOf(i));
+            if (!hasOutput(state))
+                continue;
+            forEachOutput(state, [&](qint32 p) {
+                const qsizetype start = i + 1 - lengths[p];
+                if (bestStart < 0 || start < bestStart
+                        || (start == bestStart && lengths[p] > lengths[bestPattern])) {
+                    bestStart = start;
+                    bestPattern = p;
+                }
+                return true;
+            });
+        }
+        if (patternIndex)
+            *patternIndex = bestPattern;
+        return bestStart;
+    }
+
+    // Calls f(end, patternIndex) for every (possibly overlapping) match
+    // starting at or after \a from, where \a end is one past the last
+    // matched code unit.
+    template <typename ClassOf, typename Skip, typename F>
+    void forEachMatch(qsizetype size, qsizetype from, ClassOf classOf,
+                      Skip skipToCandidate, F &&f) const
+    {
+        qint32 state = 0;
+        for (qsizetype i = from; i < size; ++i) {
+            if (state == 0) {
+                i = skipToCandidate(i);
+                if (i >= size)
+                    break;
+            }
+            state = next(state, classOf(i));
+            if (hasOutput(state))
+                forEachOutput(state, [&](qint32 p) { f(i + 1, p); return true; });
+        }
+    }
+
+    std::vector<qsizetype> lengths;     // per pattern, in code units
+    qsizetype maxLength = 0;
+    qint32 classCount = 1;
+
+private:
+    std::vector<qint32> nextSame;       // per pattern: next identical pattern, or -1
+    std::vector<qint32> output;         // per state: first pattern ending here, or -1
+    std::vector<qint32> outputLink;     // per state: closest suffix state with output, or -1
+    std::vector<qint32> fail;           // per state
+
+    // Either a full transition table, when it is reasonably small...
+    std::vector<qint32> delta;
+    // ...or the trie edges plus failure links, with a dense row for the root
+    std::vector<qint32> rootRow;
+    std::vector<qint32> edgeBegin;      // per state, plus one past the end
+    std::vector<qint32> edgeClass;
+    std::vector<qint32> edgeTarget;
+};
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
+
+#endif // QMULTIMATCHER_P_H
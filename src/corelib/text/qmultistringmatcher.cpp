@@ -0,0 +1,229 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qmultistringmatcher.h"
+#include "qmultimatcher_p.h"
+
+#include <QtCore/qhash.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+class QMultiStringMatcherPrivate : public QSharedData
+{
+public:
+    QMultiStringMatcherPrivate(const QStringList &patterns, Qt::CaseSensitivity cs);
+
+    char16_t fold(char16_t c) const noexcept
+    { return cs == Qt::CaseInsensitive ? char16_t(QChar::toCaseFolded(char32_t(c))) : c; }
+
+    qint32 classOf(char16_t c) const
+    {
+        if (c < 256)
+            return latin1Classes[c];
+        // some characters outside Latin-1 fold into it (KELVIN SIGN to 'k')
+        const char16_t f = fold(c);
+        return f < 256 ? latin1Classes[f] : highClasses.value(f, 0);
+    }
+
+    QStringList patterns;
+    QtPrivate::QMultiMatcherAutomaton automaton;
+    Qt::CaseSensitivity cs;
+    // Latin-1 code units are looked up directly, already folded; the others
+    // are folded at match time and looked up in the hash
+    qint32 latin1Classes[256] = {};
+    QHash<char16_t, qint32> highClasses;
+};
+
+QMultiStringMatcherPrivate::QMultiStringMatcherPrivate(const QStringList &patterns,
+                                                       Qt::CaseSensitivity cs)
+    : patterns(patterns), cs(cs)
+{
+    qint32 classCount = 1;
+    QHash<char16_t, qint32> classes;
+    std::vector<std::vector<qint32>> sequences;
+    sequences.reserve(patterns.size());
+    for (const QString &pattern : patterns) {
+        std::vector<qint32> sequence;
+        sequence.reserve(pattern.size());
+        for (QChar c : pattern) {
+            qint32 &cls = classes[fold(c.unicode())];
+            if (!cls)
+                cls = classCount++;
+            sequence.push_back(cls);
+        }
+        sequences.push_back(std::move(sequence));
+    }
+    automaton.build(sequences, classCount);
+
+    for (char16_t c = 0; c < 256; ++c)
+        latin1Classes[c] = classes.value(fold(c), 0);
+    for (auto it = classes.cbegin(); it != classes.cend(); ++it) {
+        if (it.key() >= 256)
+            highClasses.insert(it.key(), it.value());
+    }
+}
+
+/*!
+    \class QMultiStringMatcher
+    \inmodule QtCore
+    \since 6.9
+    \brief The QMultiStringMatcher class holds a set of strings that can be
+    matched in a Unicode string in a single pass.
+
+    \ingroup tools
+    \ingroup shared
+    \ingroup string-processing
+
+    This class is the UTF-16 counterpart of QMultiByteArrayMatcher: the
+    patterns are compiled once into an Aho-Corasick automaton, which then
+    finds occurrences of any of them while examining every character of the
+    searched string only once.
+
+    Create the QMultiStringMatcher with the list of patterns you want to
+    search for. Then call indexIn() to find the leftmost occurrence of any of
+    them, or matchesIn() to find all of their occurrences. Each match reports
+    the index of the pattern in the list passed to the constructor. Empty
+    patterns never match.
+
+    With Qt::CaseInsensitive, each UTF-16 code unit is case-folded on its
+    own, so characters outside the Basic Multilingual Plane are always
+    compared case-sensitively.
+
+    \sa QStringMatcher, QMultiByteArrayMatcher
+*/
+
+/*!
+    \class QMultiStringMatcher::Match
+    \inmodule QtCore
+    \since 6.9
+    \brief Describes one occurrence of a pattern found by QMultiStringMatcher.
+
+    \variable QMultiStringMatcher::Match::position
+    \brief The index of the first character of the match in the searched string.
+
+    \variable QMultiStringMatcher::Match::length
+    \brief The length of the match, which is the size of the pattern.
+
+    \variable QMultiStringMatcher::Match::patternIndex
+    \brief The index of the matched pattern in patterns().
+*/
+
+/*!
+    \fn QMultiStringMatcher::QMultiStringMatcher()
+
+    Constructs a matcher without any pattern, that won't match anything.
+*/
+
+/*!
+    Constructs a matcher that searches for all of \a patterns, with case
+    sensitivity \a cs.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QStringList &patterns, Qt::CaseSensitivity cs)
+    : d(new QMultiStringMatcherPrivate(patterns, cs))
+{
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QMultiStringMatcher &other) noexcept = default;
+
+/*!
+    \fn QMultiStringMatcher::QMultiStringMatcher(QMultiStringMatcher &&other)
+
+    Move-constructs a matcher from \a other.
+*/
+
+/*!
+    \fn QMultiStringMatcher &QMultiStringMatcher::operator=(const QMultiStringMatcher &other)
+
+    Assigns \a other to this matcher and returns a reference to it.
+*/
+
+/*!
+    \fn QMultiStringMatcher &QMultiStringMatcher::operator=(QMultiStringMatcher &&other)
+
+    Move-assigns \a other to this matcher and returns a reference to it.
+*/
+
+/*!
+    Destroys the matcher.
+*/
+QMultiStringMatcher::~QMultiStringMatcher() = default;
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QMultiStringMatcherPrivate)
+
+/*!
+    \fn void QMultiStringMatcher::swap(QMultiStringMatcher &other)
+    \memberswap{matcher}
+*/
+
+/*!
+    Returns the patterns this matcher searches for.
+*/
+QStringList QMultiStringMatcher::patterns() const
+{
+    return d ? d->patterns : QStringList();
+}
+
+/*!
+    Returns the case sensitivity this matcher uses.
+*/
+Qt::CaseSensitivity QMultiStringMatcher::caseSensitivity() const noexcept
+{
+    return d ? d->cs : Qt::CaseSensitive;
+}
+
+/*!
+    Searches \a str for the leftmost occurrence of any of the patterns,
+    starting at position \a from. If \a from is negative, the search starts
+    at the beginning of \a str.
+
+    Returns the position where the match starts, or -1 if there is none. If
+    \a patternIndex is not \nullptr, it is set to the index of the matched
+    pattern, or to -1 if nothing matched. If several patterns match at the
+    same position, the longest one wins; among identical patterns, the first
+    one in the list does.
+*/
+qsizetype QMultiStringMatcher::indexIn(QStringView str, qsizetype from,
+                                       qsizetype *patternIndex) const
+{
+    if (!d || d->automaton.maxLength == 0 || from >= str.size()) {
+        if (patternIndex)
+            *patternIndex = -1;
+        return -1;
+    }
+    const char16_t *text = str.utf16();
+    return d->automaton.indexIn(str.size(), (std::max)(from, qsizetype(0)), patternIndex,
+                                [&](qsizetype i) { return d->classOf(text[i]); },
+                                [](qsizetype i) { return i; });
+}
+
+/*!
+    Returns all occurrences of the patterns in \a str that start at or
+    after position \a from, including overlapping ones. If \a from is
+    negative, the search starts at the beginning of \a str.
+
+    The matches are ordered by the position of their end. Matches ending at
+    the same position are ordered from the longest to the shortest.
+*/
+QList<QMultiStringMatcher::Match> QMultiStringMatcher::matchesIn(QStringView str,
+                                                                qsizetype from) const
+{
+    QList<Match> result;
+    if (!d || d->automaton.maxLength == 0 || from >= str.size())
+        return result;
+    const char16_t *text = str.utf16();
+    const auto &lengths = d->automaton.lengths;
+    d->automaton.forEachMatch(str.size(), (std::max)(from, qsizetype(0)),
+                              [&](qsizetype i) { return d->classOf(text[i]); },
+                              [](qsizetype i) { return i; },
+                              [&](qsizetype end, qint32 p) {
+                                  result.append(Match{end - lengths[p], lengths[p], p});
+                              });
+    return result;
+}
+
+QT_END_NAMESPACE
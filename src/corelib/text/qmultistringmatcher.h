@@ -0,0 +1,58 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QMULTISTRINGMATCHER_H
+#define QMULTISTRINGMATCHER_H
+
+#include <QtCore/qlist.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qstringview.h>
+
+QT_BEGIN_NAMESPACE
+
+class QMultiStringMatcherPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QMultiStringMatcherPrivate, Q_CORE_EXPORT)
+
+class QMultiStringMatcher
+{
+public:
+    struct Match
+    {
+        qsizetype position = -1;
+        qsizetype length = 0;
+        qsizetype patternIndex = -1;
+    };
+
+    QMultiStringMatcher() noexcept = default;
+    Q_CORE_EXPORT explicit QMultiStringMatcher(const QStringList &patterns,
+                                               Qt::CaseSensitivity cs = Qt::CaseSensitive);
+    Q_CORE_EXPORT QMultiStringMatcher(const QMultiStringMatcher &other) noexcept;
+    QMultiStringMatcher(QMultiStringMatcher &&other) noexcept = default;
+    QMultiStringMatcher &operator=(const QMultiStringMatcher &other) noexcept
+    {
+        QMultiStringMatcher{other}.swap(*this);
+        return *this;
+    }
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_MOVE_AND_SWAP(QMultiStringMatcher)
+    Q_CORE_EXPORT ~QMultiStringMatcher();
+
+    void swap(QMultiStringMatcher &other) noexcept { d.swap(other.d); }
+
+    Q_CORE_EXPORT QStringList patterns() const;
+    Q_CORE_EXPORT Qt::CaseSensitivity caseSensitivity() const noexcept;
+
+    Q_CORE_EXPORT qsizetype indexIn(QStringView str, qsizetype from = 0,
+                                    qsizetype *patternIndex = nullptr) const;
+    Q_CORE_EXPORT QList<Match> matchesIn(QStringView str, qsizetype from = 0) const;
+
+private:
+    QExplicitlySharedDataPointer<QMultiStringMatcherPrivate> d;
+};
+
+Q_DECLARE_SHARED(QMultiStringMatcher)
+
+QT_END_NAMESPACE
+
+#endif // QMULTISTRINGMATCHER_H
@@ -5991,6 +5991,9 @@ QString QString::fromLocal8Bit(QByteArrayView ba)
     unterminated characters at the end of the string will be replaced or
     suppressed. In order to do stateful decoding, please use \l QStringDecoder.
 
+    Large strings may be decoded using idle threads of the global
+    QThreadPool as well; see QStringDecoder for details.
+
     \sa toUtf8(), fromLatin1(), fromLocal8Bit()
 */
 
@@ -8159,6 +8162,23 @@ QString QString::number(qulonglong n, int base)
 }
 
 
+static QLocaleData::DoubleForm doubleFormForNumber(char format)
+{
+    switch (QtMiscUtils::toAsciiLower(format)) {
+        case 'f':
+            return QLocaleData::DFDecimal;
+        case 'e':
+            return QLocaleData::DFExponent;
+        case 'g':
+            return QLocaleData::DFSignificantDigits;
+        default:
+#if defined(QT_CHECK_RANGE)
+            qWarning("QString::setNum: Invalid format char '%c'", format);
+#endif
+            return QLocaleData::DFDecimal;
+    }
+}
+
 /*!
     Returns a string representing the floating-point number \a n.
 
@@ -8172,26 +8192,26 @@ QString QString::number(qulonglong n, int base)
 */
 QString QString::number(double n, char format, int precision)
 {
-    QLocaleData::DoubleForm form = QLocaleData::DFDecimal;
+    return qdtoBasicLatin(n, doubleFormForNumber(format), precision, isAsciiUpper(format));
+}
 
-    switch (QtMiscUtils::toAsciiLower(format)) {
-        case 'f':
-            form = QLocaleData::DFDecimal;
-            break;
-        case 'e':
-            form = QLocaleData::DFExponent;
-            break;
-        case 'g':
-            form = QLocaleData::DFSignificantDigits;
-            break;
-        default:
-#if defined(QT_CHECK_RANGE)
-            qWarning("QString::setNum: Invalid format char '%c'", format);
-#endif
-            break;
-    }
+/*!
+    \since 6.10
+    \overload
 
-    return qdtoBasicLatin(n, form, precision, isAsciiUpper(format));
+    Writes the text that number(\a n, \a format, \a precision) returns to
+    \a buffer, without allocating memory, and returns its length. If it
+    doesn't fit in \a buffer, returns -1 and leaves \a buffer unspecified.
+
+    With QLocale::FloatingPointShortest as \a precision, 25 characters are
+    always enough for the \c{'e'} and \c{'g'} formats.
+
+    \sa QByteArray::number()
+*/
+qsizetype QString::number(double n, QSpan<char16_t> buffer, char format, int precision)
+{
+    return qdtoBasicLatin(n, doubleFormForNumber(format), precision, isAsciiUpper(format),
+                          buffer);
 }
 
 namespace {
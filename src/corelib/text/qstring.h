@@ -18,6 +18,7 @@
 #include <QtCore/qarraydata.h>
 #include <QtCore/qlatin1stringview.h>
 #include <QtCore/qnamespace.h>
+#include <QtCore/qspan.h>
 #include <QtCore/qstringliteral.h>
 #include <QtCore/qstringalgorithms.h>
 #include <QtCore/qanystringview.h>
@@ -769,6 +770,7 @@ public:
     static QString number(qlonglong, int base=10);
     static QString number(qulonglong, int base=10);
     static QString number(double, char format='g', int precision=6);
+    static qsizetype number(double, QSpan<char16_t> buffer, char format='g', int precision=6);
 
     friend bool comparesEqual(const QString &s1, const QString &s2) noexcept
     { return comparesEqual(QStringView(s1), QStringView(s2)); }
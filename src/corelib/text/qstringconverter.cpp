@@ -29,6 +29,13 @@
 #endif // !QT_BOOTSTRAPPED
 #endif
 
+#if QT_CONFIG(thread) && !defined(QT_BOOTSTRAPPED)
+#include <QtCore/qatomic.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qvarlengtharray.h>
+#endif
+
 #include <array>
 
 #if __has_include(<bit>) && __cplusplus > 201703L
@@ -131,6 +138,29 @@ static inline bool simdEncodeAscii(uchar *&dst, const char16_t *&nextAscii, cons
 
 static inline bool simdDecodeAscii(char16_t *&dst, const uchar *&nextAscii, const uchar *&src, const uchar *end)
 {
+#ifdef __AVX512BW__
+    // do thirty-two characters at a time
+    for ( ; end - src >= 32; src += 32, dst += 32) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+        uint n = _mm256_movemask_epi8(data);
+        if (!n) {
+            // zero extend to a ZMM register and store
+            _mm512_storeu_si512(dst, _mm512_cvtepu8_epi16(data));
+            continue;
+        }
+
+        // copy the front part that is still ASCII
+        while (!(n & 1)) {
+            *dst++ = *src++;
+            n >>= 1;
+        }
+
+        n = qBitScanReverse(n);
+        nextAscii = src + n + 1;
+        return false;
+    }
+#endif
+
     // do sixteen characters at a time
     for ( ; end - src >= 16; src += 16, dst += 16) {
         __m128i data = _mm_loadu_si128((const __m128i*)src);
@@ -198,6 +228,18 @@ static inline bool simdDecodeAscii(char16_t *&dst, const uchar *&nextAscii, cons
 
 static inline const uchar *simdFindNonAscii(const uchar *src, const uchar *end, const uchar *&nextAscii)
 {
+#ifdef __AVX512BW__
+    // do 64 characters at a time
+    for ( ; end - src >= 64; src += 64) {
+        __m512i data = _mm512_loadu_si512(src);
+        quint64 n = _mm512_movepi8_mask(data);
+        if (!n)
+            continue;
+
+        nextAscii = src + (63 - qCountLeadingZeroBits(n)) + 1;
+        return src + qCountTrailingZeroBits(n);
+    }
+#endif
 #ifdef __AVX2__
     // do 32 characters at a time
     // (this is similar to simdTestMask in qstring.cpp)
@@ -593,6 +635,176 @@ char *QUtf8::convertFromLatin1(char *out, QLatin1StringView in)
     return out;
 }
 
+#if QT_CONFIG(thread) && !defined(QT_BOOTSTRAPPED)
+// Inputs at least this large are decoded on several threads, unless
+// QT_UTF8_PARALLEL_DECODE_THRESHOLD says otherwise
+static constexpr qsizetype Utf8ParallelDecodeDefaultThreshold = 8 * 1024 * 1024;
+static constexpr qsizetype Utf8ParallelDecodeMinSegment = 2 * 1024 * 1024;
+static constexpr qsizetype Utf8ParallelDecodeMaxSegments = 32;
+// How far from the nominal split point we look for a segment boundary
+static constexpr qsizetype Utf8SegmentBoundaryWindow = 4096;
+
+// Returns the size from which UTF-8 input is decoded on several threads.
+// QT_UTF8_PARALLEL_DECODE_THRESHOLD=0 disables it.
+static qsizetype utf8ParallelDecodeThreshold() noexcept
+{
+    static const qsizetype threshold = [] {
+        bool ok = false;
+        const int value = qEnvironmentVariableIntValue("QT_UTF8_PARALLEL_DECODE_THRESHOLD", &ok);
+        if (!ok)
+            return Utf8ParallelDecodeDefaultThreshold;
+        if (value <= 0)
+            return (std::numeric_limits<qsizetype>::max)();
+        return (std::max)(qsizetype(value), 2 * Utf8ParallelDecodeMinSegment);
+    }();
+    return threshold;
+}
+
+// Returns true if the sequential decoder is guaranteed to start a new
+// sequence at \a p, that is, if the bytes before it end a sequence that is
+// decoded on its own and successfully. Splitting there produces exactly
+// the same output as decoding in one go, even in the presence of errors.
+static bool isUtf8SegmentBoundary(const uchar *begin, const uchar *p) noexcept
+{
+    Q_ASSERT(p > begin);
+    if (p[-1] < 0x80)
+        return true; // US-ASCII is never part of another sequence
+    if (!QUtf8Functions::isContinuationByte(p[-1]))
+        return false;
+    for (qsizetype k = 2; k <= 4 && p - k >= begin; ++k) {
+        const uchar *src = p - k;
+        if (QUtf8Functions::isContinuationByte(*src))
+            continue;
+        char16_t buffer[2];
+        char16_t *out = buffer;
+        const uchar b = *src++;
+        return QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, out, src, p) == k;
+    }
+    return false;
+}
+
+static char16_t *decodeUtf8Segment(char16_t *dst, const uchar *src, const uchar *end,
+                                   char16_t replacement, qsizetype *invalidChars) noexcept
+{
+    const uchar *nextAscii = src;
+    while (src < end) {
+        if (src >= nextAscii && simdDecodeAscii(dst, nextAscii, src, end))
+            break;
+
+        const uchar ch = *src++;
+        if (QUtf8Functions::fromUtf8<QUtf8BaseTraits>(ch, dst, src, end) < 0) {
+            ++*invalidChars;
+            *dst++ = replacement;
+        }
+    }
+    return dst;
+}
+
+/*!
+    \internal
+
+    Decodes the bulk of the large UTF-8 buffer [\a src, \a end) on the global
+    thread pool, writing to \a dst, which must have room for \c{end - src}
+    characters, and advancing it. The calling thread decodes segments too,
+    so this makes progress even when no pool thread is available.
+
+    The input is split at sequence boundaries only, so the result is exactly
+    what sequential decoding would produce. Returns the position where
+    decoding stopped, before the end of the input if the last sequences
+    could not be proven complete; the caller decodes the rest as usual.
+
+    This function never throws: if a task cannot be allocated, the calling
+    thread decodes the segments that are left.
+*/
+static const uchar *decodeUtf8InParallel(char16_t *&dst, const uchar *src, const uchar *end,
+                                         char16_t replacement, qsizetype *invalidChars) noexcept
+{
+    QThreadPool *pool = QThreadPool::globalInstance();
+    if (!pool)
+        return src;
+    const qsizetype maxSegments = (std::min)({ qsizetype(pool->maxThreadCount()),
+                                               (end - src) / Utf8ParallelDecodeMinSegment,
+                                               Utf8ParallelDecodeMaxSegments });
+    if (maxSegments < 2)
+        return src;
+
+    struct Segment {
+        const uchar *src;
+        const uchar *end;
+        char16_t *dst;
+        char16_t *dstEnd;
+        qsizetype invalidChars;
+    };
+    // never allocates, as there are at most Utf8ParallelDecodeMaxSegments
+    QVarLengthArray<Segment, Utf8ParallelDecodeMaxSegments> segments;
+    const auto addSegmentUpTo = [&](const uchar *boundary) {
+        const uchar *segmentSrc = segments.isEmpty() ? src : segments.last().end;
+        segments.append(Segment{ segmentSrc, boundary, dst + (segmentSrc - src), nullptr, 0 });
+    };
+    for (qsizetype i = 1; i < maxSegments; ++i) {
+        const uchar *p = src + (end - src) * i / maxSegments;
+        const uchar *limit = p + Utf8SegmentBoundaryWindow;
+        while (p < limit && !isUtf8SegmentBoundary(src, p))
+            ++p;
+        if (p < limit)
+            addSegmentUpTo(p);
+    }
+    // the input may end in the middle of a sequence, which is for the caller
+    // to handle according to its state
+    const uchar *last = end;
+    const uchar *lastLimit = end - Utf8SegmentBoundaryWindow;
+    while (last > lastLimit && !isUtf8SegmentBoundary(src, last))
+        --last;
+    if (last > lastLimit && (segments.isEmpty() || last > segments.last().end))
+        addSegmentUpTo(last);
+    if (segments.size() < 2)
+        return src;
+
+    QAtomicInteger<qsizetype> nextSegment = 0;
+    const auto decodeSegments = [&segments, &nextSegment, replacement] {
+        qsizetype i;
+        while ((i = nextSegment.fetchAndAddRelaxed(1)) < segments.size()) {
+            Segment &s = segments[i];
+            s.dstEnd = decodeUtf8Segment(s.dst, s.src, s.end, replacement, &s.invalidChars);
+        }
+    };
+
+    QT_TRY {
+        QSemaphore helpersDone;
+        int helpers = 0;
+        QT_TRY {
+            while (helpers < segments.size() - 1
+                   && pool->tryStart([&decodeSegments, &helpersDone] {
+                       decodeSegments();
+                       helpersDone.release();
+                   })) {
+                ++helpers;
+            }
+        } QT_CATCH(...) {
+            // out of memory for the task: the helpers started so far, if
+            // any, and this thread decode everything
+        }
+        decodeSegments();
+        helpersDone.acquire(helpers);
+    } QT_CATCH(...) {
+        decodeSegments();
+    }
+
+    // Each segment was decoded at its offset in the input, which is at or
+    // after its final position; close the gaps
+    char16_t *out = segments.first().dstEnd;
+    *invalidChars += segments.first().invalidChars;
+    for (qsizetype i = 1; i < segments.size(); ++i) {
+        const Segment &s = segments.at(i);
+        memmove(out, s.dst, (s.dstEnd - s.dst) * sizeof(char16_t));
+        out += s.dstEnd - s.dst;
+        *invalidChars += s.invalidChars;
+    }
+    dst = out;
+    return segments.last().end;
+}
+#endif // QT_CONFIG(thread) && !QT_BOOTSTRAPPED
+
 QString QUtf8::convertToUnicode(QByteArrayView in)
 {
     // UTF-8 to UTF-16 always needs the exact same number of words or less:
@@ -639,6 +851,15 @@ char16_t *QUtf8::convertToUnicode(char16_t *dst, QByteArrayView in) noexcept
     const uchar *src = start;
     const uchar *end = src + in.size();
 
+#if QT_CONFIG(thread) && !defined(QT_BOOTSTRAPPED)
+    if (Q_UNLIKELY(end - src >= utf8ParallelDecodeThreshold())) {
+        if (src[0] == utf8bom[0] && src[1] == utf8bom[1] && src[2] == utf8bom[2])
+            src += 3;
+        qsizetype invalidChars = 0;
+        src = decodeUtf8InParallel(dst, src, end, QChar::ReplacementCharacter, &invalidChars);
+    }
+#endif
+
     // attempt to do a full decoding in SIMD
     const uchar *nextAscii = end;
     if (!simdDecodeAscii(dst, nextAscii, src, end)) {
@@ -751,6 +972,11 @@ char16_t *QUtf8::convertToUnicode(char16_t *dst, QByteArrayView in, QStringConve
             src += 3;
     }
 
+#if QT_CONFIG(thread) && !defined(QT_BOOTSTRAPPED)
+    if (Q_UNLIKELY(end - src >= utf8ParallelDecodeThreshold()))
+        src = decodeUtf8InParallel(dst, src, end, replacement, &state->invalidChars);
+#endif
+
     // main body, stateless decoding
     res = 0;
     const uchar *nextAscii = src;
@@ -2592,6 +2818,13 @@ const char *QStringConverter::nameForEncoding(QStringConverter::Encoding e)
     works correctly even if chunks are split in the middle of a multi-byte character
     sequence.
 
+    Since Qt 6.9, large chunks of UTF-8 (8 MiB or more) are decoded using the
+    idle threads of the \l{QThreadPool::globalInstance()}{global thread pool},
+    if any, in addition to the calling thread. The result is the same as when
+    decoding on a single thread. The size from which this happens can be
+    changed by setting the \c QT_UTF8_PARALLEL_DECODE_THRESHOLD environment
+    variable to a number of bytes; setting it to 0 disables it.
+
     QStringDecoder objects can't be copied because of their internal state, but
     can be moved.
 
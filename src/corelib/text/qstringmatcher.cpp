@@ -4,6 +4,8 @@
 
 #include "qstringmatcher.h"
 
+#include <private/qsimd_p.h>
+
 QT_BEGIN_NAMESPACE
 
 static constexpr qsizetype FoldBufferCapacity = 256;
@@ -30,6 +32,113 @@ static void bm_init_skiptable(QStringView needle, uchar *skiptable, Qt::CaseSens
     }
 }
 
+/*
+    UTF-16 counterpart of the SIMD search in qbytearraymatcher.cpp (see
+    there): compares a block of candidate positions against the first and
+    the last character of the needle at once. Each character yields two
+    bits of the x86 masks and eight bits of the NEON one.
+*/
+#if defined(__SSE2__)
+static qsizetype simd_find_sse2(const char16_t *uc, qsizetype l, qsizetype from,
+                                const char16_t *puc, qsizetype pl, qsizetype *resumeFrom) noexcept
+{
+    constexpr qsizetype Step = sizeof(__m128i) / sizeof(char16_t);
+    const __m128i first = _mm_set1_epi16(short(puc[0]));
+    const __m128i last = _mm_set1_epi16(short(puc[pl - 1]));
+    qsizetype i = from;
+    for ( ; i + pl - 1 + Step <= l; i += Step) {
+        const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i *>(uc + i));
+        const __m128i blockLast =
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(uc + i + pl - 1));
+        uint mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi16(first, blockFirst),
+                                                    _mm_cmpeq_epi16(last, blockLast)));
+        while (mask) {
+            const uint idx = qCountTrailingZeroBits(mask) / 2;
+            if (memcmp(uc + i + idx + 1, puc + 1, (pl - 2) * sizeof(char16_t)) == 0)
+                return i + idx;
+            mask &= ~(3u << (idx * 2));
+        }
+    }
+    *resumeFrom = i;
+    return -1;
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+static QT_FUNCTION_TARGET(ARCH_HASWELL)
+qsizetype simd_find_avx2(const char16_t *uc, qsizetype l, qsizetype from,
+                         const char16_t *puc, qsizetype pl, qsizetype *resumeFrom) noexcept
+{
+    constexpr qsizetype Step = sizeof(__m256i) / sizeof(char16_t);
+    const __m256i first = _mm256_set1_epi16(short(puc[0]));
+    const __m256i last = _mm256_set1_epi16(short(puc[pl - 1]));
+    qsizetype i = from;
+    for ( ; i + pl - 1 + Step <= l; i += Step) {
+        const __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(uc + i));
+        const __m256i blockLast =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i *>(uc + i + pl - 1));
+        uint mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi16(first, blockFirst),
+                                                          _mm256_cmpeq_epi16(last, blockLast)));
+        while (mask) {
+            const uint idx = qCountTrailingZeroBits(mask) / 2;
+            if (memcmp(uc + i + idx + 1, puc + 1, (pl - 2) * sizeof(char16_t)) == 0)
+                return i + idx;
+            mask &= ~(3u << (idx * 2));
+        }
+    }
+    *resumeFrom = i;
+    return -1;
+}
+#endif
+
+#if defined(__ARM_NEON__)
+static qsizetype simd_find_neon(const char16_t *uc, qsizetype l, qsizetype from,
+                                const char16_t *puc, qsizetype pl, qsizetype *resumeFrom) noexcept
+{
+    constexpr qsizetype Step = sizeof(uint16x8_t) / sizeof(char16_t);
+    const uint16x8_t first = vdupq_n_u16(puc[0]);
+    const uint16x8_t last = vdupq_n_u16(puc[pl - 1]);
+    const auto data = [uc](qsizetype pos) {
+        return vld1q_u16(reinterpret_cast<const uint16_t *>(uc + pos));
+    };
+    qsizetype i = from;
+    for ( ; i + pl - 1 + Step <= l; i += Step) {
+        const uint16x8_t match = vandq_u16(vceqq_u16(first, data(i)),
+                                           vceqq_u16(last, data(i + pl - 1)));
+        quint64 mask = vget_lane_u64(vreinterpret_u64_u8(vmovn_u16(match)), 0);
+        while (mask) {
+            const uint idx = qCountTrailingZeroBits(mask) / 8;
+            if (memcmp(uc + i + idx + 1, puc + 1, (pl - 2) * sizeof(char16_t)) == 0)
+                return i + idx;
+            mask &= ~(Q_UINT64_C(0xff) << (idx * 8));
+        }
+    }
+    *resumeFrom = i;
+    return -1;
+}
+#endif
+
+static qsizetype simd_find(const char16_t *uc, qsizetype l, qsizetype from,
+                           const char16_t *puc, qsizetype pl, qsizetype *resumeFrom) noexcept
+{
+    Q_ASSERT(pl >= 2);
+    *resumeFrom = from;
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(ArchHaswell))
+        return simd_find_avx2(uc, l, from, puc, pl, resumeFrom);
+#endif
+#if defined(__SSE2__)
+    return simd_find_sse2(uc, l, from, puc, pl, resumeFrom);
+#elif defined(__ARM_NEON__)
+    return simd_find_neon(uc, l, from, puc, pl, resumeFrom);
+#else
+    Q_UNUSED(uc);
+    Q_UNUSED(l);
+    Q_UNUSED(puc);
+    return -1;
+#endif
+}
+
 static inline qsizetype bm_find(QStringView haystack, qsizetype index, QStringView needle,
                           const uchar *skiptable, Qt::CaseSensitivity cs)
 {
@@ -42,6 +151,12 @@ static inline qsizetype bm_find(QStringView haystack, qsizetype index, QStringVi
         return index > l ? -1 : index;
 
     if (cs == Qt::CaseSensitive) {
+        if (pl >= 2) {
+            const qsizetype found = simd_find(uc, l, index, puc, pl, &index);
+            if (found >= 0)
+                return found;
+        }
+
         const qsizetype pl_minus_one = pl - 1;
         const char16_t *current = uc + index + pl_minus_one;
         const char16_t *end = uc + l;
@@ -0,0 +1,257 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QCOROTASK_H
+#define QCOROTASK_H
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qfuture.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qpromise.h>
+
+QT_REQUIRE_CONFIG(future);
+
+#if (defined(__cpp_impl_coroutine) && __has_include(<coroutine>)) || defined(Q_QDOC)
+
+#include <coroutine>
+#include <optional>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+template<typename T>
+class QCoroTask;
+
+namespace QtPrivate {
+
+// Owns a suspended coroutine until it is resumed; continuations that are
+// dropped without being called destroy it instead of leaking the frame.
+class CoroutineResumer
+{
+public:
+    explicit CoroutineResumer(std::coroutine_handle<> handle) noexcept : handle(handle) {}
+    CoroutineResumer(CoroutineResumer &&other) noexcept
+        : handle(std::exchange(other.handle, {}))
+    {}
+    CoroutineResumer &operator=(CoroutineResumer &&) = delete;
+    ~CoroutineResumer()
+    {
+        if (handle)
+            handle.destroy();
+    }
+
+    void resume() { std::exchange(handle, {}).resume(); }
+
+    // A canceled future has no result to resume with, so the awaiting
+    // coroutine is destroyed, which cancels it if it is a QCoroTask
+    void resumeOrDestroy(const QFutureInterfaceBase &awaited)
+    {
+        if (awaited.isCanceled() && !awaited.hasException())
+            std::exchange(handle, {}).destroy();
+        else
+            resume();
+    }
+
+private:
+    std::coroutine_handle<> handle;
+};
+
+template<class T>
+class FutureAwaiter
+{
+public:
+    explicit FutureAwaiter(const QFuture<T> &future, QObject *context = nullptr)
+        : future(future), context(context)
+    {}
+
+    bool await_ready() const { return future.isFinished() && !future.isCanceled(); }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        // The continuation may resume or destroy the coroutine right away,
+        // so neither this awaiter nor its future may be accessed after
+        // attaching it
+        auto awaited = future.d;
+        if (context) {
+            QtPrivate::watchContinuation(context,
+                                         [resumer = CoroutineResumer(handle),
+                                          awaited]() mutable {
+                                             resumer.resumeOrDestroy(awaited);
+                                         },
+                                         awaited);
+        } else {
+            awaited.setContinuation(
+                    ContinuationFunction([resumer = CoroutineResumer(handle)](
+                                                 const QFutureInterfaceBase &parent) mutable {
+                        resumer.resumeOrDestroy(parent);
+                    }),
+                    nullptr);
+        }
+    }
+
+    T await_resume()
+    {
+        if constexpr (std::is_void_v<T>)
+            future.waitForFinished();
+        else if constexpr (std::is_copy_constructible_v<T>)
+            return future.result();
+        else
+            return future.takeResult();
+    }
+
+private:
+    QFuture<T> future;
+    QObject *context;
+};
+
+template<class Sender, class Signal>
+class SignalAwaiter
+{
+    using ArgsType = QtFuture::ArgsType<Signal>;
+    using Storage = std::conditional_t<std::is_void_v<ArgsType>, bool, ArgsType>;
+
+public:
+    SignalAwaiter(Sender *sender, Signal signal) : sender(sender), signal(signal) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        // As for FutureAwaiter, the coroutine may be gone once connect()
+        // returns: if the sender is null, the connection fails and the
+        // functor, together with the coroutine, is destroyed
+        if constexpr (std::is_void_v<ArgsType>) {
+            QObject::connect(sender, signal, sender,
+                             [resumer = CoroutineResumer(handle)]() mutable {
+                                 resumer.resume();
+                             },
+                             Qt::SingleShotConnection);
+        } else if constexpr (QtPrivate::ArgResolver<Signal>::HasExtraArgs) {
+            QObject::connect(sender, signal, sender,
+                             [this, resumer = CoroutineResumer(handle)](auto... values) mutable {
+                                 result.emplace(QtPrivate::createTuple(std::move(values)...));
+                                 resumer.resume();
+                             },
+                             Qt::SingleShotConnection);
+        } else {
+            QObject::connect(sender, signal, sender,
+                             [this, resumer = CoroutineResumer(handle)](ArgsType value) mutable {
+                                 result.emplace(std::move(value));
+                                 resumer.resume();
+                             },
+                             Qt::SingleShotConnection);
+        }
+    }
+
+    ArgsType await_resume()
+    {
+        if constexpr (!std::is_void_v<ArgsType>)
+            return std::move(*result);
+    }
+
+private:
+    Sender *sender;
+    Signal signal;
+    std::optional<Storage> result;
+};
+
+template<class T>
+class CoroTaskPromiseBase
+{
+public:
+    CoroTaskPromiseBase() { promise.start(); }
+
+    QCoroTask<T> get_return_object() { return QCoroTask<T>(promise.future()); }
+
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+    // Called after the locals of the coroutine have been destroyed, so
+    // that continuations of the future do not run while they are alive
+    std::suspend_never final_suspend() noexcept
+    {
+        promise.finish();
+        return {};
+    }
+
+    void unhandled_exception()
+    {
+#ifndef QT_NO_EXCEPTIONS
+        promise.setException(std::current_exception());
+#else
+        qTerminate();
+#endif
+    }
+
+protected:
+    // Cancels and finishes the future if the coroutine is destroyed early
+    QPromise<T> promise;
+};
+
+template<class T>
+class CoroTaskPromise : public CoroTaskPromiseBase<T>
+{
+public:
+    template<typename U = T, typename = QtPrivate::EnableIfSameOrConvertible<U, T>>
+    void return_value(U &&value)
+    {
+        this->promise.addResult(std::forward<U>(value));
+    }
+};
+
+template<>
+class CoroTaskPromise<void> : public CoroTaskPromiseBase<void>
+{
+public:
+    void return_void() noexcept {}
+};
+
+} // namespace QtPrivate
+
+template<typename T = void>
+class QCoroTask
+{
+public:
+    using promise_type = QtPrivate::CoroTaskPromise<T>;
+
+    QFuture<T> future() const { return m_future; }
+
+    QtPrivate::FutureAwaiter<T> operator co_await() const
+    {
+        return QtPrivate::FutureAwaiter<T>(m_future);
+    }
+
+private:
+    friend class QtPrivate::CoroTaskPromiseBase<T>;
+
+    explicit QCoroTask(const QFuture<T> &future) : m_future(future) {}
+
+    QFuture<T> m_future;
+};
+
+template<typename T>
+QtPrivate::FutureAwaiter<T> operator co_await(const QFuture<T> &future)
+{
+    return QtPrivate::FutureAwaiter<T>(future);
+}
+
+namespace QtFuture {
+
+template<typename T>
+QtPrivate::FutureAwaiter<T> resumeIn(QObject *context, const QFuture<T> &future)
+{
+    Q_ASSERT(context);
+    return QtPrivate::FutureAwaiter<T>(future, context);
+}
+
+template<class Sender, class Signal, typename = QtPrivate::EnableIfInvocable<Sender, Signal>>
+QtPrivate::SignalAwaiter<Sender, Signal> signalEmitted(Sender *sender, Signal signal)
+{
+    return QtPrivate::SignalAwaiter<Sender, Signal>(sender, signal);
+}
+
+} // namespace QtFuture
+
+QT_END_NAMESPACE
+
+#endif // __cpp_impl_coroutine
+
+#endif // QCOROTASK_H
@@ -139,6 +139,9 @@ QT_WARNING_POP
     template<class Function>
     QFuture<ResultType<Function>> then(QObject *context, Function &&function);
 
+    template<class Function>
+    QFuture<ResultType<Function>> then(QtFuture::Executor *executor, Function &&function);
+
 #ifndef QT_NO_EXCEPTIONS
     template<class Function,
              typename = std::enable_if_t<!QtPrivate::ArgResolver<Function>::HasExtraArgs>>
@@ -295,6 +298,9 @@ private:
 
     friend struct QtPrivate::UnwrapHandler;
 
+    template<class U>
+    friend class QtPrivate::FutureAwaiter;
+
     using QFuturePrivate =
             std::conditional_t<std::is_same_v<T, void>, QFutureInterfaceBase, QFutureInterface<T>>;
 
@@ -366,6 +372,17 @@ QFuture<typename QFuture<T>::template ResultType<Function>> QFuture<T>::then(QOb
     return promise.future();
 }
 
+template<class T>
+template<class Function>
+QFuture<typename QFuture<T>::template ResultType<Function>>
+QFuture<T>::then(QtFuture::Executor *executor, Function &&function)
+{
+    QFutureInterface<ResultType<Function>> promise(QFutureInterfaceBase::State::Pending);
+    QtPrivate::CompactContinuation<std::decay_t<Function>, ResultType<Function>, T>::create(
+            std::forward<Function>(function), this, promise, executor);
+    return promise.future();
+}
+
 #ifndef QT_NO_EXCEPTIONS
 template<class T>
 template<class Function, typename>
@@ -35,6 +35,13 @@ namespace QtFuture {
 
 enum class Launch { Sync, Async, Inherit };
 
+class Q_CORE_EXPORT Executor
+{
+public:
+    virtual ~Executor();
+    virtual void execute(QRunnable *runnable) = 0;
+};
+
 template<class T>
 struct WhenAnyResult
 {
@@ -311,6 +318,19 @@ public:
         runObj->setAutoDelete(false);
     }
 
+    template<typename F = Function>
+    CompactContinuation(F &&func, const QFuture<ParentResultType> &f, QPromise<ResultType> &&p,
+                 QtFuture::Executor *executor)
+        : Storage{std::forward<F>(func)}, promise(std::move(p)), parentFuture(f),
+          executor(executor), type(Type::Async)
+    {
+        runObj = QRunnable::create([this] {
+            this->runFunction();
+            delete this;
+        });
+        runObj->setAutoDelete(false);
+    }
+
     ~CompactContinuation() { delete runObj; }
 
     bool execute();
@@ -325,6 +345,10 @@ public:
     static void create(F &&func, QFuture<ParentResultType> *f, QFutureInterface<ResultType> &fi,
                        QThreadPool *pool);
 
+    template<typename F = Function>
+    static void create(F &&func, QFuture<ParentResultType> *f, QFutureInterface<ResultType> &fi,
+                       QtFuture::Executor *executor);
+
     template<typename F = Function>
     static void create(F &&func, QFuture<ParentResultType> *f, QFutureInterface<ResultType> &fi,
                        QObject *context);
@@ -342,6 +366,9 @@ protected:
     {
         if (type == Type::Sync) {
             runFunction();
+        } else if (executor) {
+            Q_ASSERT(runObj);
+            executor->execute(runObj);
         } else {
             Q_ASSERT(runObj);
             QThreadPool *pool = threadPool ? threadPool : QThreadPool::globalInstance();
@@ -360,6 +387,7 @@ protected:
     QPromise<ResultType> promise;
     QFuture<ParentResultType> parentFuture;
     QThreadPool *threadPool = nullptr;
+    QtFuture::Executor *executor = nullptr;
     QRunnable *runObj = nullptr;
     Type type;
 };
@@ -478,25 +506,6 @@ bool CompactContinuation<Function, ResultType, ParentResultType>::execute()
     return true;
 }
 
-// Workaround for keeping move-only lambdas inside std::function
-template<class Function>
-struct ContinuationWrapper
-{
-    ContinuationWrapper(Function &&f) : function(std::move(f)) { }
-    ContinuationWrapper(const ContinuationWrapper &other)
-        : function(std::move(const_cast<ContinuationWrapper &>(other).function))
-    {
-        Q_ASSERT_X(false, "QFuture", "Continuation shouldn't be copied");
-    }
-    ContinuationWrapper(ContinuationWrapper &&other) = default;
-    ContinuationWrapper &operator=(ContinuationWrapper &&) = default;
-
-    void operator()(const QFutureInterfaceBase &parentData) { function(parentData); }
-
-private:
-    Function function;
-};
-
 template<typename Function, typename ResultType, typename ParentResultType>
 template<typename F>
 void CompactContinuation<Function, ResultType, ParentResultType>::create(F &&func,
@@ -524,27 +533,23 @@ void CompactContinuation<Function, ResultType, ParentResultType>::create(F &&fun
     auto continuation = [func = std::forward<F>(func), fi, promise_ = QPromise(fi), pool,
                          launchAsync](const QFutureInterfaceBase &parentData) mutable {
         const auto parent = QFutureInterface<ParentResultType>(parentData).future();
-        CompactContinuation<Function, ResultType, ParentResultType> *continuationJob = nullptr;
-        if (launchAsync) {
-            auto asyncJob = new CompactContinuation<Function, ResultType, ParentResultType>(
-                    std::forward<Function>(func), parent, std::move(promise_), pool);
-            fi.setRunnable(asyncJob->runnable());
-            continuationJob = asyncJob;
-        } else {
-            continuationJob = new CompactContinuation<Function, ResultType, ParentResultType>(
+        if (!launchAsync) {
+            // Runs here and now, so needs no allocation
+            CompactContinuation<Function, ResultType, ParentResultType> continuationJob(
                     std::forward<Function>(func), parent, std::move(promise_));
+            continuationJob.execute();
+            return;
         }
 
-        bool isLaunched = continuationJob->execute();
+        auto continuationJob = new CompactContinuation<Function, ResultType, ParentResultType>(
+                std::forward<Function>(func), parent, std::move(promise_), pool);
+        fi.setRunnable(continuationJob->runnable());
         // If continuation is successfully launched, AsyncContinuation will be deleted
-        // from the QRunnable's lambda. Synchronous continuation will be
-        // executed immediately, so it's safe to always delete it here.
-        if (!(launchAsync && isLaunched)) {
+        // from the QRunnable's lambda.
+        if (!continuationJob->execute())
             delete continuationJob;
-            continuationJob = nullptr;
-        }
     };
-    f->d.setContinuation(ContinuationWrapper(std::move(continuation)), fi.d);
+    f->d.setContinuation(ContinuationFunction(std::move(continuation)), fi.d);
 }
 
 template<typename Function, typename ResultType, typename ParentResultType>
@@ -572,7 +577,30 @@ void CompactContinuation<Function, ResultType, ParentResultType>::create(F &&fun
             continuationJob = nullptr;
         }
     };
-    f->d.setContinuation(ContinuationWrapper(std::move(continuation)), fi.d);
+    f->d.setContinuation(ContinuationFunction(std::move(continuation)), fi.d);
+}
+
+template<typename Function, typename ResultType, typename ParentResultType>
+template<typename F>
+void CompactContinuation<Function, ResultType, ParentResultType>::create(F &&func,
+                                                                  QFuture<ParentResultType> *f,
+                                                                  QFutureInterface<ResultType> &fi,
+                                                                  QtFuture::Executor *executor)
+{
+    Q_ASSERT(f);
+    Q_ASSERT(executor);
+
+    auto continuation = [func = std::forward<F>(func), promise_ = QPromise(fi),
+                         executor](const QFutureInterfaceBase &parentData) mutable {
+        const auto parent = QFutureInterface<ParentResultType>(parentData).future();
+        auto continuationJob = new CompactContinuation<Function, ResultType, ParentResultType>(
+                std::forward<Function>(func), parent, std::move(promise_), executor);
+        // If continuation is successfully launched, it will be deleted
+        // from the QRunnable's lambda.
+        if (!continuationJob->execute())
+            delete continuationJob;
+    };
+    f->d.setContinuation(ContinuationFunction(std::move(continuation)), fi.d);
 }
 
 template <typename Continuation>
@@ -678,7 +706,7 @@ void FailureHandler<Function, ResultType>::create(F &&function, QFuture<ResultTy
         failureHandler.run();
     };
 
-    future->d.setContinuation(ContinuationWrapper(std::move(failureContinuation)));
+    future->d.setContinuation(ContinuationFunction(std::move(failureContinuation)), nullptr);
 }
 
 template<class Function, class ResultType>
@@ -776,7 +804,8 @@ public:
             auto parentFuture = QFutureInterface<ResultType>(parentData).future();
             run(std::forward<F>(handler), parentFuture, std::move(promise));
         };
-        future->d.setContinuation(ContinuationWrapper(std::move(canceledContinuation)));
+        future->d.setContinuation(ContinuationFunction(std::move(canceledContinuation)),
+                                  nullptr);
     }
 
     template<class F = Function>
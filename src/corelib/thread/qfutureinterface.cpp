@@ -93,14 +93,14 @@ void QtPrivate::watchContinuationImpl(const QObject *context, QSlotObjectBase *s
     // the watcher to occur after emit watcher->run() completes and prevents the race condition.
     QObject::connect(context, &QObject::destroyed, watcher, destroyWatcher);
 
-    fi.setContinuation([watcherMutex, watcher = QPointer(watcher)]
-                       (const QFutureInterfaceBase &parentData)
+    fi.setContinuation(QtPrivate::ContinuationFunction([watcherMutex, watcher = QPointer(watcher)]
+                                                       (const QFutureInterfaceBase &parentData)
     {
         Q_UNUSED(parentData);
         QMutexLocker lock(watcherMutex.get());
         if (watcher)
             emit watcher->run();
-    });
+    }), nullptr);
 }
 
 QFutureCallOutInterface::~QFutureCallOutInterface()
@@ -880,6 +880,12 @@ void QFutureInterfaceBase::setContinuation(std::function<void(const QFutureInter
 
 void QFutureInterfaceBase::setContinuation(std::function<void(const QFutureInterfaceBase &)> func,
                                            QFutureInterfaceBasePrivate *continuationFutureData)
+{
+    setContinuation(QtPrivate::ContinuationFunction(std::move(func)), continuationFutureData);
+}
+
+void QFutureInterfaceBase::setContinuation(QtPrivate::ContinuationFunction &&func,
+                                           QFutureInterfaceBasePrivate *continuationFutureData)
 {
     QMutexLocker lock(&d->continuationMutex);
 
@@ -909,7 +915,7 @@ void QFutureInterfaceBase::cleanContinuation()
         return;
 
     QMutexLocker lock(&d->continuationMutex);
-    d->continuation = nullptr;
+    d->continuation.reset();
     d->continuationState = QFutureInterfaceBasePrivate::Cleaned;
     d->continuationData = nullptr;
 }
@@ -919,7 +925,7 @@ void QFutureInterfaceBase::runContinuation() const
     QMutexLocker lock(&d->continuationMutex);
     if (d->continuation) {
         // Save the continuation in a local function, to avoid calling
-        // a null std::function below, in case cleanContinuation() is
+        // a null function below, in case cleanContinuation() is
         // called from some other thread right after unlock() below.
         auto fn = std::move(d->continuation);
         lock.unlock();
@@ -960,6 +966,8 @@ QFuture<void> makeReadyVoidFuture()
     return promise.future();
 }
 
+Executor::~Executor() = default;
+
 } // namespace QtFuture
 
 QT_END_NAMESPACE
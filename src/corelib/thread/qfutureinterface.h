@@ -10,6 +10,9 @@
 #include <exception>
 #endif
 
+#include <cstddef>
+#include <new>
+#include <type_traits>
 #include <utility>
 
 QT_REQUIRE_CONFIG(future);
@@ -40,9 +43,103 @@ template<class Function, class ResultType>
 class FailureHandler;
 #endif
 
+template<class T>
+class FutureAwaiter;
+
 void Q_CORE_EXPORT watchContinuationImpl(const QObject *context,
                                          QtPrivate::QSlotObjectBase *slotObj,
                                          QFutureInterfaceBase &fi);
+
+// A move-only continuation, called with the interface of the finished
+// future; stored inline unless it is large or may throw when moved
+class ContinuationFunction
+{
+    static constexpr std::size_t InlineSize = 8 * sizeof(void *);
+
+    struct Ops
+    {
+        void (*call)(void *function, const QFutureInterfaceBase &parent);
+        // move-constructs the function at to from the one at from, and destroys that
+        void (*relocate)(void *from, void *to) noexcept;
+        void (*destroy)(void *function) noexcept;
+    };
+
+    template <typename F>
+    static constexpr bool IsInline = sizeof(F) <= InlineSize
+            && alignof(F) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<F>;
+
+    template <typename F>
+    static constexpr Ops InlineOps = {
+        [](void *function, const QFutureInterfaceBase &parent) {
+            (*static_cast<F *>(function))(parent);
+        },
+        [](void *from, void *to) noexcept {
+            new (to) F(std::move(*static_cast<F *>(from)));
+            static_cast<F *>(from)->~F();
+        },
+        [](void *function) noexcept { static_cast<F *>(function)->~F(); }
+    };
+
+    template <typename F>
+    static constexpr Ops HeapOps = {
+        [](void *function, const QFutureInterfaceBase &parent) {
+            (**static_cast<F **>(function))(parent);
+        },
+        [](void *from, void *to) noexcept { *static_cast<F **>(to) = *static_cast<F **>(from); },
+        [](void *function) noexcept { delete *static_cast<F **>(function); }
+    };
+
+public:
+    ContinuationFunction() noexcept = default;
+    template <typename F, std::enable_if_t<
+                     !std::is_same_v<std::decay_t<F>, ContinuationFunction>, bool> = true>
+    explicit ContinuationFunction(F &&function)
+    {
+        using Function = std::decay_t<F>;
+        if constexpr (IsInline<Function>) {
+            new (storage) Function(std::forward<F>(function));
+            ops = &InlineOps<Function>;
+        } else {
+            *reinterpret_cast<Function **>(storage) = new Function(std::forward<F>(function));
+            ops = &HeapOps<Function>;
+        }
+    }
+    ContinuationFunction(ContinuationFunction &&other) noexcept
+        : ops(std::exchange(other.ops, nullptr))
+    {
+        if (ops)
+            ops->relocate(other.storage, storage);
+    }
+    ContinuationFunction &operator=(ContinuationFunction &&other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            ops = std::exchange(other.ops, nullptr);
+            if (ops)
+                ops->relocate(other.storage, storage);
+        }
+        return *this;
+    }
+    ~ContinuationFunction() { reset(); }
+
+    void reset() noexcept
+    {
+        if (const Ops *old = std::exchange(ops, nullptr))
+            old->destroy(storage);
+    }
+    explicit operator bool() const noexcept { return ops; }
+    void operator()(const QFutureInterfaceBase &parent)
+    {
+        Q_ASSERT(ops);
+        ops->call(storage, parent);
+    }
+
+private:
+    Q_DISABLE_COPY(ContinuationFunction)
+
+    alignas(std::max_align_t) unsigned char storage[InlineSize];
+    const Ops *ops = nullptr;
+};
 }
 
 class Q_CORE_EXPORT QFutureInterfaceBase
@@ -184,6 +281,9 @@ private:
     friend Q_CORE_EXPORT void QtPrivate::watchContinuationImpl(
             const QObject *context, QtPrivate::QSlotObjectBase *slotObj, QFutureInterfaceBase &fi);
 
+    template<class T>
+    friend class QtPrivate::FutureAwaiter;
+
     template<class T>
     friend class QPromise;
 
@@ -191,6 +291,8 @@ protected:
     void setContinuation(std::function<void(const QFutureInterfaceBase &)> func);
     void setContinuation(std::function<void(const QFutureInterfaceBase &)> func,
                          QFutureInterfaceBasePrivate *continuationFutureData);
+    void setContinuation(QtPrivate::ContinuationFunction &&func,
+                         QFutureInterfaceBasePrivate *continuationFutureData);
     void cleanContinuation();
     void runContinuation() const;
 
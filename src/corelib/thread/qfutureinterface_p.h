@@ -139,8 +139,7 @@ public:
 
     QRunnable *runnable = nullptr;
     QThreadPool *m_pool = nullptr;
-    // Wrapper for continuation
-    std::function<void(const QFutureInterfaceBase &)> continuation;
+    QtPrivate::ContinuationFunction continuation;
     QFutureInterfaceBasePrivate *continuationData = nullptr;
 
     RefCount refCount = 1;
@@ -8,6 +8,11 @@
 
 #include <QtCore/qpointer.h>
 
+#if defined(Q_OS_LINUX)
+#include <QtCore/qfile.h>
+#include <sched.h>
+#endif
+
 #include <algorithm>
 #include <memory>
 
@@ -29,8 +34,40 @@ public:
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+    int numaNode;
 };
 
+#if defined(Q_OS_LINUX)
+// Restricts the calling thread to the CPUs of NUMA node \a node
+static void bindCurrentThreadToNumaNode(int node)
+{
+    QFile cpuList(QString::asprintf("/sys/devices/system/node/node%d/cpulist", node));
+    if (!cpuList.open(QIODevice::ReadOnly))
+        return;
+
+    // The list has the form "0-3,8-11"
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    const QList<QByteArray> ranges = cpuList.readAll().trimmed().split(',');
+    for (const QByteArray &range : ranges) {
+        const qsizetype dash = range.indexOf('-');
+        bool ok = false;
+        const int first = range.left(dash).toInt(&ok);
+        const int last = dash < 0 ? first : range.mid(dash + 1).toInt(&ok);
+        if (!ok)
+            continue;
+        for (int cpu = first; cpu <= last && cpu < CPU_SETSIZE; ++cpu)
+            CPU_SET(cpu, &cpus);
+    }
+    if (CPU_COUNT(&cpus) > 0)
+        sched_setaffinity(0, sizeof(cpus), &cpus);
+}
+#else
+static void bindCurrentThreadToNumaNode(int)
+{
+}
+#endif
+
 /*
     QThreadPool private class.
 */
@@ -40,7 +77,7 @@ public:
     \internal
 */
 QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
-    :manager(manager), runnable(nullptr)
+    :manager(manager), runnable(nullptr), numaNode(manager->numaNode)
 {
     setStackSize(manager->stackSize);
 }
@@ -50,6 +87,9 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
 */
 void QThreadPoolThread::run()
 {
+    if (numaNode >= 0)
+        bindCurrentThreadToNumaNode(numaNode);
+
     QMutexLocker locker(&manager->mutex);
     for(;;) {
         QRunnable *r = runnable;
@@ -735,6 +775,37 @@ QThread::Priority QThreadPool::threadPriority() const
     return d->threadPriority;
 }
 
+/*! \property QThreadPool::numaNode
+    \brief the NUMA node that new worker threads run on.
+
+    If set to a node number, worker threads only run on the CPUs of that
+    node, so that memory they allocate and first touch is local to it. To
+    spread work over several nodes, use one thread pool per node.
+
+    The value of the property is only used when the thread pool creates
+    new threads. Changing it has no effect for already created threads.
+
+    The default value is -1, which does not restrict the CPUs that worker
+    threads run on. The property has no effect on platforms other than
+    Linux, or if the node does not exist.
+
+    \since 6.10
+*/
+
+void QThreadPool::setNumaNode(int node)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    d->numaNode = node;
+}
+
+int QThreadPool::numaNode() const
+{
+    Q_D(const QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    return d->numaNode;
+}
+
 /*!
     Releases a thread previously reserved by a call to reserveThread().
 
@@ -149,6 +149,7 @@ public:
     int activeThreads = 0;
     uint stackSize = 0;
     QThread::Priority threadPriority = QThread::InheritPriority;
+    int numaNode = -1;
 };
 
 QT_END_NAMESPACE
@@ -5671,6 +5671,165 @@ QDateTime QDateTime::fromSecsSinceEpoch(qint64 secs)
     return fromSecsSinceEpoch(secs, QTimeZone::LocalTime);
 }
 
+namespace {
+/*
+    The UTC offset of a time representation over a range of UTC times that
+    contains no transition, to convert runs of nearby values without asking
+    the time zone about each of them.
+*/
+struct OffsetRange
+{
+    using Bounds = std::numeric_limits<qint64>;
+
+    qint64 start = 1;   // empty
+    qint64 end = 0;
+    qint64 offsetMSecs = 0;
+
+    bool contains(qint64 utcMSecs) const { return start <= utcMSecs && utcMSecs < end; }
+    // True if utcMSecs is so far from the ends that the local time it gives
+    // can't also be reached from outside the range, whatever the offsets there
+    bool containsWithMargin(qint64 utcMSecs) const
+    {
+        constexpr quint64 margin = 2 * MSECS_PER_DAY;
+        return contains(utcMSecs)
+                && (start == Bounds::min() || quint64(utcMSecs) - quint64(start) >= margin)
+                && (end == Bounds::max() || quint64(end) - quint64(utcMSecs) > margin);
+    }
+};
+
+// Returns false, leaving *range alone, if there's no offset range around utcMSecs.
+// The zone's private is passed for time zones, as only QDateTime can get it.
+static bool offsetRangeAt(const QTimeZone &zone, [[maybe_unused]] const QTimeZonePrivate *tzp,
+                          qint64 utcMSecs, OffsetRange *range)
+{
+    switch (zone.timeSpec()) {
+    case Qt::UTC:
+    case Qt::OffsetFromUTC:
+        *range = { OffsetRange::Bounds::min(), OffsetRange::Bounds::max(),
+                   zone.fixedSecondsAheadOfUtc() * MSECS_PER_SEC };
+        return true;
+    case Qt::TimeZone:
+#if QT_CONFIG(timezone)
+        if (tzp && tzp->hasTransitions()) {
+            const QTimeZonePrivate::Data data = tzp->data(utcMSecs);
+            if (data.offsetFromUtc == QTimeZonePrivate::invalidSeconds())
+                return false;
+            const qint64 invalid = QTimeZonePrivate::invalidMSecs();
+            const auto previous = tzp->previousTransition(utcMSecs + 1);
+            const auto next = tzp->nextTransition(utcMSecs);
+            const OffsetRange found = {
+                previous.atMSecsSinceEpoch == invalid
+                        ? OffsetRange::Bounds::min() : previous.atMSecsSinceEpoch,
+                next.atMSecsSinceEpoch == invalid
+                        ? OffsetRange::Bounds::max() : next.atMSecsSinceEpoch,
+                data.offsetFromUtc * MSECS_PER_SEC
+            };
+            if (!found.contains(utcMSecs))
+                return false;
+            *range = found;
+            return true;
+        }
+#endif
+        return false;
+    case Qt::LocalTime:
+        // The system functions for local time don't tell us its transitions
+        return false;
+    }
+    return false;
+}
+} // unnamed namespace
+
+/*!
+    \since 6.10
+    \overload
+
+    Converts each value of \a msecs, a number of milliseconds since the start,
+    in UTC, of the year 1970, to the date and time it has in \a timeZone, and
+    stores them at the same index of \a dates and \a times, which must have
+    the same size as \a msecs.
+
+    The results are the date() and time() of fromMSecsSinceEpoch(msecs[i],
+    timeZone), but this function is much faster for many values: the dates
+    and times of UTC and fixed offsets from it are computed by plain
+    arithmetic, and those of a time zone reuse its offset until the next
+    transition, which makes sorted or clustered values particularly cheap.
+    Values in local time are converted one by one.
+
+    \sa toMSecsSinceEpoch()
+*/
+void QDateTime::fromMSecsSinceEpoch(QSpan<const qint64> msecs, const QTimeZone &timeZone,
+                                    QSpan<QDate> dates, QSpan<QTime> times)
+{
+    Q_ASSERT(dates.size() == msecs.size());
+    Q_ASSERT(times.size() == msecs.size());
+    const QTimeZonePrivate *tzp = timeZone.timeSpec() == Qt::TimeZone && timeZone.isValid()
+            ? timeZone.d.operator->() : nullptr;
+    const qsizetype count = msecs.size();
+    OffsetRange range;
+    for (qsizetype i = 0; i < count; ++i) {
+        const qint64 utc = msecs[i];
+        qint64 local;
+        if ((range.contains(utc) || offsetRangeAt(timeZone, tzp, utc, &range))
+            && !qAddOverflow(utc, range.offsetMSecs, &local)) {
+            dates[i] = msecsToDate(local);
+            times[i] = msecsToTime(local);
+        } else {
+            const QDateTime dt = fromMSecsSinceEpoch(utc, timeZone);
+            dates[i] = dt.date();
+            times[i] = dt.time();
+        }
+    }
+}
+
+/*!
+    \since 6.10
+    \overload
+
+    Converts each date of \a dates, with the time at the same index of \a
+    times, both taken in \a timeZone, to a number of milliseconds since the
+    start, in UTC, of the year 1970, and stores it at the same index of \a
+    msecs. The three spans must have the same size.
+
+    The results are those of QDateTime(dates[i], times[i],
+    timeZone).toMSecsSinceEpoch(), including the resolution of times in a
+    transition, but this function is much faster for many values, as
+    described for fromMSecsSinceEpoch().
+
+    \sa fromMSecsSinceEpoch()
+*/
+void QDateTime::toMSecsSinceEpoch(QSpan<const QDate> dates, QSpan<const QTime> times,
+                                  const QTimeZone &timeZone, QSpan<qint64> msecs)
+{
+    Q_ASSERT(times.size() == dates.size());
+    Q_ASSERT(msecs.size() == dates.size());
+    using Bounds = std::numeric_limits<qint64>;
+    const QTimeZonePrivate *tzp = timeZone.timeSpec() == Qt::TimeZone && timeZone.isValid()
+            ? timeZone.d.operator->() : nullptr;
+    const qsizetype count = dates.size();
+    OffsetRange range;
+    offsetRangeAt(timeZone, tzp, 0, &range);
+    for (qsizetype i = 0; i < count; ++i) {
+        const QDate date = dates[i];
+        const QTime time = times[i];
+        const bool valid = date.isValid() && time.isValid();
+        if (Q_LIKELY(valid)) {
+            // A time in a transition needs its resolution, so only take the
+            // offset of the current range when we're well inside it
+            const qint64 local = timeToMSecs(date, time);
+            qint64 utc;
+            if (local != Bounds::min() && local != Bounds::max()
+                && !qSubOverflow(local, range.offsetMSecs, &utc) && range.containsWithMargin(utc)) {
+                msecs[i] = utc;
+                continue;
+            }
+        }
+        const QDateTime dt(date, time, timeZone);
+        msecs[i] = dt.toMSecsSinceEpoch();
+        if (valid && dt.isValid())
+            offsetRangeAt(timeZone, tzp, msecs[i], &range);
+    }
+}
+
 #if QT_CONFIG(datestring) // depends on, so implies, textdate
 
 /*!
@@ -10,6 +10,7 @@
 #include <QtCore/qlocale.h>
 #include <QtCore/qnamespace.h>
 #include <QtCore/qshareddata.h>
+#include <QtCore/qspan.h>
 #include <QtCore/qstring.h>
 
 #include <limits>
@@ -495,6 +496,10 @@ public:
     static QDateTime fromSecsSinceEpoch(qint64 secs, const QTimeZone &timeZone);
     static QDateTime fromMSecsSinceEpoch(qint64 msecs);
     static QDateTime fromSecsSinceEpoch(qint64 secs);
+    static void fromMSecsSinceEpoch(QSpan<const qint64> msecs, const QTimeZone &timeZone,
+                                    QSpan<QDate> dates, QSpan<QTime> times);
+    static void toMSecsSinceEpoch(QSpan<const QDate> dates, QSpan<const QTime> times,
+                                  const QTimeZone &timeZone, QSpan<qint64> msecs);
 
     static qint64 currentMSecsSinceEpoch() noexcept;
     static qint64 currentSecsSinceEpoch() noexcept;
@@ -18,10 +18,13 @@
 //
 
 #include "qlist.h"
+#include "qspan.h"
 #include "qtimezone.h"
 #include "private/qlocale_p.h"
 #include "private/qdatetime_p.h"
 
+#include <optional>
+
 #if QT_CONFIG(icu)
 #include <unicode/ucal.h>
 #endif
@@ -343,6 +346,45 @@ struct QTzTimeZoneCacheEntry
     bool m_hasDst = false;
 };
 
+/*
+    All zones of the system's zoneinfo directory, compiled into one block of
+    data that can be memory-mapped and used in place: the transitions and
+    rules of a zone are read without copying them, and the zones are found
+    by binary search of their sorted IDs.
+*/
+class Q_AUTOTEST_EXPORT QTzDatabase
+{
+public:
+    QTzDatabase() = default;
+    // data must be suitably aligned, and outlive the QTzDatabase
+    explicit QTzDatabase(QByteArrayView data);
+
+    static QByteArray compile(QByteArrayView sourceStamp);
+    static QByteArray sourceStamp();
+
+    bool isValid() const { return !m_data.isEmpty(); }
+    QByteArrayView stamp() const;
+
+    bool contains(QByteArrayView ianaId) const { return findZone(ianaId) != nullptr; }
+    std::optional<QTzTimeZoneCacheEntry> entry(QByteArrayView ianaId) const;
+    QLocale::Territory territory(QByteArrayView ianaId) const;
+    QByteArray comment(QByteArrayView ianaId) const;
+    QList<QByteArray> availableTimeZoneIds() const;
+    QList<QByteArray> availableTimeZoneIds(QLocale::Territory territory) const;
+
+private:
+    struct Header;
+    struct StringRef;
+    struct Zone;
+
+    QSpan<const Zone> zones() const;
+    const Zone *findZone(QByteArrayView ianaId) const;
+    QByteArray string(StringRef ref) const;
+    static bool isValidData(QByteArrayView data);
+
+    QByteArrayView m_data;
+};
+
 class Q_AUTOTEST_EXPORT QTzTimeZonePrivate final : public QTimeZonePrivate
 {
     QTzTimeZonePrivate(const QTzTimeZonePrivate &) = default;
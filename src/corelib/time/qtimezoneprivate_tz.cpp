@@ -7,12 +7,18 @@
 #include "qtimezoneprivate_p.h"
 #include "private/qlocale_tools_p.h"
 #include "private/qlocking_p.h"
+#include "private/qcore_unix_p.h"
 
 #include <QtCore/QDataStream>
 #include <QtCore/QDateTime>
 #include <QtCore/QDirListing>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#if QT_CONFIG(temporaryfile)
+#include <QtCore/QSaveFile>
+#endif
+#include <QtCore/QStandardPaths>
 #include <QtCore/QCache>
 #include <QtCore/QMap>
 #include <QtCore/QMutex>
@@ -21,7 +27,10 @@
 #include <qplatformdefs.h>
 
 #include <algorithm>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include <errno.h>
 #include <limits.h>
@@ -29,6 +38,7 @@
 #include <sys/param.h> // to use MAXSYMLINKS constant
 #endif
 #include <unistd.h>    // to use _SC_SYMLOOP_MAX constant
+#include <sys/mman.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -139,9 +149,6 @@ static QTzTimeZoneHash loadTzTimeZones()
     return zonesHash;
 }
 
-// Hash of available system tz files as loaded by loadTzTimeZones()
-Q_GLOBAL_STATIC(const QTzTimeZoneHash, tzZones, loadTzTimeZones());
-
 /*
     The following is copied and modified from tzfile.h which is in the public domain.
     Copied as no compatibility guarantee and is never system installed.
@@ -782,6 +789,8 @@ private:
     static QTzTimeZoneCacheEntry findEntry(const QByteArray &ianaId);
     QCache<QByteArray, QTzTimeZoneCacheEntry> m_cache;
     QMutex m_mutex;
+
+    friend class QTzDatabase;
 };
 
 QTzTimeZoneCacheEntry QTzTimeZoneCache::findEntry(const QByteArray &ianaId)
@@ -987,13 +996,428 @@ QTzTimeZoneCacheEntry QTzTimeZoneCache::fetchEntry(const QByteArray &ianaId)
     return ret;
 }
 
+/*
+    The compiled database
+
+    The data is used in place, so it is in native byte order and layout, and
+    starts with a header that identifies the format. It is followed by the
+    sorted array of Zone records, then the arrays of transitions, rules and
+    abbreviations of all zones, then a pool of NUL-terminated strings. All
+    offsets are from the start of the data.
+*/
+
+struct QTzDatabase::Header
+{
+    char magic[8];
+    quint32 version;
+    quint32 byteOrderMark;
+    quint16 transitionSize;
+    quint16 ruleSize;
+    quint32 zoneCount;
+    quint32 zonesOffset;
+    quint32 stringsOffset;
+    quint32 stringsSize;
+    quint32 stampOffset;        // in the string pool
+    quint32 stampSize;
+    quint32 size;
+};
+
+struct QTzDatabase::StringRef
+{
+    quint32 offset;             // in the string pool
+    quint32 size;
+};
+
+struct QTzDatabase::Zone
+{
+    StringRef id;
+    StringRef comment;
+    StringRef posixRule;
+    quint32 transitionsOffset;  // QTzTransitionTime[transitionCount]
+    quint32 transitionCount;
+    quint32 rulesOffset;        // QTzTransitionRule[ruleCount]
+    quint32 ruleCount;
+    quint32 abbreviationsOffset; // StringRef[abbreviationCount]
+    quint32 abbreviationCount;
+    QTzTransitionRule preZoneRule;
+    qint32 territory;
+    quint32 hasDst;
+};
+
+static constexpr char TzDatabaseMagic[8] = { 'Q', 'T', 'z', 'D', 'b', 0, 0, 0 };
+static constexpr quint32 TzDatabaseVersion = 1;
+static constexpr quint32 TzDatabaseByteOrderMark = 0x01020304;
+
+QTzDatabase::QTzDatabase(QByteArrayView data)
+{
+    if (isValidData(data))
+        m_data = data;
+}
+
+bool QTzDatabase::isValidData(QByteArrayView data)
+{
+    if (size_t(data.size()) < sizeof(Header) || quintptr(data.data()) % alignof(qint64))
+        return false;
+    const auto *header = reinterpret_cast<const Header *>(data.data());
+    if (memcmp(header->magic, TzDatabaseMagic, sizeof(TzDatabaseMagic)) != 0
+        || header->version != TzDatabaseVersion
+        || header->byteOrderMark != TzDatabaseByteOrderMark
+        || header->transitionSize != sizeof(QTzTransitionTime)
+        || header->ruleSize != sizeof(QTzTransitionRule)
+        || header->size != quint64(data.size())) {
+        return false;
+    }
+
+    const quint64 size = header->size;
+    const auto inRange = [size](quint64 offset, quint64 count, size_t itemSize,
+                                size_t alignment) {
+        return offset % alignment == 0 && offset <= size && count <= (size - offset) / itemSize;
+    };
+    if (!inRange(header->zonesOffset, header->zoneCount, sizeof(Zone), alignof(Zone))
+        || !inRange(header->stringsOffset, header->stringsSize, 1, 1)) {
+        return false;
+    }
+    const char *strings = data.data() + header->stringsOffset;
+    const auto isString = [&](StringRef ref) {
+        return ref.offset < header->stringsSize && ref.size < header->stringsSize - ref.offset
+                && strings[ref.offset + ref.size] == '\0';
+    };
+    if (!isString({ header->stampOffset, header->stampSize }))
+        return false;
+
+    const auto *zones = reinterpret_cast<const Zone *>(data.data() + header->zonesOffset);
+    for (quint32 i = 0; i < header->zoneCount; ++i) {
+        const Zone &zone = zones[i];
+        if (!isString(zone.id) || !isString(zone.comment) || !isString(zone.posixRule)
+            || !inRange(zone.transitionsOffset, zone.transitionCount,
+                        sizeof(QTzTransitionTime), alignof(QTzTransitionTime))
+            || !inRange(zone.rulesOffset, zone.ruleCount,
+                        sizeof(QTzTransitionRule), alignof(QTzTransitionRule))
+            || !inRange(zone.abbreviationsOffset, zone.abbreviationCount,
+                        sizeof(StringRef), alignof(StringRef))) {
+            return false;
+        }
+        // IDs must be sorted, for findZone()
+        const auto id = [&](const Zone &z) {
+            return QByteArrayView(strings + z.id.offset, z.id.size);
+        };
+        if (i > 0 && !(id(zones[i - 1]) < id(zone)))
+            return false;
+
+        const QSpan transitions(
+                reinterpret_cast<const QTzTransitionTime *>(data.data() + zone.transitionsOffset),
+                zone.transitionCount);
+        for (const QTzTransitionTime &tran : transitions) {
+            if (tran.ruleIndex >= zone.ruleCount)
+                return false;
+        }
+        const QSpan rules(
+                reinterpret_cast<const QTzTransitionRule *>(data.data() + zone.rulesOffset),
+                zone.ruleCount);
+        for (const QTzTransitionRule &rule : rules) {
+            if (rule.abbreviationIndex >= zone.abbreviationCount)
+                return false;
+        }
+        const QSpan abbreviations(
+                reinterpret_cast<const StringRef *>(data.data() + zone.abbreviationsOffset),
+                zone.abbreviationCount);
+        for (StringRef abbreviation : abbreviations) {
+            if (!isString(abbreviation))
+                return false;
+        }
+    }
+    return true;
+}
+
+// Identifies the zoneinfo files the database is compiled from, so that an
+// update of the system's time zone data invalidates it.
+QByteArray QTzDatabase::sourceStamp()
+{
+    QFile zoneTab;
+    if (!openZoneInfo("zone.tab"_L1, &zoneTab))
+        return QByteArray();
+    const QByteArray tabPath = QFile::encodeName(zoneTab.fileName());
+    const QByteArray dirPath = tabPath.first(tabPath.lastIndexOf('/') + 1);
+
+    QByteArray stamp = dirPath;
+    for (const char *name : { "", "zone.tab", "tzdata.zi", "+VERSION" }) {
+        const QByteArray path = dirPath + name;
+        QT_STATBUF st;
+        if (QT_STAT(path.constData(), &st) != 0)
+            continue;
+        stamp += '\n' + path + ' ' + QByteArray::number(qint64(st.st_ino))
+                + ' ' + QByteArray::number(qint64(st.st_size))
+                + ' ' + QByteArray::number(qint64(st.st_mtime));
+    }
+    return stamp;
+}
+
+QByteArray QTzDatabase::compile(QByteArrayView sourceStamp)
+{
+    const QTzTimeZoneHash zoneHash = loadTzTimeZones();
+    QList<QByteArray> ids = zoneHash.keys();
+    std::sort(ids.begin(), ids.end());
+
+    QByteArray strings;
+    const auto addString = [&strings](QByteArrayView text) {
+        const StringRef ref = { quint32(strings.size()), quint32(text.size()) };
+        strings += text;
+        strings += '\0';
+        return ref;
+    };
+    // arrays, with offsets relative to the start of arrays for now
+    QByteArray arrays;
+    const auto addArray = [&arrays](const auto *items, qsizetype count) {
+        using T = std::remove_pointer_t<decltype(items)>;
+        arrays.append((alignof(T) - arrays.size() % alignof(T)) % alignof(T), '\0');
+        const quint32 offset = quint32(arrays.size());
+        arrays.append(reinterpret_cast<const char *>(items), count * qsizetype(sizeof(T)));
+        return offset;
+    };
+
+    std::vector<Zone> zones;
+    zones.reserve(ids.size());
+    for (const QByteArray &id : std::as_const(ids)) {
+        const QTzTimeZoneCacheEntry entry = QTzTimeZoneCache::findEntry(id);
+        if (entry.m_tranTimes.isEmpty() && entry.m_posixRule.isEmpty())
+            continue; // Not a valid zone after all
+        const QTzTimeZone info = zoneHash.value(id);
+        Zone zone = {};
+        zone.id = addString(id);
+        zone.comment = addString(info.comment);
+        zone.posixRule = addString(entry.m_posixRule);
+        zone.transitionsOffset = addArray(entry.m_tranTimes.constData(), entry.m_tranTimes.size());
+        zone.transitionCount = quint32(entry.m_tranTimes.size());
+        zone.rulesOffset = addArray(entry.m_tranRules.constData(), entry.m_tranRules.size());
+        zone.ruleCount = quint32(entry.m_tranRules.size());
+        std::vector<StringRef> abbreviations;
+        for (const QByteArray &abbreviation : entry.m_abbreviations)
+            abbreviations.push_back(addString(abbreviation));
+        zone.abbreviationsOffset = addArray(abbreviations.data(), qsizetype(abbreviations.size()));
+        zone.abbreviationCount = quint32(abbreviations.size());
+        zone.preZoneRule = entry.m_preZoneRule;
+        zone.territory = info.territory;
+        zone.hasDst = entry.m_hasDst;
+        zones.push_back(zone);
+    }
+    if (zones.empty())
+        return QByteArray();
+    const StringRef stamp = addString(sourceStamp);
+
+    Header header = {};
+    memcpy(header.magic, TzDatabaseMagic, sizeof(TzDatabaseMagic));
+    header.version = TzDatabaseVersion;
+    header.byteOrderMark = TzDatabaseByteOrderMark;
+    header.transitionSize = sizeof(QTzTransitionTime);
+    header.ruleSize = sizeof(QTzTransitionRule);
+    header.zoneCount = quint32(zones.size());
+    header.zonesOffset = sizeof(Header);
+    const quint64 arraysOffset = (header.zonesOffset + zones.size() * sizeof(Zone)
+                                  + alignof(qint64) - 1) / alignof(qint64) * alignof(qint64);
+    const quint64 stringsOffset = arraysOffset + arrays.size();
+    const quint64 size = stringsOffset + strings.size();
+    if (size > std::numeric_limits<quint32>::max())
+        return QByteArray();
+    header.stringsOffset = quint32(stringsOffset);
+    header.stringsSize = quint32(strings.size());
+    header.stampOffset = stamp.offset;
+    header.stampSize = stamp.size;
+    header.size = quint32(size);
+    for (Zone &zone : zones) {
+        zone.transitionsOffset += arraysOffset;
+        zone.rulesOffset += arraysOffset;
+        zone.abbreviationsOffset += arraysOffset;
+    }
+
+    QByteArray result;
+    result.reserve(size);
+    result.append(reinterpret_cast<const char *>(&header), sizeof(header));
+    result.append(reinterpret_cast<const char *>(zones.data()), zones.size() * sizeof(Zone));
+    result.append(arraysOffset - result.size(), '\0');
+    result += arrays;
+    result += strings;
+    Q_ASSERT(result.size() == qsizetype(size));
+    return result;
+}
+
+QByteArrayView QTzDatabase::stamp() const
+{
+    if (!isValid())
+        return QByteArrayView();
+    const auto *header = reinterpret_cast<const Header *>(m_data.data());
+    return QByteArrayView(m_data.data() + header->stringsOffset + header->stampOffset,
+                          header->stampSize);
+}
+
+QSpan<const QTzDatabase::Zone> QTzDatabase::zones() const
+{
+    if (!isValid())
+        return {};
+    const auto *header = reinterpret_cast<const Header *>(m_data.data());
+    return QSpan(reinterpret_cast<const Zone *>(m_data.data() + header->zonesOffset),
+                 header->zoneCount);
+}
+
+// Refers to the data, without copying it
+QByteArray QTzDatabase::string(StringRef ref) const
+{
+    const auto *header = reinterpret_cast<const Header *>(m_data.data());
+    return QByteArray::fromRawData(m_data.data() + header->stringsOffset + ref.offset, ref.size);
+}
+
+const QTzDatabase::Zone *QTzDatabase::findZone(QByteArrayView ianaId) const
+{
+    const QSpan<const Zone> all = zones();
+    const auto it = std::lower_bound(all.begin(), all.end(), ianaId,
+                                     [this](const Zone &zone, QByteArrayView id) {
+        return QByteArrayView(string(zone.id)) < id;
+    });
+    return it != all.end() && string(it->id) == ianaId ? &*it : nullptr;
+}
+
+std::optional<QTzTimeZoneCacheEntry> QTzDatabase::entry(QByteArrayView ianaId) const
+{
+    const Zone *zone = findZone(ianaId);
+    if (!zone)
+        return std::nullopt;
+
+    QTzTimeZoneCacheEntry ret;
+    const auto at = [this](quint32 offset) { return m_data.data() + offset; };
+    ret.m_tranTimes = QList<QTzTransitionTime>(QArrayDataPointer<QTzTransitionTime>::fromRawData(
+            reinterpret_cast<const QTzTransitionTime *>(at(zone->transitionsOffset)),
+            zone->transitionCount));
+    ret.m_tranRules = QList<QTzTransitionRule>(QArrayDataPointer<QTzTransitionRule>::fromRawData(
+            reinterpret_cast<const QTzTransitionRule *>(at(zone->rulesOffset)),
+            zone->ruleCount));
+    const QSpan abbreviations(reinterpret_cast<const StringRef *>(at(zone->abbreviationsOffset)),
+                              zone->abbreviationCount);
+    ret.m_abbreviations.reserve(abbreviations.size());
+    for (StringRef abbreviation : abbreviations)
+        ret.m_abbreviations.append(string(abbreviation));
+    ret.m_posixRule = string(zone->posixRule);
+    ret.m_preZoneRule = zone->preZoneRule;
+    ret.m_hasDst = zone->hasDst;
+    return ret;
+}
+
+QLocale::Territory QTzDatabase::territory(QByteArrayView ianaId) const
+{
+    const Zone *zone = findZone(ianaId);
+    return zone ? QLocale::Territory(zone->territory) : QLocale::AnyTerritory;
+}
+
+QByteArray QTzDatabase::comment(QByteArrayView ianaId) const
+{
+    const Zone *zone = findZone(ianaId);
+    return zone ? string(zone->comment) : QByteArray();
+}
+
+QList<QByteArray> QTzDatabase::availableTimeZoneIds() const
+{
+    QList<QByteArray> result;
+    result.reserve(zones().size());
+    for (const Zone &zone : zones())
+        result.append(string(zone.id));
+    return result;
+}
+
+QList<QByteArray> QTzDatabase::availableTimeZoneIds(QLocale::Territory territory) const
+{
+    QList<QByteArray> result;
+    for (const Zone &zone : zones()) {
+        if (zone.territory == territory)
+            result.append(string(zone.id));
+    }
+    return result;
+}
+
+/*
+    The database of the process. It is shared between processes through a
+    file, $QT_TIMEZONE_DATABASE if set, or else one in the generic cache
+    location, which is compiled when it is missing or out of date.
+
+    Neither the mapping nor the fallback copy in memory are ever freed, as
+    time zones in other global statics may outlive this one.
+*/
+static QByteArrayView mapTzDatabaseFile(const QString &path)
+{
+    const QByteArray nativePath = QFile::encodeName(path);
+    const int fd = qt_safe_open(nativePath.constData(), O_RDONLY);
+    if (fd < 0)
+        return QByteArrayView();
+    QT_STATBUF st;
+    void *mapping = MAP_FAILED;
+    if (QT_FSTAT(fd, &st) == 0 && st.st_size > 0)
+        mapping = QT_MMAP(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    qt_safe_close(fd);
+    if (mapping == MAP_FAILED)
+        return QByteArrayView();
+    return QByteArrayView(static_cast<const char *>(mapping), qsizetype(st.st_size));
+}
+
+static QTzDatabase loadTzDatabase()
+{
+    const QByteArray stamp = QTzDatabase::sourceStamp();
+    if (stamp.isEmpty())
+        return QTzDatabase();
+
+    QString path = qEnvironmentVariable("QT_TIMEZONE_DATABASE");
+    if (path.isEmpty()) {
+        const QString cacheDir =
+                QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+        if (!cacheDir.isEmpty()) {
+            // one file per zoneinfo directory, as $TZDIR may differ between processes
+            const QByteArray dir = stamp.left(stamp.indexOf('\n'));
+            path = cacheDir + "/qt6/qtimezone-"_L1 + QString::number(qHash(dir, 0), 16)
+                    + ".db"_L1;
+        }
+    }
+
+    if (!path.isEmpty()) {
+        const QByteArrayView mapped = mapTzDatabaseFile(path);
+        const QTzDatabase database(mapped);
+        if (database.isValid() && database.stamp() == stamp)
+            return database;
+        if (!mapped.isEmpty())
+            munmap(const_cast<char *>(mapped.data()), size_t(mapped.size()));
+    }
+
+    const QByteArray compiled = QTzDatabase::compile(stamp);
+    if (compiled.isEmpty())
+        return QTzDatabase();
+#if QT_CONFIG(temporaryfile)
+    if (!path.isEmpty() && QDir().mkpath(QFileInfo(path).absolutePath())) {
+        // other processes may compile it at the same time; the last one wins
+        QSaveFile file(path);
+        if (file.open(QIODevice::WriteOnly) && file.write(compiled) == compiled.size()
+            && file.commit()) {
+            const QTzDatabase database(mapTzDatabaseFile(path));
+            if (database.isValid() && database.stamp() == stamp)
+                return database;
+        }
+    }
+#endif
+    // QByteArray's data is not aligned for the transition times on all platforms
+    auto *copy = new quint64[(compiled.size() + sizeof(quint64) - 1) / sizeof(quint64)];
+    memcpy(copy, compiled.constData(), compiled.size());
+    return QTzDatabase(QByteArrayView(reinterpret_cast<const char *>(copy), compiled.size()));
+}
+
+Q_GLOBAL_STATIC(const QTzDatabase, tzDatabase, loadTzDatabase());
+
 // Create a named time zone
 QTzTimeZonePrivate::QTzTimeZonePrivate(const QByteArray &ianaId)
 {
     if (!isTimeZoneIdAvailable(ianaId)) // Avoid pointlessly creating cache entries
         return;
-    static QTzTimeZoneCache tzCache;
-    auto entry = tzCache.fetchEntry(ianaId);
+    // Zones of the database refer to its data; only the system zone read from
+    // /etc/localtime and POSIX rules need parsing and caching
+    std::optional<QTzTimeZoneCacheEntry> found = tzDatabase->entry(ianaId);
+    if (!found) {
+        static QTzTimeZoneCache tzCache;
+        found = tzCache.fetchEntry(ianaId);
+    }
+    QTzTimeZoneCacheEntry &entry = *found;
     if (entry.m_tranTimes.isEmpty() && entry.m_posixRule.isEmpty())
         return; // Invalid after all !
 
@@ -1010,12 +1434,12 @@ QTzTimeZonePrivate::QTzTimeZonePrivate(const QByteArray &ianaId)
 
 QLocale::Territory QTzTimeZonePrivate::territory() const
 {
-    return tzZones->value(m_id).territory;
+    return tzDatabase->territory(m_id);
 }
 
 QString QTzTimeZonePrivate::comment() const
 {
-    return QString::fromUtf8(tzZones->value(m_id).comment);
+    return QString::fromUtf8(tzDatabase->comment(m_id));
 }
 
 QString QTzTimeZonePrivate::displayName(QTimeZone::TimeType timeType,
@@ -1238,26 +1662,18 @@ bool QTzTimeZonePrivate::isTimeZoneIdAvailable(const QByteArray &ianaId) const
     // plain abbreviation, without offset, since claiming to support such zones
     // would prevent the custom QTimeZone constructor from accepting such a
     // name, as it doesn't want a custom zone to over-ride a "real" one.)
-    return tzZones->contains(ianaId) || validatePosixRule(ianaId, true).isValid;
+    return tzDatabase->contains(ianaId) || validatePosixRule(ianaId, true).isValid;
 }
 
 QList<QByteArray> QTzTimeZonePrivate::availableTimeZoneIds() const
 {
-    QList<QByteArray> result = tzZones->keys();
-    std::sort(result.begin(), result.end());
-    return result;
+    return tzDatabase->availableTimeZoneIds();
 }
 
 QList<QByteArray> QTzTimeZonePrivate::availableTimeZoneIds(QLocale::Territory territory) const
 {
     // TODO AnyTerritory
-    QList<QByteArray> result;
-    for (auto it = tzZones->cbegin(), end = tzZones->cend(); it != end; ++it) {
-        if (it.value().territory == territory)
-            result << it.key();
-    }
-    std::sort(result.begin(), result.end());
-    return result;
+    return tzDatabase->availableTimeZoneIds(territory);
 }
 
 // Getting the system zone's ID:
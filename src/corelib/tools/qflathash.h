@@ -0,0 +1,700 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QFLATHASH_H
+#define QFLATHASH_H
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qiterator.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qsimd.h>
+#include <QtCore/qtypeinfo.h>
+
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QFlatHashPrivate {
+
+// Each slot of the table has a control byte: Empty, Deleted, or, if the
+// slot holds an element, the seven low bits of its hash. Lookups compare
+// the control bytes of a group of slots at once.
+using Ctrl = qint8;
+constexpr Ctrl Empty = -128;
+constexpr Ctrl Deleted = -2;
+constexpr size_t GroupWidth = 16;
+
+inline Ctrl h2(size_t hash) noexcept { return Ctrl(hash & 0x7f); }
+inline size_t h1(size_t hash) noexcept { return hash >> 7; }
+
+struct Group
+{
+#if QT_COMPILER_USES(sse2)
+    // one bit per slot
+    using Mask = uint;
+    static constexpr int MaskShift = 0;
+
+    explicit Group(const Ctrl *p) noexcept
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)))
+    {}
+    Mask match(Ctrl h) const noexcept
+    { return uint(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h), ctrl))); }
+    Mask matchEmpty() const noexcept
+    { return match(Empty); }
+    Mask matchEmptyOrDeleted() const noexcept
+    { return uint(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl))); }
+
+    __m128i ctrl;
+#elif QT_COMPILER_USES(neon)
+    // one bit per slot, the top one of a nibble
+    using Mask = quint64;
+    static constexpr int MaskShift = 2;
+
+    explicit Group(const Ctrl *p) noexcept
+        : ctrl(vld1q_s8(p))
+    {}
+    static Mask toMask(uint8x16_t matches) noexcept
+    {
+        const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+        return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & Q_UINT64_C(0x8888888888888888);
+    }
+    Mask match(Ctrl h) const noexcept
+    { return toMask(vceqq_s8(vdupq_n_s8(h), ctrl)); }
+    Mask matchEmpty() const noexcept
+    { return match(Empty); }
+    Mask matchEmptyOrDeleted() const noexcept
+    { return toMask(vcltq_s8(ctrl, vdupq_n_s8(-1))); }
+
+    int8x16_t ctrl;
+#else
+    using Mask = uint;
+    static constexpr int MaskShift = 0;
+
+    explicit Group(const Ctrl *p) noexcept
+    { memcpy(ctrl, p, GroupWidth); }
+    Mask match(Ctrl h) const noexcept
+    {
+        Mask mask = 0;
+        for (size_t i = 0; i < GroupWidth; ++i)
+            mask |= Mask(ctrl[i] == h) << i;
+        return mask;
+    }
+    Mask matchEmpty() const noexcept
+    { return match(Empty); }
+    Mask matchEmptyOrDeleted() const noexcept
+    {
+        Mask mask = 0;
+        for (size_t i = 0; i < GroupWidth; ++i)
+            mask |= Mask(ctrl[i] < -1) << i;
+        return mask;
+    }
+
+    Ctrl ctrl[GroupWidth];
+#endif
+
+    static size_t lowestIndex(Mask mask) noexcept
+    { return size_t(qCountTrailingZeroBits(mask)) >> MaskShift; }
+};
+
+} // namespace QFlatHashPrivate
+
+template <typename Key, typename T>
+class QFlatHash
+{
+    struct Node
+    {
+        Key key;
+        T value;
+    };
+    using Ctrl = QFlatHashPrivate::Ctrl;
+    using Group = QFlatHashPrivate::Group;
+    static constexpr size_t GroupWidth = QFlatHashPrivate::GroupWidth;
+
+    template <typename K>
+    using if_heterogeneously_seachable = QHashPrivate::if_heterogeneously_seachable_with<Key, K>;
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = T;
+    using difference_type = qsizetype;
+    using size_type = qsizetype;
+    using reference = T &;
+    using const_reference = const T &;
+
+    QFlatHash() noexcept = default;
+    QFlatHash(std::initializer_list<std::pair<Key, T>> list)
+    {
+        reserve(qsizetype(list.size()));
+        for (const auto &pair : list)
+            insert(pair.first, pair.second);
+    }
+    template <typename InputIterator, QtPrivate::IfAssociativeIteratorHasKeyAndValue<InputIterator> = true>
+    QFlatHash(InputIterator f, InputIterator l)
+    {
+        QtPrivate::reserveIfForwardIterator(this, f, l);
+        for (; f != l; ++f)
+            insert(f.key(), f.value());
+    }
+    template <typename InputIterator, QtPrivate::IfAssociativeIteratorHasFirstAndSecond<InputIterator> = true>
+    QFlatHash(InputIterator f, InputIterator l)
+    {
+        QtPrivate::reserveIfForwardIterator(this, f, l);
+        for (; f != l; ++f) {
+            auto &&e = *f;
+            using V = decltype(e);
+            insert(std::forward<V>(e).first, std::forward<V>(e).second);
+        }
+    }
+
+    QFlatHash(const QFlatHash &other)
+        : used(other.used), growthLeft(other.growthLeft), seed(other.seed)
+    {
+        if (!other.numSlots)
+            return;
+        allocate(other.numSlots);
+        // Same seed and same slots: every element goes where it was
+        memcpy(ctrl, other.ctrl, numSlots + GroupWidth);
+        size_t i = 0;
+        QT_TRY {
+            for (; i < numSlots; ++i) {
+                if (ctrl[i] >= 0)
+                    new (nodes + i) Node(other.nodes[i]);
+            }
+        } QT_CATCH(...) {
+            while (i--) {
+                if (ctrl[i] >= 0)
+                    nodes[i].~Node();
+            }
+            deallocate();
+            QT_RETHROW;
+        }
+    }
+    QFlatHash(QFlatHash &&other) noexcept
+        : ctrl(std::exchange(other.ctrl, nullptr)),
+          nodes(std::exchange(other.nodes, nullptr)),
+          numSlots(std::exchange(other.numSlots, 0)),
+          used(std::exchange(other.used, 0)),
+          growthLeft(std::exchange(other.growthLeft, 0)),
+          seed(other.seed)
+    {}
+    QFlatHash &operator=(const QFlatHash &other)
+    {
+        if (this != &other)
+            QFlatHash(other).swap(*this);
+        return *this;
+    }
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_MOVE_AND_SWAP(QFlatHash)
+    ~QFlatHash()
+    {
+        destroyAll();
+        deallocate();
+    }
+
+    void swap(QFlatHash &other) noexcept
+    {
+        qt_ptr_swap(ctrl, other.ctrl);
+        qt_ptr_swap(nodes, other.nodes);
+        std::swap(numSlots, other.numSlots);
+        std::swap(used, other.used);
+        std::swap(growthLeft, other.growthLeft);
+        std::swap(seed, other.seed);
+    }
+
+#ifndef Q_QDOC
+    template <typename AKey = Key, typename AT = T>
+    QTypeTraits::compare_eq_result_container<QFlatHash, AKey, AT> operator==(const QFlatHash &other) const
+    {
+        if (used != other.used)
+            return false;
+        for (const_iterator it = begin(); it != end(); ++it) {
+            const Node *n = other.findNode(it.key());
+            if (!n || !(n->value == it.value()))
+                return false;
+        }
+        return true;
+    }
+    template <typename AKey = Key, typename AT = T>
+    QTypeTraits::compare_eq_result_container<QFlatHash, AKey, AT> operator!=(const QFlatHash &other) const
+    { return !(*this == other); }
+#else
+    bool operator==(const QFlatHash &other) const;
+    bool operator!=(const QFlatHash &other) const;
+#endif // Q_QDOC
+
+    qsizetype size() const noexcept { return used; }
+    qsizetype count() const noexcept { return used; }
+    [[nodiscard]] bool isEmpty() const noexcept { return used == 0; }
+    [[nodiscard]] bool empty() const noexcept { return used == 0; }
+    qsizetype capacity() const noexcept { return qsizetype(maxLoad(numSlots)); }
+
+    void reserve(qsizetype size)
+    {
+        if (size > capacity())
+            rehash(slotsForSize(size_t(size)));
+    }
+    void squeeze()
+    {
+        if (!used) {
+            clear();
+            deallocate();
+            return;
+        }
+        const size_t slotCount = slotsForSize(size_t(used));
+        if (slotCount < numSlots)
+            rehash(slotCount);
+    }
+    void clear() noexcept(std::is_nothrow_destructible_v<Node>)
+    {
+        if (!numSlots)
+            return;
+        destroyAll();
+        memset(ctrl, QFlatHashPrivate::Empty, numSlots + GroupWidth);
+        used = 0;
+        growthLeft = maxLoad(numSlots);
+    }
+
+    bool remove(const Key &key) { return removeImpl(key); }
+    T take(const Key &key) { return takeImpl(key); }
+
+    bool contains(const Key &key) const noexcept { return findNode(key) != nullptr; }
+    qsizetype count(const Key &key) const noexcept { return contains(key) ? 1 : 0; }
+
+    T value(const Key &key) const noexcept
+    {
+        const Node *n = findNode(key);
+        return n ? n->value : T();
+    }
+    T value(const Key &key, const T &defaultValue) const noexcept
+    {
+        const Node *n = findNode(key);
+        return n ? n->value : defaultValue;
+    }
+
+    T &operator[](const Key &key) { return nodes[tryEmplaceImpl(key).first].value; }
+    const T operator[](const Key &key) const noexcept { return value(key); }
+
+    QList<Key> keys() const
+    {
+        QList<Key> result;
+        result.reserve(used);
+        for (const_iterator it = begin(); it != end(); ++it)
+            result.append(it.key());
+        return result;
+    }
+    QList<T> values() const
+    {
+        QList<T> result;
+        result.reserve(used);
+        for (const_iterator it = begin(); it != end(); ++it)
+            result.append(it.value());
+        return result;
+    }
+
+    class const_iterator;
+
+    class iterator
+    {
+        friend class const_iterator;
+        friend class QFlatHash<Key, T>;
+        QFlatHash *h = nullptr;
+        size_t i = 0;
+        iterator(QFlatHash *h, size_t i) noexcept : h(h), i(i) {}
+        Node *node() const noexcept { return h->nodes + i; }
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef T *pointer;
+        typedef T &reference;
+
+        constexpr iterator() noexcept = default;
+
+        const Key &key() const noexcept { return node()->key; }
+        T &value() const noexcept { return node()->value; }
+        T &operator*() const noexcept { return node()->value; }
+        T *operator->() const noexcept { return &node()->value; }
+        bool operator==(const iterator &o) const noexcept { return i == o.i && h == o.h; }
+        bool operator!=(const iterator &o) const noexcept { return !(*this == o); }
+
+        iterator &operator++() noexcept
+        {
+            i = h->nextFull(i + 1);
+            return *this;
+        }
+        iterator operator++(int) noexcept
+        {
+            iterator r = *this;
+            ++*this;
+            return r;
+        }
+
+        bool operator==(const const_iterator &o) const noexcept { return i == o.i && h == o.h; }
+        bool operator!=(const const_iterator &o) const noexcept { return !(*this == o); }
+    };
+    friend class iterator;
+
+    class const_iterator
+    {
+        friend class iterator;
+        friend class QFlatHash<Key, T>;
+        const QFlatHash *h = nullptr;
+        size_t i = 0;
+        const_iterator(const QFlatHash *h, size_t i) noexcept : h(h), i(i) {}
+        const Node *node() const noexcept { return h->nodes + i; }
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        constexpr const_iterator() noexcept = default;
+        const_iterator(const iterator &o) noexcept : h(o.h), i(o.i) {}
+
+        const Key &key() const noexcept { return node()->key; }
+        const T &value() const noexcept { return node()->value; }
+        const T &operator*() const noexcept { return node()->value; }
+        const T *operator->() const noexcept { return &node()->value; }
+        bool operator==(const const_iterator &o) const noexcept { return i == o.i && h == o.h; }
+        bool operator!=(const const_iterator &o) const noexcept { return !(*this == o); }
+
+        const_iterator &operator++() noexcept
+        {
+            i = h->nextFull(i + 1);
+            return *this;
+        }
+        const_iterator operator++(int) noexcept
+        {
+            const_iterator r = *this;
+            ++*this;
+            return r;
+        }
+    };
+    friend class const_iterator;
+
+    typedef QKeyValueIterator<const Key&, const T&, const_iterator> const_key_value_iterator;
+    typedef QKeyValueIterator<const Key&, T&, iterator> key_value_iterator;
+
+    // STL style
+    iterator begin() noexcept { return iterator(this, nextFull(0)); }
+    const_iterator begin() const noexcept { return const_iterator(this, nextFull(0)); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator constBegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator(this, numSlots); }
+    const_iterator end() const noexcept { return const_iterator(this, numSlots); }
+    const_iterator cend() const noexcept { return end(); }
+    const_iterator constEnd() const noexcept { return end(); }
+    key_value_iterator keyValueBegin() noexcept { return key_value_iterator(begin()); }
+    key_value_iterator keyValueEnd() noexcept { return key_value_iterator(end()); }
+    const_key_value_iterator keyValueBegin() const noexcept { return const_key_value_iterator(begin()); }
+    const_key_value_iterator constKeyValueBegin() const noexcept { return const_key_value_iterator(begin()); }
+    const_key_value_iterator keyValueEnd() const noexcept { return const_key_value_iterator(end()); }
+    const_key_value_iterator constKeyValueEnd() const noexcept { return const_key_value_iterator(end()); }
+    auto asKeyValueRange() & { return QtPrivate::QKeyValueRange(*this); }
+    auto asKeyValueRange() const & { return QtPrivate::QKeyValueRange(*this); }
+    auto asKeyValueRange() && { return QtPrivate::QKeyValueRange(std::move(*this)); }
+    auto asKeyValueRange() const && { return QtPrivate::QKeyValueRange(std::move(*this)); }
+
+    iterator erase(const_iterator it)
+    {
+        Q_ASSERT(it.h == this);
+        Q_ASSERT(it.i < numSlots && ctrl[it.i] >= 0);
+        eraseAt(it.i);
+        return iterator(this, nextFull(it.i + 1));
+    }
+
+    iterator find(const Key &key) { return findImpl(key); }
+    const_iterator find(const Key &key) const noexcept { return constFindImpl(key); }
+    const_iterator constFind(const Key &key) const noexcept { return constFindImpl(key); }
+
+    iterator insert(const Key &key, const T &value) { return emplace(key, value); }
+    void insert(const QFlatHash &other)
+    {
+        if (this == &other)
+            return;
+        reserve(used + other.used);
+        for (const_iterator it = other.begin(); it != other.end(); ++it)
+            emplace(it.key(), it.value());
+    }
+
+    template <typename ...Args>
+    iterator emplace(const Key &key, Args &&... args)
+    { return emplaceImpl(key, std::forward<Args>(args)...); }
+    template <typename ...Args>
+    iterator emplace(Key &&key, Args &&... args)
+    { return emplaceImpl(std::move(key), std::forward<Args>(args)...); }
+
+    // Heterogeneous lookup, as with QHash
+    template <typename K, if_heterogeneously_seachable<K> = true>
+    bool remove(const K &key) { return removeImpl(key); }
+    template <typename K, if_heterogeneously_seachable<K> = true>
+    T take(const K &key) { return takeImpl(key); }
+    template <typename K, if_heterogeneously_seachable<K> = true>
+    bool contains(const K &key) const noexcept { return findNode(key) != nullptr; }
+    template <typename K, if_heterogeneously_seachable<K> = true>
+    qsizetype count(const K &key) const noexcept { return contains(key) ? 1 : 0; }
+    template <typename K, if_heterogeneously_seachable<K> = true>
+    T value(const K &key) const noexcept
+    {
+        const Node *n = findNode(key);
+        return n ? n->value : T();
+    }
+    template <typename K, if_heterogeneously_seachable<K> = true>
+    T value(const K &key, const T &defaultValue) const noexcept
+    {
+        const Node *n = findNode(key);
+        return n ? n->value : defaultValue;
+    }
+    template <typename K, if_heterogeneously_seachable<K> = true>
+    iterator find(const K &key) { return findImpl(key); }
+    template <typename K, if_heterogeneously_seachable<K> = true>
+    const_iterator find(const K &key) const noexcept { return constFindImpl(key); }
+    template <typename K, if_heterogeneously_seachable<K> = true>
+    const_iterator constFind(const K &key) const noexcept { return constFindImpl(key); }
+
+private:
+    static constexpr size_t maxLoad(size_t slotCount) noexcept { return slotCount - slotCount / 8; }
+    static size_t slotsForSize(size_t size) noexcept
+    {
+        size_t slotCount = GroupWidth;
+        while (maxLoad(slotCount) < size)
+            slotCount *= 2;
+        return slotCount;
+    }
+
+    void allocate(size_t slotCount)
+    {
+        void *memory = ::operator new(slotCount * sizeof(Node) + slotCount + GroupWidth,
+                                      std::align_val_t(alignof(Node)));
+        nodes = static_cast<Node *>(memory);
+        ctrl = reinterpret_cast<Ctrl *>(static_cast<char *>(memory) + slotCount * sizeof(Node));
+        numSlots = slotCount;
+    }
+    void deallocate() noexcept
+    {
+        if (nodes)
+            ::operator delete(nodes, std::align_val_t(alignof(Node)));
+        nodes = nullptr;
+        ctrl = nullptr;
+        numSlots = 0;
+        growthLeft = 0;
+    }
+    void destroyAll() noexcept(std::is_nothrow_destructible_v<Node>)
+    {
+        if constexpr (!std::is_trivially_destructible_v<Node>) {
+            for (size_t i = 0; i < numSlots; ++i) {
+                if (ctrl[i] >= 0)
+                    nodes[i].~Node();
+            }
+        }
+    }
+
+    size_t nextFull(size_t i) const noexcept
+    {
+        while (i < numSlots && ctrl[i] < 0)
+            ++i;
+        return i;
+    }
+
+    void setCtrl(size_t i, Ctrl c) noexcept
+    {
+        ctrl[i] = c;
+        // the bytes after the end mirror the first group, so that a group
+        // can be loaded from any slot
+        if (i < GroupWidth)
+            ctrl[numSlots + i] = c;
+    }
+
+    template <typename K>
+    Node *findNode(const K &key, size_t hash) const noexcept
+    {
+        const size_t mask = numSlots - 1;
+        const Ctrl h2 = QFlatHashPrivate::h2(hash);
+        size_t pos = QFlatHashPrivate::h1(hash) & mask;
+        // triangular probing visits every group once the table is a power
+        // of two number of groups
+        for (size_t step = GroupWidth; ; step += GroupWidth) {
+            const Group group(ctrl + pos);
+            for (auto matches = group.match(h2); matches; matches &= matches - 1) {
+                const size_t i = (pos + Group::lowestIndex(matches)) & mask;
+                if (qHashEquals(nodes[i].key, key))
+                    return nodes + i;
+            }
+            if (group.matchEmpty())
+                return nullptr;
+            pos = (pos + step) & mask;
+        }
+    }
+    template <typename K>
+    Node *findNode(const K &key) const noexcept
+    {
+        if (!used)
+            return nullptr;
+        return findNode(key, QHashPrivate::calculateHash(key, seed));
+    }
+
+    // The first slot that an element with this hash can be inserted into.
+    // There always is one, as the table is never full.
+    size_t findInsertSlot(size_t hash) const noexcept
+    {
+        const size_t mask = numSlots - 1;
+        size_t pos = QFlatHashPrivate::h1(hash) & mask;
+        for (size_t step = GroupWidth; ; step += GroupWidth) {
+            const Group group(ctrl + pos);
+            if (const auto matches = group.matchEmptyOrDeleted())
+                return (pos + Group::lowestIndex(matches)) & mask;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    // Grows the table, or, if it mostly contains deleted slots, cleans it
+    // up, so that an element can be inserted
+    void growForInsert()
+    {
+        if (!numSlots)
+            rehash(GroupWidth);
+        else
+            rehash(size_t(used) * 32 > numSlots * 25 ? numSlots * 2 : numSlots);
+    }
+
+    void rehash(size_t slotCount)
+    {
+        Q_ASSERT(maxLoad(slotCount) >= size_t(used));
+        Ctrl *oldCtrl = ctrl;
+        Node *oldNodes = nodes;
+        const size_t oldSlots = numSlots;
+        allocate(slotCount);
+        memset(ctrl, QFlatHashPrivate::Empty, slotCount + GroupWidth);
+        if (!oldNodes)
+            seed = QHashSeed::globalSeed();
+        for (size_t i = 0; i < oldSlots; ++i) {
+            if (oldCtrl[i] < 0)
+                continue;
+            Node &node = oldNodes[i];
+            const size_t hash = QHashPrivate::calculateHash(node.key, seed);
+            const size_t target = findInsertSlot(hash);
+            if constexpr (QTypeInfo<Key>::isRelocatable && QTypeInfo<T>::isRelocatable) {
+                memcpy(static_cast<void *>(nodes + target), static_cast<const void *>(&node),
+                       sizeof(Node));
+            } else {
+                new (nodes + target) Node(std::move(node));
+                node.~Node();
+            }
+            setCtrl(target, QFlatHashPrivate::h2(hash));
+        }
+        growthLeft = maxLoad(slotCount) - size_t(used);
+        if (oldNodes)
+            ::operator delete(oldNodes, std::align_val_t(alignof(Node)));
+    }
+
+    // Returns the slot of key, and whether it was inserted, constructing
+    // the value from args in that case
+    template <typename K, typename ...Args>
+    std::pair<size_t, bool> tryEmplaceImpl(K &&key, Args &&... args)
+    {
+        if (!numSlots)
+            growForInsert();
+        const size_t hash = QHashPrivate::calculateHash(key, seed);
+        if (used) {
+            if (Node *n = findNode(key, hash))
+                return { size_t(n - nodes), false };
+        }
+        size_t i = findInsertSlot(hash);
+        if (growthLeft == 0 && ctrl[i] != QFlatHashPrivate::Deleted) {
+            // args may refer to an element that growing moves
+            T value(std::forward<Args>(args)...);
+            growForInsert();
+            i = findInsertSlot(hash);
+            new (nodes + i) Node{ Key(std::forward<K>(key)), std::move(value) };
+        } else {
+            new (nodes + i) Node{ Key(std::forward<K>(key)), T(std::forward<Args>(args)...) };
+        }
+        if (ctrl[i] == QFlatHashPrivate::Empty)
+            --growthLeft;
+        setCtrl(i, QFlatHashPrivate::h2(hash));
+        ++used;
+        return { i, true };
+    }
+
+    template <typename K, typename ...Args>
+    iterator emplaceImpl(K &&key, Args &&... args)
+    {
+        const auto [i, inserted] = tryEmplaceImpl(std::forward<K>(key), std::forward<Args>(args)...);
+        if (!inserted)
+            nodes[i].value = T(std::forward<Args>(args)...);
+        return iterator(this, i);
+    }
+
+    void eraseAt(size_t i)
+    {
+        nodes[i].~Node();
+        --used;
+        if (!used) {
+            // nothing to probe past any more
+            memset(ctrl, QFlatHashPrivate::Empty, numSlots + GroupWidth);
+            growthLeft = maxLoad(numSlots);
+            return;
+        }
+        // Lookups must continue probing past the slot, unless the group
+        // starting at it has an empty slot anyway
+        setCtrl(i, QFlatHashPrivate::Deleted);
+    }
+
+    template <typename K>
+    bool removeImpl(const K &key)
+    {
+        Node *n = findNode(key);
+        if (!n)
+            return false;
+        eraseAt(size_t(n - nodes));
+        return true;
+    }
+    template <typename K>
+    T takeImpl(const K &key)
+    {
+        Node *n = findNode(key);
+        if (!n)
+            return T();
+        T value = std::move(n->value);
+        eraseAt(size_t(n - nodes));
+        return value;
+    }
+    template <typename K>
+    iterator findImpl(const K &key) noexcept
+    {
+        Node *n = findNode(key);
+        return iterator(this, n ? size_t(n - nodes) : numSlots);
+    }
+    template <typename K>
+    const_iterator constFindImpl(const K &key) const noexcept
+    {
+        const Node *n = findNode(key);
+        return const_iterator(this, n ? size_t(n - nodes) : numSlots);
+    }
+
+    Ctrl *ctrl = nullptr;
+    Node *nodes = nullptr;
+    size_t numSlots = 0;        // 0, or a power of two >= GroupWidth
+    qsizetype used = 0;
+    size_t growthLeft = 0;      // empty slots that can be used before growing
+    size_t seed = 0;
+};
+
+template <typename Key, typename T>
+void swap(QFlatHash<Key, T> &lhs, QFlatHash<Key, T> &rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+QT_END_NAMESPACE
+
+#endif // QFLATHASH_H
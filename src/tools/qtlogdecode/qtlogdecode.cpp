@@ -0,0 +1,185 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QFile>
+
+#include <private/qstructuredlog_p.h>
+
+#include <stdio.h>
+
+QT_USE_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+static const char defaultPattern[] = "%{if-category}%{category}: %{endif}%{message}";
+
+static QLatin1StringView typeName(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg: return "debug"_L1;
+    case QtInfoMsg: return "info"_L1;
+    case QtWarningMsg: return "warning"_L1;
+    case QtCriticalMsg: return "critical"_L1;
+    case QtFatalMsg: return "fatal"_L1;
+    }
+    return "unknown"_L1;
+}
+
+/*
+    Expands the placeholders of the message pattern syntax of
+    qSetMessagePattern() that can be derived from a recorded message. The
+    time stamps refer to the time the message was logged, not the time it
+    is decoded.
+*/
+class PatternFormatter
+{
+public:
+    explicit PatternFormatter(const QString &pattern) : pattern(pattern) {}
+
+    QString format(const QStructuredLogRecord &record, const QStructuredLogReader &reader) const;
+
+private:
+    bool condition(QStringView name, const QStructuredLogRecord &record) const;
+    QString placeholder(QStringView name, QStringView argument,
+                        const QStructuredLogRecord &record,
+                        const QStructuredLogReader &reader) const;
+
+    QString pattern;
+};
+
+bool PatternFormatter::condition(QStringView name, const QStructuredLogRecord &record) const
+{
+    if (name == "category"_L1)
+        return !record.category.isEmpty() && record.category != "default";
+    return name == typeName(record.type);
+}
+
+QString PatternFormatter::placeholder(QStringView name, QStringView argument,
+                                      const QStructuredLogRecord &record,
+                                      const QStructuredLogReader &reader) const
+{
+    if (name == "message"_L1)
+        return record.message();
+    if (name == "type"_L1)
+        return typeName(record.type);
+    if (name == "category"_L1)
+        return QString::fromUtf8(record.category);
+    if (name == "file"_L1)
+        return record.file.isNull() ? u"unknown"_s : QString::fromUtf8(record.file);
+    if (name == "line"_L1)
+        return QString::number(record.line);
+    if (name == "function"_L1)
+        return record.function.isNull() ? u"unknown"_s : QString::fromUtf8(record.function);
+    if (name == "pid"_L1)
+        return QString::number(reader.processId());
+    if (name == "threadid"_L1)
+        return QString::number(record.threadId);
+    if (name == "time"_L1) {
+        const qint64 msecs = record.timestamp / 1000000;
+        if (argument == "process"_L1 || argument == "boot"_L1)
+            return QString::asprintf("%6lld.%03lld", msecs / 1000, msecs % 1000);
+        const QDateTime time = QDateTime::fromMSecsSinceEpoch(reader.startTime() + msecs);
+        if (argument.isEmpty())
+            return time.toString(Qt::ISODateWithMs);
+        return time.toString(argument);
+    }
+    return u"%{"_s + name.toString() + u'}';
+}
+
+QString PatternFormatter::format(const QStructuredLogRecord &record,
+                                 const QStructuredLogReader &reader) const
+{
+    QString result;
+    bool skipping = false;
+    qsizetype i = 0;
+    while (i < pattern.size()) {
+        const qsizetype start = pattern.indexOf("%{"_L1, i);
+        const qsizetype end = start < 0 ? -1 : pattern.indexOf(u'}', start);
+        if (end < 0) {
+            if (!skipping)
+                result += QStringView(pattern).mid(i);
+            break;
+        }
+        if (!skipping)
+            result += QStringView(pattern).mid(i, start - i);
+        i = end + 1;
+
+        QStringView name = QStringView(pattern).mid(start + 2, end - start - 2);
+        QStringView argument;
+        if (const qsizetype space = name.indexOf(u' '); space >= 0) {
+            argument = name.mid(space + 1);
+            name = name.first(space);
+        }
+        if (name.startsWith("if-"_L1)) {
+            skipping = !condition(name.sliced(3), record);
+        } else if (name == "endif"_L1) {
+            skipping = false;
+        } else if (!skipping) {
+            result += placeholder(name, argument, record, reader);
+        }
+    }
+    return result;
+}
+
+static int decode(const QString &fileName, const PatternFormatter &formatter)
+{
+    QFile file;
+    const bool opened = fileName == "-"_L1
+            ? file.open(stdin, QIODevice::ReadOnly)
+            : (file.setFileName(fileName), file.open(QIODevice::ReadOnly));
+    if (!opened) {
+        fprintf(stderr, "Cannot open %s: %s\n", qPrintable(fileName),
+                qPrintable(file.errorString()));
+        return 1;
+    }
+
+    QStructuredLogReader reader(&file);
+    QStructuredLogRecord record;
+    while (reader.readNext(&record))
+        fprintf(stdout, "%s\n", formatter.format(record, reader).toLocal8Bit().constData());
+    if (reader.hasError()) {
+        fprintf(stderr, "%s: not a valid structured log file\n", qPrintable(fileName));
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName(u"qtlogdecode"_s);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+            u"Prints the messages recorded in the structured log files written "
+            "by Qt applications run with QT_LOGGING_STRUCTURED."_s);
+    parser.addHelpOption();
+    QCommandLineOption patternOption(u"pattern"_s,
+            u"Format the messages with <pattern>, using the syntax of "
+            "QT_MESSAGE_PATTERN (default: the value of QT_MESSAGE_PATTERN)."_s,
+            u"pattern"_s);
+    parser.addOption(patternOption);
+    parser.addPositionalArgument(u"files"_s, u"The structured log files, or - for stdin."_s,
+                                 u"files..."_s);
+    parser.process(app);
+
+    const QStringList files = parser.positionalArguments();
+    if (files.isEmpty())
+        parser.showHelp(1);
+
+    QString pattern = parser.value(patternOption);
+    if (!parser.isSet(patternOption)) {
+        pattern = qEnvironmentVariable("QT_MESSAGE_PATTERN");
+        if (pattern.isEmpty())
+            pattern = QLatin1StringView(defaultPattern);
+    }
+    const PatternFormatter formatter(pattern);
+
+    int exitCode = 0;
+    for (const QString &fileName : files)
+        exitCode |= decode(fileName, formatter);
+    return exitCode;
+}
@@ -0,0 +1,259 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <qtconcurrentalgorithms.h>
+
+#include <QRandomGenerator>
+#include <QTest>
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+
+// An associative, but not commutative operation
+struct Matrix
+{
+    quint32 a = 1, b = 0, c = 0, d = 1;
+
+    friend Matrix operator*(const Matrix &l, const Matrix &r)
+    {
+        return { l.a * r.a + l.b * r.c, l.a * r.b + l.b * r.d,
+                 l.c * r.a + l.d * r.c, l.c * r.b + l.d * r.d };
+    }
+    friend bool operator==(const Matrix &l, const Matrix &r)
+    {
+        return l.a == r.a && l.b == r.b && l.c == r.c && l.d == r.d;
+    }
+};
+
+static QList<int> randomValues(qsizetype count, int bound)
+{
+    QList<int> values(count);
+    QRandomGenerator random(count);
+    for (int &value : values)
+        value = random.bounded(bound);
+    return values;
+}
+
+static QList<Matrix> randomMatrices(qsizetype count)
+{
+    QList<Matrix> matrices(count);
+    QRandomGenerator random(count);
+    for (Matrix &matrix : matrices)
+        matrix = { random.generate(), random.generate(), random.generate(), random.generate() };
+    return matrices;
+}
+
+class tst_QtConcurrentAlgorithms : public QObject
+{
+    Q_OBJECT
+public:
+    tst_QtConcurrentAlgorithms()
+    {
+        // Split the work into several blocks even on a single core
+        pool.setMaxThreadCount(4);
+    }
+
+private slots:
+    void sort_data();
+    void sort();
+    void sortStable();
+    void sortMoveOnly();
+    void inclusiveScan_data() { sort_data(); }
+    void inclusiveScan();
+    void exclusiveScan_data() { sort_data(); }
+    void exclusiveScan();
+    void partition_data() { sort_data(); }
+    void partition();
+    void transformReduce_data() { sort_data(); }
+    void transformReduce();
+    void cancel();
+
+private:
+    QThreadPool pool;
+};
+
+void tst_QtConcurrentAlgorithms::sort_data()
+{
+    QTest::addColumn<qsizetype>("count");
+
+    QTest::newRow("empty") << qsizetype(0);
+    QTest::newRow("one") << qsizetype(1);
+    QTest::newRow("one block") << qsizetype(1000);
+    QTest::newRow("two blocks") << qsizetype(9000);
+    QTest::newRow("three blocks") << qsizetype(13000);
+    QTest::newRow("nine blocks") << qsizetype(40000);
+    QTest::newRow("sixteen blocks") << qsizetype(100000);
+}
+
+void tst_QtConcurrentAlgorithms::sort()
+{
+    QFETCH(qsizetype, count);
+
+    const QList<int> values = randomValues(count, 1000);
+    QList<int> expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    QList<int> sorted = values;
+    QtConcurrent::sort(&pool, sorted).waitForFinished();
+    QCOMPARE(sorted, expected);
+
+    sorted = values;
+    QtConcurrent::blockingSort(&pool, sorted.begin(), sorted.end(), std::greater<>());
+    std::reverse(expected.begin(), expected.end());
+    QCOMPARE(sorted, expected);
+
+    std::vector<int> vector(values.cbegin(), values.cend());
+    QtConcurrent::blockingSort(vector);
+    QVERIFY(std::is_sorted(vector.cbegin(), vector.cend()));
+}
+
+void tst_QtConcurrentAlgorithms::sortStable()
+{
+    const QList<int> values = randomValues(50000, 100);
+    QList<std::pair<int, int>> pairs;
+    for (int i = 0; i < values.size(); ++i)
+        pairs.emplace_back(values.at(i), i);
+    const auto byKey = [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; };
+
+    QList<std::pair<int, int>> expected = pairs;
+    std::stable_sort(expected.begin(), expected.end(), byKey);
+    QtConcurrent::blockingSort(&pool, pairs, byKey);
+    QCOMPARE(pairs, expected);
+}
+
+void tst_QtConcurrentAlgorithms::sortMoveOnly()
+{
+    const QList<int> values = randomValues(30000, 1000000);
+    std::vector<std::unique_ptr<int>> pointers;
+    for (int value : values)
+        pointers.push_back(std::make_unique<int>(value));
+
+    QtConcurrent::blockingSort(&pool, pointers, [](const auto &lhs, const auto &rhs) {
+        return *lhs < *rhs;
+    });
+
+    QList<int> expected = values;
+    std::sort(expected.begin(), expected.end());
+    QCOMPARE(qsizetype(pointers.size()), expected.size());
+    for (qsizetype i = 0; i < expected.size(); ++i)
+        QCOMPARE(*pointers[i], expected.at(i));
+}
+
+void tst_QtConcurrentAlgorithms::inclusiveScan()
+{
+    QFETCH(qsizetype, count);
+
+    const QList<int> values = randomValues(count, 1000);
+    QList<qint64> sums(values.cbegin(), values.cend());
+    QList<qint64> expected = sums;
+    std::inclusive_scan(expected.begin(), expected.end(), expected.begin());
+    QtConcurrent::inclusiveScan(&pool, sums).waitForFinished();
+    QCOMPARE(sums, expected);
+
+    QList<Matrix> products = randomMatrices(count);
+    QList<Matrix> expectedProducts = products;
+    std::inclusive_scan(expectedProducts.begin(), expectedProducts.end(),
+                        expectedProducts.begin(), std::multiplies<>());
+    QtConcurrent::blockingInclusiveScan(&pool, products.begin(), products.end(),
+                                        std::multiplies<>());
+    QVERIFY(products == expectedProducts);
+}
+
+void tst_QtConcurrentAlgorithms::exclusiveScan()
+{
+    QFETCH(qsizetype, count);
+
+    const QList<int> values = randomValues(count, 1000);
+    QList<qint64> sums(values.cbegin(), values.cend());
+    QList<qint64> expected = sums;
+    std::exclusive_scan(expected.begin(), expected.end(), expected.begin(), qint64(10));
+    QtConcurrent::exclusiveScan(&pool, sums, 10).waitForFinished();
+    QCOMPARE(sums, expected);
+
+    QList<Matrix> products = randomMatrices(count);
+    QList<Matrix> expectedProducts = products;
+    const Matrix init = { 3, 1, 4, 1 };
+    std::exclusive_scan(expectedProducts.begin(), expectedProducts.end(),
+                        expectedProducts.begin(), init, std::multiplies<>());
+    QtConcurrent::blockingExclusiveScan(&pool, products.begin(), products.end(), init,
+                                        std::multiplies<>());
+    QVERIFY(products == expectedProducts);
+}
+
+void tst_QtConcurrentAlgorithms::partition()
+{
+    QFETCH(qsizetype, count);
+
+    const QList<int> values = randomValues(count, 1000);
+    const auto isEven = [](int value) { return value % 2 == 0; };
+    QList<int> expected = values;
+    const auto expectedPoint = std::stable_partition(expected.begin(), expected.end(), isEven)
+                               - expected.begin();
+
+    QList<int> partitioned = values;
+    QFuture<qsizetype> future = QtConcurrent::partition(&pool, partitioned, isEven);
+    QCOMPARE(future.result(), expectedPoint);
+    QCOMPARE(partitioned, expected);
+
+    QList<QString> strings;
+    for (int value : values)
+        strings.append(QString::number(value));
+    QList<QString> expectedStrings = strings;
+    const auto isShort = [](const QString &string) { return string.size() < 3; };
+    std::stable_partition(expectedStrings.begin(), expectedStrings.end(), isShort);
+    QtConcurrent::blockingPartition(&pool, strings.begin(), strings.end(), isShort);
+    QCOMPARE(strings, expectedStrings);
+}
+
+void tst_QtConcurrentAlgorithms::transformReduce()
+{
+    QFETCH(qsizetype, count);
+
+    const QList<int> values = randomValues(count, 1000);
+    const auto square = [](int value) { return qint64(value) * value; };
+    const qint64 expected = std::transform_reduce(values.cbegin(), values.cend(), qint64(5),
+                                                  std::plus<>(), square);
+    QFuture<qint64> future =
+            QtConcurrent::transformReduce(&pool, values, qint64(5), std::plus<>(), square);
+    QCOMPARE(future.result(), expected);
+
+    const QList<Matrix> matrices = randomMatrices(count);
+    const auto transpose = [](const Matrix &m) { return Matrix{ m.a, m.c, m.b, m.d }; };
+    const Matrix expectedProduct = std::accumulate(
+            matrices.cbegin(), matrices.cend(), Matrix(),
+            [&](const Matrix &product, const Matrix &m) { return product * transpose(m); });
+    const Matrix product = QtConcurrent::blockingTransformReduce(
+            &pool, matrices.cbegin(), matrices.cend(), Matrix(), std::multiplies<>(), transpose);
+    QVERIFY(product == expectedProduct);
+}
+
+void tst_QtConcurrentAlgorithms::cancel()
+{
+    // Canceling may stop the computation early, but never loses elements
+    const QList<int> values = randomValues(100000, 1000);
+    QList<int> expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    for (int i = 0; i < 10; ++i) {
+        QList<int> sorted = values;
+        QFuture<void> future = QtConcurrent::sort(&pool, sorted);
+        future.cancel();
+        future.waitForFinished();
+        pool.waitForDone();
+        std::sort(sorted.begin(), sorted.end());
+        QCOMPARE(sorted, expected);
+
+        QList<int> partitioned = values;
+        QFuture<qsizetype> partitionFuture =
+                QtConcurrent::partition(&pool, partitioned, [](int value) { return value < 500; });
+        partitionFuture.cancel();
+        partitionFuture.waitForFinished();
+        pool.waitForDone();
+        std::sort(partitioned.begin(), partitioned.end());
+        QCOMPARE(partitioned, expected);
+    }
+}
+
+QTEST_MAIN(tst_QtConcurrentAlgorithms)
+#include "tst_qtconcurrentalgorithms.moc"
@@ -43,9 +43,11 @@ int distance(TestIterator &a, TestIterator &b)
 }
 
 #include <qtconcurrentiteratekernel.h>
+#include <QScopeGuard>
 #include <QTest>
 
 using namespace QtConcurrent;
+using namespace Qt::StringLiterals;
 
 class tst_QtConcurrentIterateKernel: public QObject
 {
@@ -58,6 +60,9 @@ private slots:
     void noIterations();
     void throttling();
     void multipleResults();
+    void partitioned();
+    void partitionedThrottling();
+    void partitionedResults();
 };
 
 QAtomicInt iterations;
@@ -246,6 +251,86 @@ void tst_QtConcurrentIterateKernel::multipleResults()
     f.waitForFinished();
 }
 
+// Large enough for the range to be partitioned between the threads
+const int partitionedIterations = 1 << 20;
+
+class HitFor : public IterateKernel<TestIterator, void>
+{
+public:
+    HitFor(TestIterator begin, TestIterator end, QAtomicInt *hits)
+        : IterateKernel<TestIterator, void>(QThreadPool::globalInstance(), begin, end), hits(hits)
+    {
+        iterations.storeRelaxed(0);
+    }
+    bool runIterations(TestIterator, int begin, int end, void *) override
+    {
+        for (int i = begin; i < end; ++i)
+            hits[i].fetchAndAddRelaxed(1);
+        iterations.fetchAndAddRelaxed(end - begin);
+        return false;
+    }
+
+    QAtomicInt *hits;
+};
+
+template <typename Kernel>
+static void runPartitioned()
+{
+    // Partitions are stolen from whether there are more or fewer cores than threads
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int maxThreadCount = pool->maxThreadCount();
+    const auto restoreMaxThreadCount = qScopeGuard([&] { pool->setMaxThreadCount(maxThreadCount); });
+
+    for (int threadCount : { 1, 3, 8 }) {
+        pool->setMaxThreadCount(threadCount);
+        auto hits = std::make_unique<QAtomicInt[]>(partitionedIterations);
+        auto future = startThreadEngine(new Kernel(0, partitionedIterations, hits.get()))
+                              .startAsynchronously();
+        future.waitForFinished();
+
+        QCOMPARE(iterations.loadRelaxed(), partitionedIterations);
+        for (int i = 0; i < partitionedIterations; ++i) {
+            if (hits[i].loadRelaxed() != 1) {
+                QFAIL(qPrintable(u"Iteration %1 ran %2 times with %3 threads"_s
+                                         .arg(i).arg(hits[i].loadRelaxed()).arg(threadCount)));
+            }
+        }
+    }
+}
+
+void tst_QtConcurrentIterateKernel::partitioned()
+{
+    runPartitioned<HitFor>();
+}
+
+class ThrottleHitFor : public HitFor
+{
+public:
+    using HitFor::HitFor;
+
+    bool shouldThrottleThread() override
+    {
+        const int load = iterations.loadRelaxed();
+        return load > partitionedIterations / 4 && load < partitionedIterations / 2;
+    }
+};
+
+void tst_QtConcurrentIterateKernel::partitionedThrottling()
+{
+    // Throttled threads leave the rest of their partition to the others
+    runPartitioned<ThrottleHitFor>();
+}
+
+void tst_QtConcurrentIterateKernel::partitionedResults()
+{
+    QFuture<int> f = startThreadEngine(new MultipleResultsFor(0, partitionedIterations))
+                             .startAsynchronously();
+    const QList<int> results = f.results();
+    QCOMPARE(results.size(), partitionedIterations);
+    for (int i = 0; i < partitionedIterations; ++i)
+        QCOMPARE(results.at(i), i);
+}
+
 QTEST_MAIN(tst_QtConcurrentIterateKernel)
 
 #include "tst_qtconcurrentiteratekernel.moc"
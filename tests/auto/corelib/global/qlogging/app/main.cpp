@@ -3,6 +3,10 @@
 
 #include <QCoreApplication>
 #include <QLoggingCategory>
+#include <QThread>
+#if QT_CONFIG(thread)
+#include <QtCore/private/qasynclogger_p.h>
+#endif
 
 #ifdef Q_CC_GNU
 #define NEVER_INLINE __attribute__((__noinline__))
@@ -35,11 +39,53 @@ void MyClass::myFunction(int a)
     qDebug() << "from_a_function" << a;
 }
 
+static int logFromThreads()
+{
+    qSetMessagePattern("%{message}");
+
+    QList<QThread *> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.append(QThread::create([t] {
+            for (int i = 0; i < 1000; ++i)
+                qInfo("thread %d message %d", t, i);
+        }));
+        threads.last()->start();
+    }
+    for (QThread *thread : std::as_const(threads)) {
+        thread->wait();
+        delete thread;
+    }
+
+#if QT_CONFIG(thread)
+    QtPrivate::flushAsyncLogging();
+    const QtPrivate::QAsyncLoggingStatistics statistics = QtPrivate::asyncLoggingStatistics();
+    printf("written %llu dropped %llu blocked %llu\n", qulonglong(statistics.written),
+           qulonglong(statistics.dropped), qulonglong(statistics.blocked));
+#endif
+    return 0;
+}
+
+static int logStructured()
+{
+    qDebug("%d %u %ld %lld %hhd", -1, 2u, -3l, 4ll, 5);
+    qInfo("%s|%10s|%-4.2s|%ls", "text", "right", "left", u"wide");
+    qWarning("%.3f %e %g %x %#o %c %%", 3.14159, 1e10, 0.5, 255, 8, 'c');
+    QLoggingCategory cat("structured");
+    qCCritical(cat, "%*d|%-*.*f", 6, 42, 10, 2, 2.5);
+    qCDebug(cat) << "streamed" << 42;
+    return 0;
+}
+
 int main(int argc, char **argv)
 {
     QCoreApplication app(argc, argv);
     app.setApplicationName("tst_qlogging");
 
+    if (argc > 1 && qstrcmp(argv[1], "threads") == 0)
+        return logFromThreads();
+    if (argc > 1 && qstrcmp(argv[1], "structured") == 0)
+        return logStructured();
+
     qSetMessagePattern("[%{type}] %{message}");
 
     qDebug("qDebug");
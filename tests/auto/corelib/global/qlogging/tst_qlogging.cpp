@@ -11,6 +11,10 @@
 #include <QtTest/QTest>
 #include <QList>
 #include <QMap>
+#if QT_CONFIG(cborstreamreader) && QT_CONFIG(cborstreamwriter)
+# include <QtCore/QTemporaryDir>
+# include <QtCore/private/qstructuredlog_p.h>
+#endif
 
 class tst_qmessagehandler : public QObject
 {
@@ -37,6 +41,9 @@ private slots:
     void qMessagePattern_data();
     void qMessagePattern();
     void setMessagePattern();
+    void asyncLogging_data();
+    void asyncLogging();
+    void structuredLogging();
 
     void formatLogMessage_data();
     void formatLogMessage();
@@ -63,6 +70,14 @@ void customMessageHandler(QtMsgType type, const QMessageLogContext &context, con
     s_message = msg;
 }
 
+// What the helper prints with the default message handler
+static const char helperOutput[] = "static constructor\n"
+        "[debug] qDebug\n"
+        "[info] qInfo\n"
+        "[warning] qWarning\n"
+        "[critical] qCritical\n"
+        "[warning] qDebug with category\n";
+
 tst_qmessagehandler::tst_qmessagehandler()
 {
     // ensure it's unset, otherwise we'll have trouble
@@ -721,16 +736,16 @@ void tst_qmessagehandler::qMessagePattern_data()
 
     // %{file} is tricky because of shadow builds
     QTest::newRow("basic") << "%{type} %{appname} %{line} %{function} %{message}" << true << (QList<QByteArray>()
-            << "debug  14 T::T static constructor"
+            << "debug  18 T::T static constructor"
             //  we can't be sure whether the QT_MESSAGE_PATTERN is already destructed
             << "static destructor"
-            << "debug tst_qlogging 35 MyClass::myFunction from_a_function 34"
-            << "debug tst_qlogging 45 main qDebug"
-            << "info tst_qlogging 46 main qInfo"
-            << "warning tst_qlogging 47 main qWarning"
-            << "critical tst_qlogging 48 main qCritical"
-            << "warning tst_qlogging 51 main qDebug with category"
-            << "debug tst_qlogging 55 main qDebug2");
+            << "debug tst_qlogging 39 MyClass::myFunction from_a_function 34"
+            << "debug tst_qlogging 91 main qDebug"
+            << "info tst_qlogging 92 main qInfo"
+            << "warning tst_qlogging 93 main qWarning"
+            << "critical tst_qlogging 94 main qCritical"
+            << "warning tst_qlogging 97 main qDebug with category"
+            << "debug tst_qlogging 101 main qDebug2");
 
 
     QTest::newRow("invalid") << "PREFIX: %{unknown} %{message}" << false << (QList<QByteArray>()
@@ -904,19 +919,171 @@ void tst_qmessagehandler::setMessagePattern()
 
     QByteArray output = process.readAllStandardError();
     //qDebug() << output;
-    QByteArray expected = "static constructor\n"
-            "[debug] qDebug\n"
-            "[info] qInfo\n"
-            "[warning] qWarning\n"
-            "[critical] qCritical\n"
-            "[warning] qDebug with category\n";
 #ifdef Q_OS_WIN
     output.replace("\r\n", "\n");
 #endif
-    QCOMPARE(QString::fromLatin1(output), QString::fromLatin1(expected));
+    QCOMPARE(QString::fromLatin1(output), QString::fromLatin1(helperOutput));
 #endif // QT_CONFIG(process)
 }
 
+void tst_qmessagehandler::asyncLogging_data()
+{
+    QTest::addColumn<QByteArray>("policy");
+
+    QTest::newRow("block") << QByteArray("block");
+    QTest::newRow("drop") << QByteArray("drop");
+}
+
+void tst_qmessagehandler::asyncLogging()
+{
+#if !QT_CONFIG(process) || !QT_CONFIG(thread)
+    QSKIP("This test requires QProcess and thread support");
+#else
+#ifdef Q_OS_ANDROID
+    QSKIP("This test crashes on Android");
+#endif
+    QFETCH(QByteArray, policy);
+
+    QProcess process;
+    const QString appExe(backtraceHelperPath());
+    QProcessEnvironment environment = m_baseEnvironment;
+    environment.insert("QT_LOGGING_ASYNC", policy);
+    process.setProcessEnvironment(environment);
+
+    // messages from a single thread, including those logged while exiting
+    process.start(appExe);
+    QVERIFY2(process.waitForStarted(), qPrintable(
+        QString::fromLatin1("Could not start %1: %2").arg(appExe, process.errorString())));
+    process.waitForFinished();
+    QByteArray output = process.readAllStandardError();
+#ifdef Q_OS_WIN
+    output.replace("\r\n", "\n");
+#endif
+    QCOMPARE(QString::fromLatin1(output), QString::fromLatin1(helperOutput));
+
+    // several threads filling small buffers
+    environment.insert("QT_LOGGING_ASYNC_BUFFER_SIZE", "4096");
+    process.setProcessEnvironment(environment);
+    process.start(appExe, { "threads" });
+    QVERIFY2(process.waitForStarted(), qPrintable(
+        QString::fromLatin1("Could not start %1: %2").arg(appExe, process.errorString())));
+    QVERIFY(process.waitForFinished(60000));
+    output = process.readAllStandardError();
+#ifdef Q_OS_WIN
+    output.replace("\r\n", "\n");
+#endif
+
+    constexpr int ThreadCount = 4;
+    constexpr int MessageCount = 1000;
+    int last[ThreadCount] = { -1, -1, -1, -1 };
+    int received = 0;
+    unsigned long long dropped = 0;
+    for (const QByteArray &line : output.split('\n')) {
+        int thread = -1;
+        int message = -1;
+        unsigned long long count = 0;
+        if (sscanf(line.constData(), "thread %d message %d", &thread, &message) == 2) {
+            QVERIFY2(thread >= 0 && thread < ThreadCount, line.constData());
+            // each thread's messages are written in order
+            if (policy == "block")
+                QCOMPARE(message, last[thread] + 1);
+            else
+                QCOMPARE_GT(message, last[thread]);
+            last[thread] = message;
+            ++received;
+        } else if (sscanf(line.constData(), "QAsyncLogger: %llu messages dropped", &count) == 1) {
+            dropped += count;
+        }
+    }
+    if (policy == "block")
+        QCOMPARE(received, ThreadCount * MessageCount);
+    QCOMPARE(qsizetype(received + dropped), qsizetype(ThreadCount * MessageCount));
+
+    // the counters of the logger match what was written
+    unsigned long long statsWritten = 0;
+    unsigned long long statsDropped = 0;
+    unsigned long long statsBlocked = 0;
+    const QByteArray statistics = process.readAllStandardOutput();
+    QCOMPARE(sscanf(statistics.constData(), "written %llu dropped %llu blocked %llu",
+                    &statsWritten, &statsDropped, &statsBlocked), 3);
+    // the helper also logged "static constructor" before the threads
+    QCOMPARE(statsWritten, qulonglong(received) + 1);
+    QCOMPARE(statsDropped, dropped);
+    if (policy == "block")
+        QCOMPARE(statsDropped, 0ULL);
+    else
+        QCOMPARE(statsBlocked, 0ULL);
+#endif // QT_CONFIG(process) && QT_CONFIG(thread)
+}
+
+void tst_qmessagehandler::structuredLogging()
+{
+#if !QT_CONFIG(process) || !QT_CONFIG(cborstreamreader) || !QT_CONFIG(cborstreamwriter)
+    QSKIP("This test requires QProcess and CBOR support");
+#else
+#ifdef Q_OS_ANDROID
+    QSKIP("This test crashes on Android");
+#endif
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    const QString fileName = dir.filePath("log.cbor");
+
+    QProcess process;
+    const QString appExe(backtraceHelperPath());
+    QProcessEnvironment environment = m_baseEnvironment;
+    environment.insert("QT_LOGGING_STRUCTURED", fileName);
+    process.setProcessEnvironment(environment);
+    process.start(appExe, { "structured" });
+    QVERIFY2(process.waitForStarted(), qPrintable(
+        QString::fromLatin1("Could not start %1: %2").arg(appExe, process.errorString())));
+    const qint64 pid = process.processId();
+    QVERIFY(process.waitForFinished());
+    // nothing is printed
+    QCOMPARE(process.readAllStandardError(), QByteArray());
+
+    struct Expected {
+        QtMsgType type;
+        const char *category;
+        bool streamed;
+        QString message;
+    };
+    const Expected expected[] = {
+        { QtDebugMsg, "default", false, QStringLiteral("static constructor") },
+        { QtDebugMsg, "default", false,
+          QString::asprintf("%d %u %ld %lld %hhd", -1, 2u, -3l, 4ll, 5) },
+        { QtInfoMsg, "default", false,
+          QString::asprintf("%s|%10s|%-4.2s|%ls", "text", "right", "left", u"wide") },
+        { QtWarningMsg, "default", false,
+          QString::asprintf("%.3f %e %g %x %#o %c %%", 3.14159, 1e10, 0.5, 255, 8, 'c') },
+        { QtCriticalMsg, "structured", false,
+          QString::asprintf("%*d|%-*.*f", 6, 42, 10, 2, 2.5) },
+        { QtDebugMsg, "structured", true, QStringLiteral("streamed 42") },
+        { QtDebugMsg, "default", false, QStringLiteral("static destructor") },
+    };
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QStructuredLogReader reader(&file);
+    QStructuredLogRecord record;
+    qint64 lastTimestamp = -1;
+    for (const Expected &e : expected) {
+        QVERIFY2(reader.readNext(&record), qPrintable(e.message));
+        QCOMPARE(record.type, e.type);
+        QCOMPARE(record.category, QByteArray(e.category));
+        QCOMPARE(record.format.isNull(), e.streamed);
+        QCOMPARE(record.message(), e.message);
+        QCOMPARE_GE(record.timestamp, lastTimestamp);
+        QVERIFY(record.threadId != 0);
+        QVERIFY(record.file.endsWith("main.cpp"));
+        QCOMPARE_GT(record.line, 0);
+        lastTimestamp = record.timestamp;
+    }
+    QCOMPARE(reader.processId(), pid);
+    QVERIFY(!reader.readNext(&record));
+    QVERIFY(!reader.hasError());
+#endif // QT_CONFIG(process) && QT_CONFIG(cborstreamreader) && QT_CONFIG(cborstreamwriter)
+}
+
 Q_DECLARE_METATYPE(QtMsgType)
 
 void tst_qmessagehandler::formatLogMessage_data()
@@ -93,6 +93,11 @@ private slots:
 
     void withStdAlgorithms();
 
+    void parallel_data() { iterateRelativeDirectory_data(); }
+    void parallel();
+    void parallelTree();
+    void parallelBackPressure();
+
 private:
     QSharedPointer<QTemporaryDir> m_dataDir;
 };
@@ -771,6 +776,106 @@ void tst_QDirListing::withStdAlgorithms()
 #endif
 }
 
+static QStringList sortedFilePaths(const QDirListing &lister)
+{
+    QStringList list;
+    for (const auto &dirEntry : lister)
+        list.emplace_back(dirEntry.filePath());
+    list.sort();
+    return list;
+}
+
+void tst_QDirListing::parallel()
+{
+    QFETCH(QString, dirName);
+    QFETCH(QDirListing::IteratorFlags, flags);
+    QFETCH(QStringList, nameFilters);
+
+    const QDirListing lister(dirName, nameFilters, flags);
+    const QDirListing parallelLister(dirName, nameFilters, flags | ItFlag::Parallel);
+    QCOMPARE(parallelLister.iteratorFlags(), flags | ItFlag::Parallel);
+
+    // Without Recursive the flag is a no-op, either way the same entries
+    // are listed, only the order may differ
+    QCOMPARE_EQ(sortedFilePaths(parallelLister), sortedFilePaths(lister));
+}
+
+void tst_QDirListing::parallelTree()
+{
+    QTemporaryDir tempDir;
+    QVERIFY2(tempDir.isValid(), qPrintable(tempDir.errorString()));
+
+    QStringList expected;
+    QDir root(tempDir.path());
+    for (int i = 0; i < 8; ++i) {
+        const QString dir = u"dir%1"_s.arg(i);
+        expected << tempDir.filePath(dir);
+        for (int j = 0; j < 8; ++j) {
+            const QString subDir = dir + u"/sub%1"_s.arg(j);
+            QVERIFY(root.mkpath(subDir));
+            expected << tempDir.filePath(subDir);
+            for (int k = 0; k < 20; ++k) {
+                const QString fileName = tempDir.filePath(subDir + u"/file%1"_s.arg(k));
+                QVERIFY(createFile(fileName));
+                expected << fileName;
+            }
+        }
+    }
+    expected.sort();
+
+    constexpr auto flags = ItFlag::Recursive | ItFlag::Parallel;
+    QDirListing lister(tempDir.path(), flags);
+    QCOMPARE_EQ(sortedFilePaths(lister), expected);
+    // Each begin() starts anew
+    QCOMPARE_EQ(sortedFilePaths(lister), expected);
+
+    QStringList files;
+    for (const auto &dirEntry : QDirListing(tempDir.path(), flags | ItFlag::FilesOnly)) {
+        QVERIFY(dirEntry.isFile());
+        files << dirEntry.fileName();
+    }
+    QCOMPARE_EQ(files.size(), 8 * 8 * 20);
+
+    // Destroying the listing while the helper tasks may still be scanning
+    // must not crash or hang
+    for (int i = 0; i < 10; ++i) {
+        QDirListing partial(tempDir.path(), flags);
+        auto it = partial.begin();
+        QVERIFY(it != partial.end());
+        ++it;
+    }
+}
+
+void tst_QDirListing::parallelBackPressure()
+{
+    // More entries than the helpers queue up before waiting for the
+    // iterating thread to consume them
+    QTemporaryDir tempDir;
+    QVERIFY2(tempDir.isValid(), qPrintable(tempDir.errorString()));
+    QDir root(tempDir.path());
+    constexpr int DirCount = 4;
+    constexpr int FileCount = 2500;
+    for (int i = 0; i < DirCount; ++i) {
+        const QString dir = u"dir%1"_s.arg(i);
+        QVERIFY(root.mkdir(dir));
+        for (int j = 0; j < FileCount; ++j)
+            QVERIFY(createFile(tempDir.filePath(dir + u"/file%1"_s.arg(j))));
+    }
+
+    constexpr auto flags = ItFlag::Recursive | ItFlag::Parallel | ItFlag::FilesOnly;
+    QSet<QString> files;
+    for (const auto &dirEntry : QDirListing(tempDir.path(), flags))
+        files.insert(dirEntry.filePath());
+    QCOMPARE(files.size(), DirCount * FileCount);
+
+    // Stopping while the helpers wait for the entries to be consumed must
+    // not hang
+    QDirListing partial(tempDir.path(), flags);
+    auto it = partial.begin();
+    for (int i = 0; i < 10 && it != partial.end(); ++i)
+        ++it;
+}
+
 QTEST_MAIN(tst_QDirListing)
 
 #include "tst_qdirlisting.moc"
@@ -84,6 +84,9 @@ private slots:
     void signalsEmittedAfterFileMoved();
 
     void watchUnicodeCharacters();
+
+    void addPathsRecursively();
+    void coalescing();
 #if defined(Q_OS_WIN)
     void watchDirectoryAttributeChanges();
 #endif
@@ -842,6 +845,90 @@ void tst_QFileSystemWatcher::watchUnicodeCharacters()
     QTRY_COMPARE(changedSpy.count(), 1);
 }
 
+void tst_QFileSystemWatcher::addPathsRecursively()
+{
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+
+    const QString root = QDir::cleanPath(temporaryDirectory.path());
+    QDir testDir(root);
+    QVERIFY(testDir.mkpath("a/b/c"));
+    QVERIFY(testDir.mkpath(".hidden/d"));
+
+    QFileSystemWatcher watcher;
+    QVERIFY(watcher.addPathsRecursively({ temporaryDirectory.path() }).isEmpty());
+
+    QStringList expected = {
+        root, root + "/a", root + "/a/b", root + "/a/b/c", root + "/.hidden",
+        root + "/.hidden/d",
+    };
+    expected.sort();
+    QStringList directories = watcher.directories();
+    directories.sort();
+    QCOMPARE(directories, expected);
+
+    // Adding the tree again doesn't watch anything twice
+    QCOMPARE(watcher.addPathsRecursively({ root }).size(), expected.size());
+    QCOMPARE(watcher.directories().size(), expected.size());
+
+    FileSystemWatcherSpy changedSpy(&watcher, FileSystemWatcherSpy::SpyOnDirectoryChanged);
+    QVERIFY(testDir.mkdir("a/b/c/new"));
+    QTRY_VERIFY2(changedSpy.count() > 0, changedSpy.receivedFilesMessage());
+
+    // The new directory is watched as well
+    QTRY_VERIFY(watcher.directories().contains(root + "/a/b/c/new"));
+
+    // Removing the top-level directory stops watching the whole tree
+    QVERIFY(watcher.removePath(root));
+    QVERIFY(watcher.directories().isEmpty());
+}
+
+void tst_QFileSystemWatcher::coalescing()
+{
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+
+    const QString root = QDir::cleanPath(temporaryDirectory.path());
+    QFileSystemWatcher watcher;
+    QCOMPARE(watcher.coalescingInterval(), 0ms);
+    // long enough for nothing to be emitted before we disable coalescing
+    constexpr std::chrono::milliseconds LongInterval = 1h;
+    watcher.setCoalescingInterval(LongInterval);
+    QCOMPARE(watcher.coalescingInterval(), LongInterval);
+    QVERIFY(watcher.addPathsRecursively({ root }).isEmpty());
+
+    // Tells when the engine has reported the changes: the engines of both
+    // watchers are notified at the same time
+    QFileSystemWatcher reference;
+    QVERIFY(reference.addPath(root));
+
+    FileSystemWatcherSpy changedSpy(&watcher, FileSystemWatcherSpy::SpyOnDirectoryChanged);
+    FileSystemWatcherSpy referenceSpy(&reference, FileSystemWatcherSpy::SpyOnDirectoryChanged);
+    QDir testDir(root);
+    for (int i = 0; i < 10; ++i) {
+        QVERIFY(testDir.mkdir(QString::number(i)));
+        QCoreApplication::processEvents();
+    }
+    QTRY_VERIFY(referenceSpy.count() > 0);
+    QCoreApplication::processEvents();
+    QVERIFY2(changedSpy.count() == 0, changedSpy.receivedFilesMessage());
+    // new sub-directories are only looked for when the change is delivered
+    QCOMPARE(watcher.directories(), QStringList{ root });
+
+    // Disabling coalescing delivers the pending changes right away, once
+    // per path
+    watcher.setCoalescingInterval(0ms);
+    QVERIFY2(changedSpy.count() == 1, changedSpy.receivedFilesMessage());
+    QCOMPARE(watcher.directories().size(), 11);
+
+    // Changes are delivered when the interval elapsed
+    changedSpy.clear();
+    watcher.setCoalescingInterval(100ms);
+    QVERIFY(testDir.mkdir("last"));
+    QTRY_COMPARE(changedSpy.count(), 1);
+    QVERIFY(watcher.directories().contains(root + "/last"));
+}
+
 #if defined(Q_OS_WIN)
 void tst_QFileSystemWatcher::watchDirectoryAttributeChanges()
 {
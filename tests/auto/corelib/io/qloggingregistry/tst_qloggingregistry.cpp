@@ -149,6 +149,63 @@ private slots:
         QCOMPARE(state, result);
     }
 
+    void QLoggingRuleMatcher_match_data()
+    {
+        QTest::addColumn<QString>("category");
+
+        for (const char *category : { "qt", "qt.core", "qt.core.io", "qt.gui", "qt.gui.io",
+                                      "qt.io.io", "default", "x.core.y", "io", "", "qtx" }) {
+            QTest::newRow(category) << QString::fromLatin1(category);
+        }
+    }
+
+    void QLoggingRuleMatcher_match()
+    {
+        QFETCH(QString, category);
+        const auto categoryL1 = category.toLatin1();
+        const auto categoryL1S = QLatin1String(categoryL1);
+
+        QLoggingSettingsParser parser;
+        parser.setContent(u"[Rules]\n"
+                           "*=false\n"
+                           "qt.*=true\n"
+                           "qt.core.*.debug=false\n"
+                           "*.io=true\n"
+                           "*.io.warning=false\n"
+                           "*.core.*=false\n"
+                           "qt.core.io.info=true\n"
+                           "qt.gui=false\n"
+                           "qt=true\n"
+                           "qt.c*.critical=false\n"
+                           "*.gui.io.debug=true\n");
+        const QList<QLoggingRule> rules = parser.rules();
+        QCOMPARE(rules.size(), 11);
+        const QList<QLoggingRule> ruleSets[] = { rules.first(5), rules.sliced(5) };
+        const QLoggingRuleMatcher matcher(ruleSets);
+        const auto verdicts = matcher.match(categoryL1S);
+
+        const std::pair<QLoggingRuleMatcher::Level, QtMsgType> levels[] = {
+            { QLoggingRuleMatcher::Debug, QtDebugMsg },
+            { QLoggingRuleMatcher::Info, QtInfoMsg },
+            { QLoggingRuleMatcher::Warning, QtWarningMsg },
+            { QLoggingRuleMatcher::Critical, QtCriticalMsg },
+        };
+        for (const auto &[level, msgType] : levels) {
+            // the last rule that matches wins
+            int expectedPriority = -1;
+            bool expectedEnabled = false;
+            for (int i = 0; i < rules.size(); ++i) {
+                if (int pass = rules.at(i).pass(categoryL1S, msgType)) {
+                    expectedPriority = i;
+                    expectedEnabled = pass > 0;
+                }
+            }
+            QCOMPARE(verdicts[level].priority, expectedPriority);
+            if (expectedPriority >= 0)
+                QCOMPARE(verdicts[level].enabled, expectedEnabled);
+        }
+    }
+
     void QLoggingSettingsParser_iniStyle()
     {
         //
@@ -36,6 +36,8 @@
 #endif
 
 #include <functional>
+#include <memory>
+#include <numeric>
 
 #include <math.h>
 
@@ -156,6 +158,9 @@ private slots:
     void declarativeData();
     void asyncCallbackHelper();
     void disconnectQueuedConnection_pendingEventsAreDelivered();
+    void queuedConnectionsShareArguments();
+    void queuedConnectionsToSeveralThreads();
+    void queuedConnectionsOrderWithDirectConnections();
 };
 
 struct QObjectCreatedOnShutdown
@@ -8966,5 +8971,125 @@ void tst_QObject::disconnectQueuedConnection_pendingEventsAreDelivered()
     QTRY_COMPARE(receiver.count_slot1, 1);
 }
 
+struct CopyCounted
+{
+    static inline QAtomicInt copies;
+
+    CopyCounted() = default;
+    CopyCounted(const CopyCounted &other) : value(other.value) { copies.ref(); }
+    CopyCounted &operator=(const CopyCounted &other)
+    {
+        value = other.value;
+        copies.ref();
+        return *this;
+    }
+
+    int value = 0;
+};
+
+class CopyCountedSender : public QObject
+{
+    Q_OBJECT
+signals:
+    void copyCounted(const CopyCounted &value, const QString &text);
+    void number(int value);
+};
+
+void tst_QObject::queuedConnectionsShareArguments()
+{
+    CopyCountedSender sender;
+    std::vector<std::unique_ptr<QObject>> receivers;
+    int received = 0;
+    for (int i = 0; i < 10; ++i) {
+        receivers.push_back(std::make_unique<QObject>());
+        connect(&sender, &CopyCountedSender::copyCounted, receivers.back().get(),
+                [&received](const CopyCounted &value, const QString &text) {
+                    QCOMPARE(value.value, 42);
+                    QCOMPARE(text, u"text");
+                    ++received;
+                }, Qt::QueuedConnection);
+    }
+    // A single-shot connection, and one that is disconnected before delivery
+    connect(&sender, &CopyCountedSender::copyCounted, receivers.front().get(),
+            [&received](const CopyCounted &) { received += 100; },
+            Qt::QueuedConnection | Qt::SingleShotConnection);
+    auto disconnected = std::make_unique<QObject>();
+    connect(&sender, &CopyCountedSender::copyCounted, disconnected.get(),
+            [] { QFAIL("Slot of a destroyed receiver called"); }, Qt::QueuedConnection);
+
+    CopyCounted value;
+    value.value = 42;
+    CopyCounted::copies.storeRelaxed(0);
+    emit sender.copyCounted(value, u"text"_s);
+    QCOMPARE(CopyCounted::copies.loadRelaxed(), 1);
+
+    disconnected.reset();
+    QCOMPARE(received, 0);
+    QCoreApplication::processEvents();
+    QCOMPARE(received, 110);
+    QCOMPARE(CopyCounted::copies.loadRelaxed(), 1);
+
+    emit sender.copyCounted(value, u"text"_s);
+    QCoreApplication::processEvents();
+    QCOMPARE(received, 120);
+}
+
+void tst_QObject::queuedConnectionsToSeveralThreads()
+{
+    CopyCountedSender sender;
+    QThread threads[2];
+    std::vector<std::unique_ptr<QObject>> receivers;
+    QList<int> values[6];
+    for (int i = 0; i < 6; ++i) {
+        receivers.push_back(std::make_unique<QObject>());
+        receivers.back()->moveToThread(&threads[i % 2]);
+        connect(&sender, &CopyCountedSender::number, receivers.back().get(),
+                [&threads, i, &list = values[i]](int value) {
+                    QCOMPARE(QThread::currentThread(), &threads[i % 2]);
+                    list.append(value);
+                });
+    }
+    for (QThread &thread : threads)
+        thread.start();
+    auto cleanup = qScopeGuard([&] {
+        receivers.clear();
+        for (QThread &thread : threads) {
+            thread.quit();
+            thread.wait();
+        }
+    });
+
+    for (int value = 0; value < 100; ++value)
+        emit sender.number(value);
+
+    QList<int> expected(100);
+    std::iota(expected.begin(), expected.end(), 0);
+    for (const QList<int> &list : values)
+        QTRY_COMPARE(list, expected);
+}
+
+void tst_QObject::queuedConnectionsOrderWithDirectConnections()
+{
+    // A direct connection between queued ones posts its own event, which
+    // must be delivered after those of the queued connections before it
+    CopyCountedSender sender;
+    QObject receiver;
+    QStringList order;
+    connect(&sender, &CopyCountedSender::number, &receiver,
+            [&order] { order.append(u"queued 1"_s); }, Qt::QueuedConnection);
+    connect(&sender, &CopyCountedSender::number, &receiver,
+            [&order] { order.append(u"queued 2"_s); }, Qt::QueuedConnection);
+    connect(&sender, &CopyCountedSender::number, &receiver, [&] {
+        QMetaObject::invokeMethod(&receiver, [&order] { order.append(u"posted"_s); },
+                                  Qt::QueuedConnection);
+    });
+    connect(&sender, &CopyCountedSender::number, &receiver,
+            [&order] { order.append(u"queued 3"_s); }, Qt::QueuedConnection);
+
+    emit sender.number(1);
+    QCoreApplication::processEvents();
+    QCOMPARE(order, QStringList({ u"queued 1"_s, u"queued 2"_s, u"posted"_s, u"queued 3"_s }));
+}
+
 QTEST_MAIN(tst_QObject)
 #include "tst_qobject.moc"
@@ -11,6 +11,7 @@
 #include <qbytearray.h>
 #include <qfile.h>
 #include <qhash.h>
+#include <qvarlengtharray.h>
 #include <limits.h>
 #include <private/qtools_p.h>
 
@@ -1558,6 +1559,15 @@ void tst_QByteArray::number_double()
         }
     }
     QTEST(QByteArray::number(value, format, precision), "expected");
+
+    QFETCH(const QByteArray, expected);
+    QVarLengthArray<char, 64> buffer(expected.size());
+    QCOMPARE(QByteArray::number(value, buffer, format, precision), expected.size());
+    QCOMPARE(QByteArrayView(buffer.data(), buffer.size()), expected);
+    if (!expected.isEmpty()) {
+        const QSpan<char> tooSmall(buffer.data(), buffer.size() - 1);
+        QCOMPARE(QByteArray::number(value, tooSmall, format, precision), -1);
+    }
 }
 
 void tst_QByteArray::number_base_data()
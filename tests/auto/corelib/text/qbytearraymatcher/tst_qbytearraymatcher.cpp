@@ -6,6 +6,7 @@
 
 #include <qbytearraymatcher.h>
 
+#include <algorithm>
 #include <numeric>
 #include <string>
 
@@ -24,6 +25,7 @@ private slots:
     void overloads();
     void interface();
     void indexIn();
+    void indexInLongHaystack();
     void staticByteArrayMatcher();
     void haystacksWithMoreThan4GiBWork();
 };
@@ -152,6 +154,33 @@ void tst_QByteArrayMatcher::indexIn()
     QCOMPARE(matcher.indexIn(haystack, 34), -1);
 }
 
+void tst_QByteArrayMatcher::indexInLongHaystack()
+{
+    // Exercise the vectorized search: block boundaries, candidates that
+    // match the first and last byte of the needle only, and the scalar tail
+    for (qsizetype needleSize : {2, 3, 8, 15, 16, 17, 31, 32, 33, 64}) {
+        QByteArray needle(needleSize, Qt::Uninitialized);
+        for (qsizetype i = 0; i < needleSize; ++i)
+            needle[i] = char('a' + i % 26);
+        QByteArray decoy = needle;
+        if (needleSize > 2)
+            decoy[needleSize / 2] = '-';
+
+        const QByteArrayMatcher matcher(needle);
+        for (qsizetype pos : {0, 1, 15, 16, 31, 32, 33, 100, 253}) {
+            QByteArray haystack(256 + needleSize, 'x');
+            if (needleSize > 2)
+                haystack.replace(pos / 2, needleSize, decoy);
+            haystack.replace(pos, needleSize, needle);
+            const auto expected = std::search(haystack.cbegin(), haystack.cend(),
+                                              needle.cbegin(), needle.cend()) - haystack.cbegin();
+            QCOMPARE(matcher.indexIn(haystack), expected);
+            QCOMPARE(matcher.indexIn(haystack, expected), expected);
+            QCOMPARE(matcher.indexIn(haystack, expected + 1), -1);
+        }
+    }
+}
+
 void tst_QByteArrayMatcher::staticByteArrayMatcher()
 {
     {
@@ -11,6 +11,8 @@
 #include <cstring>
 #include <iostream>
 
+using namespace Qt::StringLiterals;
+
 class tst_QCollator : public QObject
 {
     Q_OBJECT
@@ -22,6 +24,9 @@ private Q_SLOTS:
     void compare_data();
     void compare();
 
+    void sort_data();
+    void sort();
+
     void state();
 };
 
@@ -326,6 +331,47 @@ void tst_QCollator::compare()
 #endif
 }
 
+void tst_QCollator::sort_data()
+{
+    QTest::addColumn<QLocale>("locale");
+    QTest::addColumn<Qt::CaseSensitivity>("caseSensitivity");
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("C") << QLocale::c() << Qt::CaseSensitive << 100;
+    QTest::newRow("swedish") << QLocale(QLocale::Swedish) << Qt::CaseSensitive << 100;
+    QTest::newRow("german-insensitive") << QLocale(QLocale::German) << Qt::CaseInsensitive << 100;
+    // Long enough for keys to be made in parallel:
+    QTest::newRow("english-long") << QLocale(QLocale::English) << Qt::CaseSensitive << 50000;
+}
+
+void tst_QCollator::sort()
+{
+    QFETCH(const QLocale, locale);
+    QFETCH(const Qt::CaseSensitivity, caseSensitivity);
+    QFETCH(const int, count);
+
+    QCollator collator(locale);
+    collator.setCaseSensitivity(caseSensitivity);
+
+    // Includes equal strings, case variants, accents and the empty string
+    const QString parts[] = { u"a"_s, u"B"_s, u"\u00e5"_s, u"\u00e4"_s, u"z"_s, u"A"_s,
+                              u"\u00f6"_s, u"-"_s, u"10"_s, u"9"_s, u""_s };
+    QStringList strings;
+    quint32 seed = 1;
+    for (int i = 0; i < count; ++i) {
+        QString string;
+        for (int length = i % 5; length >= 0; --length) {
+            seed = seed * 1103515245 + 12345;
+            string += parts[(seed >> 16) % std::size(parts)];
+        }
+        strings.append(string);
+    }
+
+    QStringList expected = strings;
+    std::stable_sort(expected.begin(), expected.end(), collator);
+    collator.sort(strings);
+    QCOMPARE(strings, expected);
+}
 
 void tst_QCollator::state()
 {
@@ -0,0 +1,209 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+
+#include <QtCore/QMultiByteArrayMatcher>
+
+using Match = QMultiByteArrayMatcher::Match;
+
+class tst_QMultiByteArrayMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void empty();
+    void indexIn_data();
+    void indexIn();
+    void matchesIn();
+    void caseInsensitive();
+    void prefilter();
+    void manyPatterns();
+};
+
+// Reference implementation: all matches, in the order matchesIn() reports them
+static QList<Match> bruteForce(QByteArrayView data, const QList<QByteArray> &patterns,
+                               Qt::CaseSensitivity cs = Qt::CaseSensitive)
+{
+    QList<Match> result;
+    for (qsizetype end = 1; end <= data.size(); ++end) {
+        QList<Match> here;
+        for (qsizetype p = 0; p < patterns.size(); ++p) {
+            const qsizetype len = patterns.at(p).size();
+            if (len == 0 || len > end)
+                continue;
+            if (QLatin1StringView(data.sliced(end - len, len))
+                        .compare(QLatin1StringView(patterns.at(p)), cs) == 0) {
+                here.append(Match{end - len, len, p});
+            }
+        }
+        std::stable_sort(here.begin(), here.end(), [](const Match &a, const Match &b) {
+            return a.length > b.length;
+        });
+        result += here;
+    }
+    return result;
+}
+
+static bool operator==(const Match &lhs, const Match &rhs)
+{
+    return lhs.position == rhs.position && lhs.length == rhs.length
+            && lhs.patternIndex == rhs.patternIndex;
+}
+
+namespace QTest {
+template <> char *toString(const Match &m)
+{
+    const QByteArray str = QByteArray::number(m.position) + '+' + QByteArray::number(m.length)
+            + " #" + QByteArray::number(m.patternIndex);
+    return qstrdup(str.constData());
+}
+}
+
+void tst_QMultiByteArrayMatcher::empty()
+{
+    QMultiByteArrayMatcher none;
+    QVERIFY(none.patterns().isEmpty());
+    QCOMPARE(none.indexIn("abc"), -1);
+    QVERIFY(none.matchesIn("abc").isEmpty());
+
+    QMultiByteArrayMatcher emptyPatterns({ QByteArray(), QByteArray("") });
+    qsizetype patternIndex = 42;
+    QCOMPARE(emptyPatterns.indexIn("abc", 0, &patternIndex), -1);
+    QCOMPARE(patternIndex, -1);
+    QVERIFY(emptyPatterns.matchesIn("abc").isEmpty());
+
+    QMultiByteArrayMatcher matcher({ "abc" });
+    QCOMPARE(matcher.indexIn(QByteArrayView()), -1);
+    QCOMPARE(matcher.indexIn("abc", 3), -1);
+}
+
+void tst_QMultiByteArrayMatcher::indexIn_data()
+{
+    QTest::addColumn<QList<QByteArray>>("patterns");
+    QTest::addColumn<QByteArray>("haystack");
+    QTest::addColumn<qsizetype>("from");
+    QTest::addColumn<qsizetype>("index");
+    QTest::addColumn<qsizetype>("patternIndex");
+
+    const QList<QByteArray> he = { "he", "she", "his", "hers" };
+    QTest::newRow("ushers") << he << QByteArray("ushers") << qsizetype(0)
+                            << qsizetype(1) << qsizetype(1);
+    QTest::newRow("ushers-from-2") << he << QByteArray("ushers") << qsizetype(2)
+                                   << qsizetype(2) << qsizetype(3);
+    QTest::newRow("negative-from") << he << QByteArray("ushers") << qsizetype(-5)
+                                   << qsizetype(1) << qsizetype(1);
+    QTest::newRow("no-match") << he << QByteArray("xyz") << qsizetype(0)
+                              << qsizetype(-1) << qsizetype(-1);
+    // the leftmost match wins, even if a shorter one ends first
+    QTest::newRow("leftmost") << QList<QByteArray>{ "abcdef", "cd" } << QByteArray("xabcdefx")
+                              << qsizetype(0) << qsizetype(1) << qsizetype(0);
+    QTest::newRow("leftmost-cut") << QList<QByteArray>{ "abcdef", "cd" } << QByteArray("xabcdex")
+                                  << qsizetype(0) << qsizetype(3) << qsizetype(1);
+    // at the same position, the longest match wins
+    QTest::newRow("longest") << QList<QByteArray>{ "ab", "abcd", "abc" } << QByteArray("xxabcd")
+                             << qsizetype(0) << qsizetype(2) << qsizetype(1);
+    // among identical patterns, the first one wins
+    QTest::newRow("duplicates") << QList<QByteArray>{ "x", "ab", "ab" } << QByteArray("cab")
+                                << qsizetype(0) << qsizetype(1) << qsizetype(1);
+    QTest::newRow("binary") << QList<QByteArray>{ QByteArray("\0\xff", 2) }
+                            << QByteArray("a\xff\0\0\xff", 5) << qsizetype(0)
+                            << qsizetype(3) << qsizetype(0);
+}
+
+void tst_QMultiByteArrayMatcher::indexIn()
+{
+    QFETCH(QList<QByteArray>, patterns);
+    QFETCH(QByteArray, haystack);
+    QFETCH(qsizetype, from);
+    QFETCH(qsizetype, index);
+    QFETCH(qsizetype, patternIndex);
+
+    const QMultiByteArrayMatcher matcher(patterns);
+    QCOMPARE(matcher.patterns(), patterns);
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseSensitive);
+
+    qsizetype foundPattern = -2;
+    QCOMPARE(matcher.indexIn(haystack, from, &foundPattern), index);
+    QCOMPARE(foundPattern, patternIndex);
+}
+
+void tst_QMultiByteArrayMatcher::matchesIn()
+{
+    const QList<QByteArray> patterns = { "he", "she", "his", "hers", "e", "she" };
+    const QMultiByteArrayMatcher matcher(patterns);
+    const QByteArray haystack = "ushers and his sheep";
+
+    QCOMPARE(matcher.matchesIn(haystack), bruteForce(haystack, patterns));
+    const QList<Match> expected = {
+        { 1, 3, 1 }, { 1, 3, 5 }, { 2, 2, 0 }, { 3, 1, 4 }, { 2, 4, 3 },
+    };
+    QCOMPARE(matcher.matchesIn(haystack).first(5), expected);
+
+    // matches must start at or after from
+    const QList<Match> fromThree = matcher.matchesIn(haystack, 3);
+    QCOMPARE(fromThree.first(), (Match{ 3, 1, 4 }));
+    for (const Match &m : fromThree)
+        QCOMPARE_GE(m.position, 3);
+}
+
+void tst_QMultiByteArrayMatcher::caseInsensitive()
+{
+    const QList<QByteArray> patterns = { "Qt", "\xe9t\xe9", "QTBUG" }; // été in Latin-1
+    const QMultiByteArrayMatcher matcher(patterns, Qt::CaseInsensitive);
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseInsensitive);
+
+    const QByteArray haystack = "In \xc9T\xc9, qT fixed qtbug-1 and QTbUG-2";
+    QCOMPARE(matcher.matchesIn(haystack), bruteForce(haystack, patterns, Qt::CaseInsensitive));
+    qsizetype patternIndex = -1;
+    QCOMPARE(matcher.indexIn(haystack, 0, &patternIndex), 3);
+    QCOMPARE(patternIndex, 1);
+    QCOMPARE(matcher.indexIn(haystack, 4, &patternIndex), 8);
+    QCOMPARE(patternIndex, 0);
+    QCOMPARE(matcher.indexIn(haystack, 9, &patternIndex), 17);
+    QCOMPARE(patternIndex, 2);
+
+    const QMultiByteArrayMatcher sensitive(patterns);
+    QCOMPARE(sensitive.indexIn(haystack), -1);
+}
+
+void tst_QMultiByteArrayMatcher::prefilter()
+{
+    // Few distinct first bytes enable the SIMD scan for candidates; place
+    // the matches around the 16-byte block boundaries
+    const QList<QByteArray> patterns = { "needle", "nail", "pin" };
+    const QMultiByteArrayMatcher matcher(patterns);
+    for (qsizetype pos : { 0, 1, 14, 15, 16, 17, 31, 32, 60 }) {
+        QByteArray haystack(64, 'x');
+        haystack.replace(pos, 3, "pin");
+        QCOMPARE(matcher.indexIn(haystack), pos);
+        QCOMPARE(matcher.matchesIn(haystack), bruteForce(haystack, patterns));
+
+        haystack.replace(pos, 3, "nai");
+        QCOMPARE(matcher.indexIn(haystack), -1);
+    }
+}
+
+void tst_QMultiByteArrayMatcher::manyPatterns()
+{
+    QList<QByteArray> patterns;
+    for (int i = 0; i < 300; ++i)
+        patterns.append("kw" + QByteArray::number(i * 37 % 1000) + char('a' + i % 26));
+    const QMultiByteArrayMatcher matcher(patterns);
+
+    QByteArray haystack;
+    for (int i = 0; i < 2000; ++i)
+        haystack += "kw" + QByteArray::number(i) + char('a' + i % 26) + ' ';
+    QCOMPARE(matcher.matchesIn(haystack), bruteForce(haystack, patterns));
+
+    const QList<Match> all = bruteForce(haystack, patterns);
+    QVERIFY(!all.isEmpty());
+    const auto leftmost = std::min_element(all.begin(), all.end(),
+                                           [](const Match &a, const Match &b) {
+        return a.position < b.position;
+    });
+    QCOMPARE(matcher.indexIn(haystack), leftmost->position);
+}
+
+QTEST_APPLESS_MAIN(tst_QMultiByteArrayMatcher)
+#include "tst_qmultibytearraymatcher.moc"
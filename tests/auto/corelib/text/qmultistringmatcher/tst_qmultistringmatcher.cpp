@@ -0,0 +1,163 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+
+#include <QtCore/QMultiStringMatcher>
+
+using namespace Qt::StringLiterals;
+using Match = QMultiStringMatcher::Match;
+
+class tst_QMultiStringMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void empty();
+    void indexIn_data();
+    void indexIn();
+    void matchesIn_data() { indexIn_data(); }
+    void matchesIn();
+    void largeAlphabet();
+};
+
+// Reference implementation: all matches, in the order matchesIn() reports them
+static QList<Match> bruteForce(QStringView str, const QStringList &patterns,
+                               Qt::CaseSensitivity cs)
+{
+    QList<Match> result;
+    for (qsizetype end = 1; end <= str.size(); ++end) {
+        QList<Match> here;
+        for (qsizetype p = 0; p < patterns.size(); ++p) {
+            const qsizetype len = patterns.at(p).size();
+            if (len == 0 || len > end)
+                continue;
+            if (str.sliced(end - len, len).compare(patterns.at(p), cs) == 0)
+                here.append(Match{end - len, len, p});
+        }
+        std::stable_sort(here.begin(), here.end(), [](const Match &a, const Match &b) {
+            return a.length > b.length;
+        });
+        result += here;
+    }
+    return result;
+}
+
+static bool operator==(const Match &lhs, const Match &rhs)
+{
+    return lhs.position == rhs.position && lhs.length == rhs.length
+            && lhs.patternIndex == rhs.patternIndex;
+}
+
+namespace QTest {
+template <> char *toString(const Match &m)
+{
+    const QByteArray str = QByteArray::number(m.position) + '+' + QByteArray::number(m.length)
+            + " #" + QByteArray::number(m.patternIndex);
+    return qstrdup(str.constData());
+}
+}
+
+void tst_QMultiStringMatcher::empty()
+{
+    QMultiStringMatcher none;
+    QVERIFY(none.patterns().isEmpty());
+    QCOMPARE(none.indexIn(u"abc"), -1);
+    QVERIFY(none.matchesIn(u"abc").isEmpty());
+
+    QMultiStringMatcher emptyPatterns({ QString(), u""_s });
+    qsizetype patternIndex = 42;
+    QCOMPARE(emptyPatterns.indexIn(u"abc", 0, &patternIndex), -1);
+    QCOMPARE(patternIndex, -1);
+}
+
+void tst_QMultiStringMatcher::indexIn_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+    QTest::addColumn<QString>("haystack");
+    QTest::addColumn<qsizetype>("index");
+    QTest::addColumn<qsizetype>("patternIndex");
+
+    const QStringList he = { u"he"_s, u"she"_s, u"his"_s, u"hers"_s };
+    QTest::newRow("ushers") << he << Qt::CaseSensitive << u"ushers"_s
+                            << qsizetype(1) << qsizetype(1);
+    QTest::newRow("ushers-ci") << he << Qt::CaseInsensitive << u"USHERS"_s
+                               << qsizetype(1) << qsizetype(1);
+    QTest::newRow("no-match") << he << Qt::CaseSensitive << u"USHERS"_s
+                              << qsizetype(-1) << qsizetype(-1);
+    const QStringList greek = { u"αβγ"_s, u"δ"_s, u"Straße"_s };
+    QTest::newRow("greek") << greek << Qt::CaseSensitive << u"ΑΒΓ αβγ"_s
+                           << qsizetype(4) << qsizetype(0);
+    QTest::newRow("greek-ci") << greek << Qt::CaseInsensitive << u"ΑΒΓ αβγ Δ"_s
+                              << qsizetype(0) << qsizetype(0);
+    QTest::newRow("latin1-ci") << greek << Qt::CaseInsensitive << u"STRAßE"_s
+                               << qsizetype(0) << qsizetype(2);
+    // µ (U+00B5) folds to μ (U+03BC)
+    QTest::newRow("micro-ci") << QStringList{ u"μs"_s } << Qt::CaseInsensitive
+                              << u"5 µS"_s << qsizetype(2) << qsizetype(0);
+    // characters outside Latin-1 that fold into it
+    QTest::newRow("kelvin-ci") << QStringList{ u"ok"_s } << Qt::CaseInsensitive
+                               << u"is O\u212A"_s << qsizetype(3) << qsizetype(0);
+    QTest::newRow("kelvin-cs") << QStringList{ u"ok"_s } << Qt::CaseSensitive
+                               << u"is o\u212A"_s << qsizetype(-1) << qsizetype(-1);
+    QTest::newRow("long-s-ci") << QStringList{ u"ss"_s } << Qt::CaseInsensitive
+                               << u"Gro\u017Fs"_s << qsizetype(3) << qsizetype(0);
+    QTest::newRow("sharp-s-ci") << QStringList{ u"straße"_s } << Qt::CaseInsensitive
+                                << u"STRA\u1E9EE"_s << qsizetype(0) << qsizetype(0);
+    QTest::newRow("surrogates") << QStringList{ u"😀"_s, u"x😀"_s } << Qt::CaseSensitive
+                                << u"ab😀x😀"_s << qsizetype(2) << qsizetype(0);
+    QTest::newRow("leftmost") << QStringList{ u"défaut"_s, u"fa"_s } << Qt::CaseSensitive
+                              << u"par défaut"_s << qsizetype(4) << qsizetype(0);
+}
+
+void tst_QMultiStringMatcher::indexIn()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(Qt::CaseSensitivity, cs);
+    QFETCH(QString, haystack);
+    QFETCH(qsizetype, index);
+    QFETCH(qsizetype, patternIndex);
+
+    const QMultiStringMatcher matcher(patterns, cs);
+    QCOMPARE(matcher.patterns(), patterns);
+    QCOMPARE(matcher.caseSensitivity(), cs);
+
+    qsizetype foundPattern = -2;
+    QCOMPARE(matcher.indexIn(haystack, 0, &foundPattern), index);
+    QCOMPARE(foundPattern, patternIndex);
+}
+
+void tst_QMultiStringMatcher::matchesIn()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(Qt::CaseSensitivity, cs);
+    QFETCH(QString, haystack);
+
+    const QMultiStringMatcher matcher(patterns, cs);
+    QCOMPARE(matcher.matchesIn(haystack), bruteForce(haystack, patterns, cs));
+}
+
+void tst_QMultiStringMatcher::largeAlphabet()
+{
+    // Enough distinct characters that the automaton does not use a full
+    // transition table, but follows failure links instead
+    const auto ideograph = [](int i) { return QChar(char16_t(0x4e00 + i % 1200)); };
+    QStringList patterns;
+    for (int i = 0; i < 1500; ++i)
+        patterns.append(QString(ideograph(i)) + ideograph(i * 7) + ideograph(i * 13));
+    const QMultiStringMatcher matcher(patterns);
+
+    QString haystack;
+    for (int i = 0; i < 5000; ++i)
+        haystack += ideograph(i * i + 3 * i);
+    for (int i = 0; i < 1500; i += 97)
+        haystack += patterns.at(i);
+
+    const QList<Match> expected = bruteForce(haystack, patterns, Qt::CaseSensitive);
+    QVERIFY(!expected.isEmpty());
+    QCOMPARE(matcher.matchesIn(haystack), expected);
+}
+
+QTEST_APPLESS_MAIN(tst_QMultiStringMatcher)
+#include "tst_qmultistringmatcher.moc"
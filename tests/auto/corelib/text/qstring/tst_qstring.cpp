@@ -22,6 +22,7 @@
 #include <qstringmatcher.h>
 #include <qbytearraymatcher.h>
 #include <qvariant.h>
+#include <qvarlengtharray.h>
 
 #include <qlocale.h>
 #include <locale.h>
@@ -6868,6 +6869,15 @@ void tst_QString::number_double()
         }
     }
     QTEST(QString::number(value, format, precision), "expected");
+
+    QFETCH(const QString, expected);
+    QVarLengthArray<char16_t, 64> buffer(expected.size());
+    QCOMPARE(QString::number(value, buffer, format, precision), expected.size());
+    QCOMPARE(QStringView(buffer.data(), buffer.size()), expected);
+    if (!expected.isEmpty()) {
+        const QSpan<char16_t> tooSmall(buffer.data(), buffer.size() - 1);
+        QCOMPARE(QString::number(value, tooSmall, format, precision), -1);
+    }
 }
 
 void tst_QString::number_base_data()
@@ -170,6 +170,8 @@ private slots:
 
     void utf8Codec_data();
     void utf8Codec();
+    void utf8LargeInput_data();
+    void utf8LargeInput();
 
     void utf8bom_data();
     void utf8bom();
@@ -1821,6 +1823,54 @@ void tst_QStringConverter::utf8Codec()
     QCOMPARE(str, res);
 }
 
+void tst_QStringConverter::utf8LargeInput_data()
+{
+    QTest::addColumn<QByteArray>("pattern");
+    QTest::addColumn<bool>("hasErrors");
+
+    QTest::newRow("ascii") << QByteArray("The quick brown fox jumps over the lazy dog.\n") << false;
+    QTest::newRow("latin") << QByteArray("Voil\xc3\xa0 d\xc3\xa9j\xc3\xa0 l'\xc3\xa9t\xc3\xa9 ") << false;
+    // no US-ASCII at all, so the input can only be split after complete sequences
+    QTest::newRow("cjk") << QByteArray("\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e\xf0\x9f\x98\x80") << false;
+    QTest::newRow("bom-inside") << QByteArray("\xe2\x82\xac\xef\xbb\xbf") << false;
+    QTest::newRow("errors")
+            << QByteArray("\xe2\x82\xac\xe2\x82" "ab\xc0\xaf\xed\xa0\x80\x80\x80\xf4\x90\x80\x80\xff")
+            << true;
+    QTest::newRow("errors-no-ascii")
+            << QByteArray("\xe6\x97\xa5\xe2\x82\x80\x80\xe6\x97\xa5\xf0\x9f\x98") << true;
+}
+
+void tst_QStringConverter::utf8LargeInput()
+{
+    QFETCH(QByteArray, pattern);
+    QFETCH(bool, hasErrors);
+
+    // Make sure large inputs get split, even on a single-core machine
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int maxThreadCount = pool->maxThreadCount();
+    pool->setMaxThreadCount(4);
+    const auto restore = qScopeGuard([&] { pool->setMaxThreadCount(maxThreadCount); });
+
+    // An odd size, so that the pattern does not line up with the segments.
+    // Each repetition of the pattern decodes the same way as the pattern alone.
+    const qsizetype count = 20 * 1024 * 1024 / pattern.size() + 7;
+    QByteArray utf8 = "\xef\xbb\xbf" + pattern.repeated(count) + '\n';
+    const QString expected = QString::fromUtf8(pattern).repeated(count) + u'\n';
+
+    QCOMPARE(QString::fromUtf8(utf8), expected);
+
+    QStringDecoder decoder(QStringDecoder::Utf8);
+    QCOMPARE(QString(decoder(utf8)), expected);
+    QCOMPARE(decoder.hasError(), hasErrors);
+
+    // ending in the middle of a sequence, which the decoder keeps for later
+    QStringDecoder pieceWise(QStringDecoder::Utf8);
+    QString decoded = pieceWise(QByteArray(utf8 + "\xe6\x97"));
+    decoded += pieceWise("\xa5");
+    QCOMPARE(decoded, QString(expected + u'\x65e5'));
+    QCOMPARE(pieceWise.hasError(), hasErrors);
+}
+
 QT_WARNING_PUSH
 QT_WARNING_DISABLE_DEPRECATED
 void tst_QStringConverter::utf8bom_data()
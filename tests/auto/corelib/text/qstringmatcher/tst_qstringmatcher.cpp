@@ -4,6 +4,8 @@
 #include <QTest>
 #include <qstringmatcher.h>
 
+#include <algorithm>
+
 class tst_QStringMatcher : public QObject
 {
     Q_OBJECT
@@ -13,6 +15,7 @@ private slots:
     void caseSensitivity();
     void indexIn_data();
     void indexIn();
+    void indexInLongHaystack();
     void setCaseSensitivity_data();
     void setCaseSensitivity();
     void assignOperator();
@@ -83,6 +86,34 @@ void tst_QStringMatcher::indexIn()
     QCOMPARE(matcherSV.indexIn(QStringView(haystack), from), indexIn);
 }
 
+void tst_QStringMatcher::indexInLongHaystack()
+{
+    // Exercise the vectorized search: block boundaries, candidates that
+    // match the first and last character of the needle only, and the tail
+    for (qsizetype needleSize : {2, 3, 7, 8, 9, 16, 17, 64}) {
+        QString needle(needleSize, Qt::Uninitialized);
+        for (qsizetype i = 0; i < needleSize; ++i)
+            needle[i] = QChar(char16_t(u'\x430' + i % 32)); // not Latin-1, to test both bytes
+        QString decoy = needle;
+        if (needleSize > 2)
+            decoy[needleSize / 2] = u'-';
+
+        const QStringMatcher matcher(needle);
+        for (qsizetype pos : {0, 1, 7, 8, 15, 16, 17, 100, 253}) {
+            QString haystack(256 + needleSize, u'\x431');
+            if (needleSize > 2)
+                haystack.replace(pos / 2, needleSize, decoy);
+            haystack.replace(pos, needleSize, needle);
+            const qsizetype expected = std::search(haystack.cbegin(), haystack.cend(),
+                                                   needle.cbegin(), needle.cend())
+                    - haystack.cbegin();
+            QCOMPARE(matcher.indexIn(haystack), expected);
+            QCOMPARE(matcher.indexIn(haystack, expected + 1), -1);
+            QCOMPARE(haystack.indexOf(needle), expected);
+        }
+    }
+}
+
 void tst_QStringMatcher::setCaseSensitivity_data()
 {
     QTest::addColumn<QString>("needle");
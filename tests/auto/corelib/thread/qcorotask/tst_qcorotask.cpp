@@ -0,0 +1,338 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+#include <QThread>
+#include <QTimer>
+#include <qcorotask.h>
+#include <qpromise.h>
+
+#include <memory>
+
+using namespace std::chrono_literals;
+using namespace Qt::StringLiterals;
+
+// The coroutines in this test are lambdas without captures: captures live in
+// the closure, which is destroyed when the coroutine is first suspended.
+
+class SenderObject : public QObject
+{
+    Q_OBJECT
+signals:
+    void noArgSignal();
+    void intArgSignal(int value);
+    void multipleArgs(int value, double ratio, const QString &text);
+};
+
+class tst_QCoroTask : public QObject
+{
+    Q_OBJECT
+private slots:
+    void awaitFinishedFuture();
+    void awaitPendingFuture();
+    void awaitVoidFuture();
+    void awaitMoveOnlyResult();
+#ifndef QT_NO_EXCEPTIONS
+    void awaitFailedFuture();
+    void throwFromCoroutine();
+#endif
+    void awaitCanceledFuture();
+    void awaitTask();
+    void resumeInContext();
+    void resumeInDestroyedContext();
+    void awaitSignal();
+    void awaitTimeout();
+    void awaitSignalOfDestroyedSender();
+};
+
+#if defined(__cpp_impl_coroutine)
+
+void tst_QCoroTask::awaitFinishedFuture()
+{
+    auto task = [](QFuture<int> future) -> QCoroTask<int> {
+        co_return co_await future + 1;
+    }(QtFuture::makeReadyValueFuture(41));
+
+    QVERIFY(task.future().isFinished());
+    QCOMPARE(task.future().result(), 42);
+}
+
+void tst_QCoroTask::awaitPendingFuture()
+{
+    QPromise<int> promise;
+    promise.start();
+    bool resumed = false;
+    auto task = [](QFuture<int> future, bool *resumed) -> QCoroTask<int> {
+        const int value = co_await future;
+        *resumed = true;
+        co_return value * 2;
+    }(promise.future(), &resumed);
+
+    QVERIFY(!resumed);
+    QVERIFY(!task.future().isFinished());
+
+    promise.addResult(21);
+    promise.finish();
+    QVERIFY(resumed);
+    QVERIFY(task.future().isFinished());
+    QCOMPARE(task.future().result(), 42);
+}
+
+void tst_QCoroTask::awaitVoidFuture()
+{
+    QPromise<void> promise;
+    promise.start();
+    int steps = 0;
+    auto task = [](QFuture<void> future, int *steps) -> QCoroTask<> {
+        ++*steps;
+        co_await future;
+        ++*steps;
+    }(promise.future(), &steps);
+
+    QCOMPARE(steps, 1);
+    promise.finish();
+    QCOMPARE(steps, 2);
+    QVERIFY(task.future().isFinished());
+    QVERIFY(!task.future().isCanceled());
+}
+
+void tst_QCoroTask::awaitMoveOnlyResult()
+{
+    QPromise<std::unique_ptr<int>> promise;
+    promise.start();
+    auto task = [](QFuture<std::unique_ptr<int>> future) -> QCoroTask<std::unique_ptr<int>> {
+        auto value = co_await future;
+        ++*value;
+        co_return value;
+    }(promise.future());
+
+    promise.addResult(std::make_unique<int>(41));
+    promise.finish();
+    QCOMPARE(*task.future().takeResult(), 42);
+}
+
+#ifndef QT_NO_EXCEPTIONS
+void tst_QCoroTask::awaitFailedFuture()
+{
+    QPromise<int> promise;
+    promise.start();
+    bool caught = false;
+    auto task = [](QFuture<int> future, bool *caught) -> QCoroTask<int> {
+        try {
+            co_return co_await future;
+        } catch (const QException &) {
+            *caught = true;
+        }
+        co_return -1;
+    }(promise.future(), &caught);
+
+    promise.setException(QException());
+    promise.finish();
+    QVERIFY(caught);
+    QCOMPARE(task.future().result(), -1);
+}
+
+void tst_QCoroTask::throwFromCoroutine()
+{
+    auto task = []() -> QCoroTask<int> {
+        co_await QtFuture::makeReadyVoidFuture();
+        throw QException();
+    }();
+
+    QVERIFY(task.future().isFinished());
+    QVERIFY_THROWS_EXCEPTION(QException, task.future().result());
+}
+#endif
+
+void tst_QCoroTask::awaitCanceledFuture()
+{
+    bool resumed = false;
+    auto task = [](QFuture<int> future, bool *resumed) -> QCoroTask<int> {
+        const int value = co_await future;
+        *resumed = true;
+        co_return value;
+    };
+
+    // Already canceled
+    QPromise<int> canceled;
+    canceled.start();
+    canceled.future().cancel();
+    canceled.finish();
+    auto first = task(canceled.future(), &resumed);
+    QVERIFY(!resumed);
+    QVERIFY(first.future().isFinished());
+    QVERIFY(first.future().isCanceled());
+
+    // Canceled while awaited, by destroying the promise
+    auto promise = std::make_unique<QPromise<int>>();
+    promise->start();
+    auto second = task(promise->future(), &resumed);
+    QVERIFY(!second.future().isFinished());
+    promise.reset();
+    QVERIFY(!resumed);
+    QVERIFY(second.future().isFinished());
+    QVERIFY(second.future().isCanceled());
+}
+
+void tst_QCoroTask::awaitTask()
+{
+    QPromise<int> promise;
+    promise.start();
+    static constexpr auto inner = [](QFuture<int> future) -> QCoroTask<int> {
+        co_return co_await future * 2;
+    };
+    static constexpr auto outer = [](QFuture<int> future) -> QCoroTask<QString> {
+        const int value = co_await inner(future);
+        co_return QString::number(value);
+    };
+    auto task = outer(promise.future());
+
+    promise.addResult(21);
+    promise.finish();
+    QCOMPARE(task.future().result(), u"42");
+
+    // Cancellation propagates through awaiting tasks
+    QPromise<int> canceled;
+    canceled.start();
+    auto chain = outer(canceled.future());
+    canceled.future().cancel();
+    canceled.finish();
+    QVERIFY(chain.future().isCanceled());
+}
+
+void tst_QCoroTask::resumeInContext()
+{
+    QPromise<int> promise;
+    promise.start();
+    QObject context;
+    QThread *resumedIn = nullptr;
+    auto task = [](QFuture<int> future, QObject *context, QThread **resumedIn)
+            -> QCoroTask<int> {
+        const int value = co_await QtFuture::resumeIn(context, future);
+        *resumedIn = QThread::currentThread();
+        co_return value;
+    }(promise.future(), &context, &resumedIn);
+
+    std::unique_ptr<QThread> thread(QThread::create([&promise] {
+        promise.addResult(42);
+        promise.finish();
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+
+    // Resumed through the event loop of the context's thread
+    QVERIFY(!resumedIn);
+    QTRY_VERIFY(task.future().isFinished());
+    QCOMPARE(resumedIn, QThread::currentThread());
+    QCOMPARE(task.future().result(), 42);
+}
+
+void tst_QCoroTask::resumeInDestroyedContext()
+{
+    QPromise<int> promise;
+    promise.start();
+    auto context = std::make_unique<QObject>();
+    bool resumed = false;
+    auto task = [](QFuture<int> future, QObject *context, bool *resumed) -> QCoroTask<int> {
+        const int value = co_await QtFuture::resumeIn(context, future);
+        *resumed = true;
+        co_return value;
+    }(promise.future(), context.get(), &resumed);
+
+    context.reset();
+    QVERIFY(task.future().isFinished());
+    QVERIFY(task.future().isCanceled());
+
+    promise.addResult(42);
+    promise.finish();
+    QCoreApplication::processEvents();
+    QVERIFY(!resumed);
+}
+
+void tst_QCoroTask::awaitSignal()
+{
+    SenderObject sender;
+
+    auto noArg = [](SenderObject *sender) -> QCoroTask<> {
+        co_await QtFuture::signalEmitted(sender, &SenderObject::noArgSignal);
+    }(&sender);
+    auto intArg = [](SenderObject *sender) -> QCoroTask<int> {
+        co_return co_await QtFuture::signalEmitted(sender, &SenderObject::intArgSignal);
+    }(&sender);
+    auto multipleArgs = [](SenderObject *sender) -> QCoroTask<QString> {
+        const auto [value, ratio, text] =
+                co_await QtFuture::signalEmitted(sender, &SenderObject::multipleArgs);
+        co_return text.arg(value).arg(ratio);
+    }(&sender);
+
+    QVERIFY(!noArg.future().isFinished());
+    emit sender.noArgSignal();
+    QVERIFY(noArg.future().isFinished());
+
+    emit sender.intArgSignal(42);
+    QCOMPARE(intArg.future().result(), 42);
+
+    emit sender.multipleArgs(42, 0.5, u"%1 %2"_s);
+    QCOMPARE(multipleArgs.future().result(), u"42 0.5");
+
+    // Only the first emission resumes
+    emit sender.intArgSignal(1);
+    QCOMPARE(intArg.future().resultCount(), 1);
+    QCOMPARE(intArg.future().result(), 42);
+}
+
+void tst_QCoroTask::awaitTimeout()
+{
+    QTimer timer;
+    timer.setSingleShot(true);
+    auto task = [](QTimer *timer) -> QCoroTask<> {
+        timer->start(10ms);
+        co_await QtFuture::signalEmitted(timer, &QTimer::timeout);
+    }(&timer);
+
+    QVERIFY(!task.future().isFinished());
+    QTRY_VERIFY(task.future().isFinished());
+    QVERIFY(!task.future().isCanceled());
+}
+
+void tst_QCoroTask::awaitSignalOfDestroyedSender()
+{
+    auto sender = std::make_unique<SenderObject>();
+    bool resumed = false;
+    auto task = [](SenderObject *sender, bool *resumed) -> QCoroTask<int> {
+        const int value = co_await QtFuture::signalEmitted(sender, &SenderObject::intArgSignal);
+        *resumed = true;
+        co_return value;
+    }(sender.get(), &resumed);
+
+    sender.reset();
+    QVERIFY(!resumed);
+    QVERIFY(task.future().isFinished());
+    QVERIFY(task.future().isCanceled());
+}
+
+#else
+
+#define SKIP_TEST \
+    QSKIP("This test requires a compiler with support for C++20 coroutines")
+
+void tst_QCoroTask::awaitFinishedFuture() { SKIP_TEST; }
+void tst_QCoroTask::awaitPendingFuture() { SKIP_TEST; }
+void tst_QCoroTask::awaitVoidFuture() { SKIP_TEST; }
+void tst_QCoroTask::awaitMoveOnlyResult() { SKIP_TEST; }
+#ifndef QT_NO_EXCEPTIONS
+void tst_QCoroTask::awaitFailedFuture() { SKIP_TEST; }
+void tst_QCoroTask::throwFromCoroutine() { SKIP_TEST; }
+#endif
+void tst_QCoroTask::awaitCanceledFuture() { SKIP_TEST; }
+void tst_QCoroTask::awaitTask() { SKIP_TEST; }
+void tst_QCoroTask::resumeInContext() { SKIP_TEST; }
+void tst_QCoroTask::resumeInDestroyedContext() { SKIP_TEST; }
+void tst_QCoroTask::awaitSignal() { SKIP_TEST; }
+void tst_QCoroTask::awaitTimeout() { SKIP_TEST; }
+void tst_QCoroTask::awaitSignalOfDestroyedSender() { SKIP_TEST; }
+
+#endif // __cpp_impl_coroutine
+
+QTEST_MAIN(tst_QCoroTask)
+#include "tst_qcorotask.moc"
@@ -196,6 +196,7 @@ private slots:
 
     void then();
     void thenForMoveOnlyTypes();
+    void thenWithExecutor();
     void thenOnCanceledFuture();
 #ifndef QT_NO_EXCEPTIONS
     void thenOnExceptionFuture();
@@ -2338,6 +2339,60 @@ QFuture<T> createCanceledFuture()
     return promise.future();
 }
 
+class QueueExecutor : public QtFuture::Executor
+{
+public:
+    void execute(QRunnable *runnable) override { queue.append(runnable); }
+    void runAll()
+    {
+        while (!queue.isEmpty())
+            queue.takeFirst()->run();
+    }
+
+    QList<QRunnable *> queue;
+};
+
+void tst_QFuture::thenWithExecutor()
+{
+    QueueExecutor executor;
+
+    // Continuation attached before the parent finishes
+    {
+        QPromise<int> promise;
+        auto future = promise.future()
+                .then(&executor, [](int value) { return value * 2; })
+                .then(QtFuture::Launch::Inherit, [](int value) { return value + 1; });
+        promise.start();
+        promise.addResult(20);
+        promise.finish();
+        QCOMPARE(executor.queue.size(), 1);
+        QVERIFY(!future.isFinished());
+        executor.runAll();
+        QVERIFY(future.isFinished());
+        QCOMPARE(future.result(), 41);
+    }
+
+    // Continuation attached to a finished future
+    {
+        auto future = QtFuture::makeReadyValueFuture(std::make_unique<int>(42))
+                .then(&executor, [](QFuture<std::unique_ptr<int>> f) {
+                    return *f.takeResult();
+                });
+        QCOMPARE(executor.queue.size(), 1);
+        executor.runAll();
+        QCOMPARE(future.result(), 42);
+    }
+
+    // Canceled parent
+    {
+        bool run = false;
+        auto future = createCanceledFuture<int>().then(&executor, [&run](int) { run = true; });
+        executor.runAll();
+        QVERIFY(future.isCanceled());
+        QVERIFY(!run);
+    }
+}
+
 void tst_QFuture::thenOnCanceledFuture()
 {
     // Continuations on a canceled future
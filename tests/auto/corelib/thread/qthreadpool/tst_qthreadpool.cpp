@@ -13,6 +13,12 @@
 
 #ifdef Q_OS_UNIX
 #include <unistd.h>
+
+#if defined(Q_OS_LINUX)
+#include <QFile>
+#include <QSet>
+#include <sched.h>
+#endif
 #endif
 
 using namespace std::chrono_literals;
@@ -83,6 +89,7 @@ private slots:
     void waitForDoneTimeout();
     void destroyingWaitsForTasksToFinish();
     void stackSize();
+    void numaNode();
     void stressTest();
     void takeAllAndIncreaseMaxThreadCount();
     void waitForDoneAfterTake();
@@ -1285,6 +1292,42 @@ void tst_QThreadPool::stackSize()
     QCOMPARE(threadStackSize, targetStackSize);
 }
 
+void tst_QThreadPool::numaNode()
+{
+    TestThreadPool threadPool;
+    QCOMPARE(threadPool.numaNode(), -1);
+
+#if defined(Q_OS_LINUX)
+    QFile cpuList("/sys/devices/system/node/node0/cpulist");
+    if (!cpuList.open(QIODevice::ReadOnly))
+        QSKIP("No NUMA information available");
+    QSet<int> nodeCpus;
+    for (const QByteArray &range : cpuList.readAll().trimmed().split(',')) {
+        const qsizetype dash = range.indexOf('-');
+        const int first = range.left(dash).toInt();
+        const int last = dash < 0 ? first : range.mid(dash + 1).toInt();
+        for (int cpu = first; cpu <= last; ++cpu)
+            nodeCpus.insert(cpu);
+    }
+
+    QSet<int> threadCpus;
+    threadPool.setNumaNode(0);
+    QCOMPARE(threadPool.numaNode(), 0);
+    threadPool.start([&threadCpus] {
+        cpu_set_t cpus;
+        if (sched_getaffinity(0, sizeof(cpus), &cpus) != 0)
+            return;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &cpus))
+                threadCpus.insert(cpu);
+        }
+    });
+    WAIT_FOR_DONE(threadPool);
+    QVERIFY(!threadCpus.isEmpty());
+    QVERIFY(nodeCpus.contains(threadCpus));
+#endif
+}
+
 void tst_QThreadPool::stressTest()
 {
     class Task : public QRunnable
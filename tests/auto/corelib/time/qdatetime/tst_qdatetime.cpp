@@ -10,6 +10,8 @@
 #include <private/qtenvironmentvariables_p.h> // for qTzSet(), qTzName()
 #include <private/qcomparisontesthelper_p.h>
 
+#include <vector>
+
 #if defined(Q_OS_WIN) && !QT_CONFIG(icu)
 #  define USING_WIN_TZ
 #endif
@@ -68,6 +70,8 @@ private Q_SLOTS:
     void fromSecsSinceEpoch();
     void fromMSecsSinceEpoch_data() { setMSecsSinceEpoch_data(); }
     void fromMSecsSinceEpoch();
+    void bulkEpochConversion_data();
+    void bulkEpochConversion();
 #if QT_CONFIG(datestring)
     void toString_isoDate_data();
     void toString_isoDate();
@@ -940,6 +944,63 @@ void tst_QDateTime::fromMSecsSinceEpoch()
         QCOMPARE(dtOffset, reference.addMSecs(msecs));
 }
 
+void tst_QDateTime::bulkEpochConversion_data()
+{
+    QTest::addColumn<QTimeZone>("zone");
+
+    QTest::newRow("UTC") << QTimeZone(QTimeZone::UTC);
+    QTest::newRow("UTC+05:30") << QTimeZone::fromSecondsAheadOfUtc(5 * 3600 + 1800);
+    QTest::newRow("LocalTime") << QTimeZone(QTimeZone::LocalTime);
+#if QT_CONFIG(timezone)
+    for (const char *id : { "Europe/Berlin", "America/Sao_Paulo", "Australia/Lord_Howe" }) {
+        const QTimeZone zone(id);
+        if (zone.isValid())
+            QTest::newRow(id) << zone;
+    }
+#endif
+}
+
+void tst_QDateTime::bulkEpochConversion()
+{
+    QFETCH(const QTimeZone, zone);
+
+    // Hourly over two years, straddling transitions, then scattered values,
+    // including ones around transitions and far from the epoch:
+    std::vector<qint64> msecs;
+    const qint64 start = QDateTime(QDate(2011, 1, 1), QTime(0, 0), QTimeZone::UTC)
+                                 .toMSecsSinceEpoch();
+    for (qint64 hour = 0; hour < 2 * 366 * 24; ++hour)
+        msecs.push_back(start + hour * 3600 * 1000 + 123);
+    const qint64 day = 24 * 3600 * 1000;
+    for (qint64 value : { qint64(0), qint64(-1), -1000 * day, 1000 * day, 40000 * day,
+                          -40000 * day, start + 3600 * 1000, start - 1 }) {
+        msecs.push_back(value);
+    }
+
+    std::vector<QDate> dates(msecs.size());
+    std::vector<QTime> times(msecs.size());
+    QDateTime::fromMSecsSinceEpoch(msecs, zone, dates, times);
+    for (size_t i = 0; i < msecs.size(); ++i) {
+        const QDateTime expected = QDateTime::fromMSecsSinceEpoch(msecs[i], zone);
+        QCOMPARE(dates[i], expected.date());
+        QCOMPARE(times[i], expected.time());
+    }
+
+    // Back, including local times that are skipped or repeated by transitions:
+    for (int minutes = 0; minutes < 24 * 60; minutes += 15) {
+        dates.push_back(QDate(2012, 3, 25));
+        times.push_back(QTime(0, 0).addSecs(minutes * 60));
+        dates.push_back(QDate(2012, 10, 28));
+        times.push_back(QTime(0, 0).addSecs(minutes * 60));
+    }
+    dates.push_back(QDate());
+    times.push_back(QTime(12, 0));
+    std::vector<qint64> back(dates.size());
+    QDateTime::toMSecsSinceEpoch(dates, times, zone, back);
+    for (size_t i = 0; i < dates.size(); ++i)
+        QCOMPARE(back[i], QDateTime(dates[i], times[i], zone).toMSecsSinceEpoch());
+}
+
 void tst_QDateTime::fromSecsSinceEpoch()
 {
     // Compare setSecsSinceEpoch()
@@ -9,6 +9,8 @@
 #include <qlocale.h>
 #include <qscopeguard.h>
 
+#include <vector>
+
 #if defined(Q_OS_WIN)
 #include <QOperatingSystemVersion>
 #endif
@@ -59,6 +61,7 @@ private Q_SLOTS:
     void utcTest();
     void icuTest();
     void tzTest();
+    void tzDatabase();
     void macTest();
     void darwinTypes();
     void winTest();
@@ -1590,6 +1593,52 @@ void tst_QTimeZone::tzTest()
 #endif // QT_BUILD_INTERNAL && Q_OS_UNIX && !Q_OS_DARWIN && !Q_OS_ANDROID
 }
 
+void tst_QTimeZone::tzDatabase()
+{
+#if defined QT_BUILD_INTERNAL && defined Q_OS_UNIX && !defined Q_OS_DARWIN && !defined Q_OS_ANDROID
+    const QByteArray stamp = QTzDatabase::sourceStamp();
+    if (stamp.isEmpty())
+        QSKIP("No zoneinfo directory found");
+    const QByteArray compiled = QTzDatabase::compile(stamp);
+    QVERIFY(!compiled.isEmpty());
+    // QByteArray's data may be less aligned than the database needs
+    std::vector<quint64> aligned((compiled.size() + 7) / 8);
+    memcpy(aligned.data(), compiled.constData(), compiled.size());
+    const QByteArrayView data(reinterpret_cast<const char *>(aligned.data()), compiled.size());
+
+    const QTzDatabase database(data);
+    QVERIFY(database.isValid());
+    QCOMPARE(database.stamp(), stamp);
+    QCOMPARE(database.availableTimeZoneIds(), QTimeZone::availableTimeZoneIds());
+    QVERIFY(!database.contains("Gondwana/Erewhon"));
+
+    const auto berlin = database.entry("Europe/Berlin");
+    QVERIFY(berlin);
+    QVERIFY(berlin->m_hasDst);
+    QCOMPARE(database.territory("Europe/Berlin"), QLocale::Germany);
+    const qint64 summer = QDateTime(QDate(2012, 6, 1), QTime(0, 0), QTimeZone::UTC)
+                                  .toMSecsSinceEpoch();
+    const auto &times = berlin->m_tranTimes;
+    auto last = std::partition_point(times.cbegin(), times.cend(),
+                                     [summer](const QTzTransitionTime &at) {
+                                         return at.atMSecsSinceEpoch <= summer;
+                                     });
+    QVERIFY(last != times.cbegin());
+    const QTzTransitionRule rule = berlin->m_tranRules.at((--last)->ruleIndex);
+    QCOMPARE(rule.stdOffset, 3600);
+    QCOMPARE(rule.dstOffset, 3600);
+    QCOMPARE(berlin->m_abbreviations.at(rule.abbreviationIndex), "CEST");
+
+    // Damaged data must be rejected
+    QVERIFY(!QTzDatabase(data.first(data.size() - 1)).isValid());
+    QVERIFY(!QTzDatabase(data.sliced(8)).isValid());
+    std::vector<quint64> corrupt = aligned;
+    reinterpret_cast<char *>(corrupt.data())[0] = 'X';
+    QVERIFY(!QTzDatabase(QByteArrayView(reinterpret_cast<const char *>(corrupt.data()),
+                                        data.size())).isValid());
+#endif // QT_BUILD_INTERNAL && Q_OS_UNIX && !Q_OS_DARWIN && !Q_OS_ANDROID
+}
+
 void tst_QTimeZone::macTest()
 {
 #if defined(QT_BUILD_INTERNAL) && defined(Q_OS_DARWIN)
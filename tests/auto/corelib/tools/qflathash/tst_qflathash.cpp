@@ -0,0 +1,269 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+
+#include <QtCore/QFlatHash>
+
+#include <memory>
+#include <unordered_map>
+
+using namespace Qt::StringLiterals;
+
+class tst_QFlatHash : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void empty();
+    void insertRemove_data();
+    void insertRemove();
+    void tombstones();
+    void emplaceFromElement();
+    void copyAndMove();
+    void heterogeneousLookup();
+    void iterators();
+    void reserveSqueeze();
+    void nonRelocatable();
+};
+
+// Keys with a hash that leaves little choice, so probing crosses groups
+struct Collider
+{
+    int value;
+    friend bool operator==(Collider a, Collider b) noexcept { return a.value == b.value; }
+    friend size_t qHash(Collider c, size_t seed = 0) noexcept
+    { return qHash(c.value & 3, seed); }
+};
+
+void tst_QFlatHash::empty()
+{
+    QFlatHash<int, int> hash;
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(hash.size(), 0);
+    QCOMPARE(hash.capacity(), 0);
+    QVERIFY(!hash.contains(1));
+    QCOMPARE(hash.value(1, 42), 42);
+    QVERIFY(!hash.remove(1));
+    QCOMPARE(hash.take(1), 0);
+    QCOMPARE(hash.begin(), hash.end());
+    QCOMPARE(hash.find(1), hash.end());
+    hash.clear();
+    hash.squeeze();
+    QVERIFY(hash.keys().isEmpty());
+}
+
+void tst_QFlatHash::insertRemove_data()
+{
+    QTest::addColumn<int>("count");
+    for (int count : { 1, 15, 16, 17, 1000, 100000 })
+        QTest::addRow("%d", count) << count;
+}
+
+void tst_QFlatHash::insertRemove()
+{
+    QFETCH(int, count);
+
+    QFlatHash<int, QString> hash;
+    std::unordered_map<int, QString> reference;
+    for (int i = 0; i < count; ++i) {
+        const int key = i * 7919;
+        hash.insert(key, QString::number(i));
+        reference[key] = QString::number(i);
+    }
+    QCOMPARE(hash.size(), qsizetype(reference.size()));
+    QVERIFY(hash.capacity() >= hash.size());
+    for (const auto &[key, value] : reference)
+        QCOMPARE(hash.value(key), value);
+    QVERIFY(!hash.contains(-1));
+
+    // replace
+    hash.insert(0, u"zero"_s);
+    QCOMPARE(hash.value(0), u"zero"_s);
+    QCOMPARE(hash.size(), qsizetype(reference.size()));
+
+    // remove every other element
+    for (int i = 0; i < count; i += 2)
+        QVERIFY(hash.remove(i * 7919));
+    QCOMPARE(hash.size(), qsizetype(count / 2));
+    for (int i = 0; i < count; ++i)
+        QCOMPARE(hash.contains(i * 7919), i % 2 == 1);
+
+    for (int i = 1; i < count; i += 2)
+        QCOMPARE(hash.take(i * 7919), QString::number(i));
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(hash.begin(), hash.end());
+}
+
+void tst_QFlatHash::tombstones()
+{
+    // Elements that collide probe past deleted slots, and a table full of
+    // deleted slots must not grow without bounds
+    QFlatHash<Collider, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(Collider{i}, i);
+    for (int i = 0; i < 100; i += 3)
+        hash.remove(Collider{i});
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(hash.value(Collider{i}, -1), i % 3 ? i : -1);
+
+    QFlatHash<int, int> churn;
+    for (int i = 0; i < 10; ++i)
+        churn.insert(i, i);
+    const qsizetype capacity = churn.capacity();
+    for (int i = 10; i < 100000; ++i) {
+        churn.insert(i, i);
+        QVERIFY(churn.remove(i - 10));
+    }
+    QCOMPARE(churn.size(), 10);
+    QCOMPARE(churn.capacity(), capacity);
+    for (int i = 100000 - 10; i < 100000; ++i)
+        QCOMPARE(churn.value(i), i);
+}
+
+void tst_QFlatHash::emplaceFromElement()
+{
+    // The argument refers to an element that growing the table moves
+    QFlatHash<int, QString> hash;
+    hash.insert(0, u"first"_s);
+    while (hash.size() < hash.capacity())
+        hash.insert(int(hash.size()), QString::number(hash.size()));
+    const qsizetype capacity = hash.capacity();
+    hash.emplace(-1, *hash.find(0));
+    QVERIFY(hash.capacity() > capacity);
+    QCOMPARE(hash.value(-1), u"first"_s);
+
+    hash[-2] = u"second"_s;
+    QCOMPARE(hash.value(-2), u"second"_s);
+    QCOMPARE(hash[-3], QString());
+    QVERIFY(hash.contains(-3));
+}
+
+void tst_QFlatHash::copyAndMove()
+{
+    QFlatHash<QString, int> hash = { { u"one"_s, 1 }, { u"two"_s, 2 }, { u"one"_s, 3 } };
+    QCOMPARE(hash.size(), 2);
+    QCOMPARE(hash.value(u"one"_s), 3);
+
+    QFlatHash<QString, int> copy = hash;
+    QCOMPARE(copy, hash);
+    copy.insert(u"three"_s, 3);
+    QCOMPARE_NE(copy, hash);
+    QCOMPARE(hash.size(), 2);
+
+    QFlatHash<QString, int> moved = std::move(copy);
+    QCOMPARE(moved.size(), 3);
+    QVERIFY(copy.isEmpty()); // NOLINT(bugprone-use-after-move)
+    copy = moved;
+    QCOMPARE(copy, moved);
+    copy.swap(hash);
+    QCOMPARE(hash.size(), 3);
+    QCOMPARE(copy.size(), 2);
+
+    QFlatHash<QString, int> fromRange(hash.begin(), hash.end());
+    QCOMPARE(fromRange, hash);
+    const std::unordered_map<QString, int> std = { { u"a"_s, 1 }, { u"b"_s, 2 } };
+    QFlatHash<QString, int> fromStd(std.begin(), std.end());
+    QCOMPARE(fromStd.size(), 2);
+    QCOMPARE(fromStd.value(u"b"_s), 2);
+}
+
+void tst_QFlatHash::heterogeneousLookup()
+{
+    QFlatHash<QString, int> hash = { { u"alpha"_s, 1 }, { u"beta"_s, 2 } };
+    QVERIFY(hash.contains(QStringView(u"alpha")));
+    QVERIFY(hash.contains("beta"_L1));
+    QCOMPARE(hash.value(QStringView(u"beta")), 2);
+    QCOMPARE(hash.value(QStringView(u"gamma"), -1), -1);
+    QCOMPARE(hash.find(QStringView(u"alpha")).value(), 1);
+    QCOMPARE(std::as_const(hash).constFind("beta"_L1).key(), u"beta"_s);
+    QCOMPARE(hash.take(QStringView(u"alpha")), 1);
+    QVERIFY(hash.remove("beta"_L1));
+    QVERIFY(hash.isEmpty());
+}
+
+void tst_QFlatHash::iterators()
+{
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(i, i * i);
+
+    int sum = 0;
+    for (auto it = hash.cbegin(); it != hash.cend(); ++it) {
+        QCOMPARE(it.value(), it.key() * it.key());
+        sum += it.key();
+    }
+    QCOMPARE(sum, 99 * 100 / 2);
+
+    for (auto [key, value] : hash.asKeyValueRange())
+        value = key;
+    for (int &value : hash)
+        ++value;
+    QList<int> keys = hash.keys();
+    QList<int> values = hash.values();
+    QCOMPARE(keys.size(), 100);
+    for (qsizetype i = 0; i < keys.size(); ++i)
+        QCOMPARE(values.at(i), keys.at(i) + 1);
+
+    // erase while iterating
+    for (auto it = hash.begin(); it != hash.end(); ) {
+        if (it.key() % 2)
+            it = hash.erase(it);
+        else
+            ++it;
+    }
+    QCOMPARE(hash.size(), 50);
+    for (auto it = hash.keyValueBegin(); it != hash.keyValueEnd(); ++it)
+        QCOMPARE(it->first % 2, 0);
+}
+
+void tst_QFlatHash::reserveSqueeze()
+{
+    QFlatHash<int, int> hash;
+    hash.reserve(1000);
+    const qsizetype capacity = hash.capacity();
+    QVERIFY(capacity >= 1000);
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    QCOMPARE(hash.capacity(), capacity);
+
+    for (int i = 10; i < 1000; ++i)
+        hash.remove(i);
+    hash.squeeze();
+    QVERIFY(hash.capacity() < capacity);
+    QVERIFY(hash.capacity() >= 10);
+    for (int i = 0; i < 10; ++i)
+        QCOMPARE(hash.value(i), i);
+
+    hash.clear();
+    QVERIFY(hash.capacity() > 0);
+    hash.squeeze();
+    QCOMPARE(hash.capacity(), 0);
+    hash.insert(1, 1);
+    QCOMPARE(hash.value(1), 1);
+}
+
+void tst_QFlatHash::nonRelocatable()
+{
+    // std::unique_ptr is move-only, and the elements are not memcpy'd
+    struct Tracked
+    {
+        Tracked *self = this;
+        Tracked() = default;
+        Tracked(const Tracked &) : self(this) {}
+        Tracked &operator=(const Tracked &) { return *this; }
+        ~Tracked() { QCOMPARE_EQ(self, this); }
+    };
+    QFlatHash<int, Tracked> tracked;
+    QFlatHash<int, std::unique_ptr<int>> owning;
+    for (int i = 0; i < 1000; ++i) {
+        tracked.insert(i, Tracked());
+        owning.emplace(i, std::make_unique<int>(i));
+    }
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(*owning.find(i).value(), i);
+    QCOMPARE(*owning.take(5), 5);
+}
+
+QTEST_APPLESS_MAIN(tst_QFlatHash)
+#include "tst_qflathash.moc"
@@ -2,20 +2,23 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #define QT_USE_QSTRINGBUILDER
-#define QFLATMAP_ENABLE_STL_COMPATIBLE_INSERT
 
 #include <QTest>
 
-#include <private/qflatmap_p.h>
 #include <qbytearray.h>
+#include <qflatmap.h>
+#include <qmap.h>
 #include <qstring.h>
 #include <qstringview.h>
 #include <qvarlengtharray.h>
 
 #include <algorithm>
 #include <list>
+#include <random>
 #include <tuple>
 
+using namespace Qt::StringLiterals;
+
 static constexpr bool is_even(int n) { return n % 2 == 0; }
 static constexpr bool is_empty(QAnyStringView v) { return v.isEmpty(); }
 
@@ -50,8 +53,15 @@ private slots:
     void try_emplace_and_insert_or_assign();
     void viewIterators();
     void varLengthArray();
+    void lowerBound_data();
+    void lowerBound();
+    void unsortedBulkConstruction();
+    void dataStream();
+    void debugStream();
 
 private:
+    template <typename Key>
+    void lowerBound_impl(qsizetype size);
     template <typename Compare>
     void transparency_impl();
     template <typename Predicate>
@@ -728,5 +738,107 @@ void tst_QFlatMap::varLengthArray()
     QVERIFY(m.isEmpty());
 }
 
+void tst_QFlatMap::lowerBound_data()
+{
+    QTest::addColumn<qsizetype>("size");
+    for (qsizetype size : { 0, 1, 15, 16, 17, 31, 100, 1000 })
+        QTest::addRow("%lld", qlonglong(size)) << size;
+}
+
+template <typename Key>
+void tst_QFlatMap::lowerBound_impl(qsizetype size)
+{
+    // with duplicates among the random keys, so some get dropped
+    std::mt19937 generator(size);
+    std::uniform_int_distribution<qint64> distribution(std::numeric_limits<Key>::min(),
+                                                       std::numeric_limits<Key>::max());
+    QList<Key> keys;
+    for (qsizetype i = 0; i < size; ++i)
+        keys.append(Key(i % 5 ? distribution(generator) : 42));
+    QFlatMap<Key, int> map(keys, QList<int>(keys.size()));
+    QVERIFY(std::is_sorted(map.keys().begin(), map.keys().end()));
+
+    QList<Key> needles = { Key(0), Key(41), Key(42), Key(43),
+                           std::numeric_limits<Key>::min(), std::numeric_limits<Key>::max() };
+    for (qsizetype i = 0; i < 100; ++i)
+        needles.append(Key(distribution(generator)));
+    needles += keys;
+    for (Key needle : std::as_const(needles)) {
+        const auto expected = std::lower_bound(map.keys().begin(), map.keys().end(), needle);
+        QCOMPARE(map.lower_bound(needle) - map.begin(), expected - map.keys().begin());
+        QCOMPARE(map.contains(needle), expected != map.keys().end() && *expected == needle);
+    }
+}
+
+void tst_QFlatMap::lowerBound()
+{
+    QFETCH(qsizetype, size);
+    lowerBound_impl<int>(size);
+    if (QTest::currentTestFailed())
+        return;
+    lowerBound_impl<uint>(size);
+    if (QTest::currentTestFailed())
+        return;
+    lowerBound_impl<qint64>(size);
+    if (QTest::currentTestFailed())
+        return;
+    lowerBound_impl<quint16>(size);
+    if (QTest::currentTestFailed())
+        return;
+    lowerBound_impl<signed char>(size);
+}
+
+void tst_QFlatMap::unsortedBulkConstruction()
+{
+    // the last value of equivalent keys is dropped, as with insert()
+    QFlatMap<int, QByteArray> m({ 5, 3, 9, 3, 1 }, { "five", "three", "nine", "drei", "one" });
+    QCOMPARE(m.keys(), QList<int>({ 1, 3, 5, 9 }));
+    QCOMPARE(m.values(), QByteArrayList({ "one", "three", "five", "nine" }));
+
+    QFlatMap<int, QByteArray> sorted({ 1, 2, 2, 3 }, { "one", "two", "zwei", "three" });
+    QCOMPARE(sorted.keys(), QList<int>({ 1, 2, 3 }));
+    QCOMPARE(sorted.value(2), "two");
+}
+
+void tst_QFlatMap::dataStream()
+{
+    using Map = QFlatMap<QString, int>;
+    const Map map = Map{ { u"one"_s, 1 }, { u"two"_s, 2 }, { u"three"_s, 3 } };
+
+    QByteArray data;
+    {
+        QDataStream out(&data, QIODevice::WriteOnly);
+        out << map;
+        QCOMPARE(out.status(), QDataStream::Ok);
+    }
+    {
+        // the same format as QMap's
+        QMap<QString, int> qmap;
+        QDataStream in(data);
+        in >> qmap;
+        QCOMPARE(qmap.keys(), map.keys());
+        QCOMPARE(qmap.values(), map.values());
+    }
+    Map result = Map{ { u"stale"_s, 0 } };
+    QDataStream in(data);
+    in >> result;
+    QCOMPARE(in.status(), QDataStream::Ok);
+    QCOMPARE(result.keys(), map.keys());
+    QCOMPARE(result.values(), map.values());
+
+    // truncated
+    QDataStream truncated(data.first(data.size() - 2));
+    truncated >> result;
+    QCOMPARE(truncated.status(), QDataStream::ReadPastEnd);
+    QVERIFY(result.isEmpty());
+}
+
+void tst_QFlatMap::debugStream()
+{
+    QString output;
+    QDebug(&output) << QFlatMap<int, QString>{ { 2, u"b"_s }, { 1, u"a"_s } };
+    QCOMPARE(output.trimmed(), uR"(QFlatMap((1, "a")(2, "b")))"_s);
+}
+
 QTEST_APPLESS_MAIN(tst_QFlatMap)
 #include "tst_qflatmap.moc"
@@ -3,6 +3,10 @@
 
 #include <qtest.h>
 #include <QtCore/qmetatype.h>
+#include <QtCore/qthread.h>
+
+#include <memory>
+#include <vector>
 
 class tst_QMetaType : public QObject
 {
@@ -21,6 +25,8 @@ private slots:
     void typeBuiltinNotNormalized();
     void typeCustom();
     void typeCustomNotNormalized();
+    void typeCustomMultiThreaded_data();
+    void typeCustomMultiThreaded();
     void typeNotRegistered();
     void typeNotRegisteredNotNormalized();
 
@@ -130,6 +136,40 @@ void tst_QMetaType::typeCustomNotNormalized()
     }
 }
 
+void tst_QMetaType::typeCustomMultiThreaded_data()
+{
+    QTest::addColumn<int>("threadCount");
+    const int ideal = QThread::idealThreadCount();
+    for (int n : {1, 2, 4, 8, 16, 64}) {
+        if (n <= ideal)
+            QTest::addRow("%d", n) << n;
+    }
+    if (ideal > 64 || (ideal & (ideal - 1)))
+        QTest::addRow("%d", ideal) << ideal;
+}
+
+// Looks up a custom type by name and by id from several threads at once
+void tst_QMetaType::typeCustomMultiThreaded()
+{
+    QFETCH(int, threadCount);
+    const int id = qRegisterMetaType<Foo>("Foo");
+    const auto lookup = [id] {
+        for (int i = 0; i < 10000; ++i) {
+            QMetaType::fromName("Foo");
+            QMetaType::isRegistered(id);
+        }
+    };
+    QBENCHMARK {
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (int i = 0; i < threadCount; ++i) {
+            threads.emplace_back(QThread::create(lookup));
+            threads.back()->start();
+        }
+        for (const auto &thread : threads)
+            thread->wait();
+    }
+}
+
 void tst_QMetaType::typeNotRegistered()
 {
     Q_ASSERT(!QMetaType::fromName("Bar").isValid());
@@ -0,0 +1,85 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QByteArrayMatcher>
+#include <QLatin1StringMatcher>
+#include <QStringMatcher>
+#include <QTest>
+
+class tst_QByteArrayMatcher : public QObject
+{
+    Q_OBJECT
+
+    QByteArray haystack;
+
+private slots:
+    void initTestCase();
+
+    void byteArrayMatcher_data();
+    void byteArrayMatcher();
+    void latin1StringMatcher_data() { byteArrayMatcher_data(); }
+    void latin1StringMatcher();
+    void stringMatcher_data() { byteArrayMatcher_data(); }
+    void stringMatcher();
+};
+
+void tst_QByteArrayMatcher::initTestCase()
+{
+    // A log-like haystack of about 4 MiB, made of lines that all share a
+    // common prefix, so that candidate positions are frequent
+    haystack.reserve(4 * 1024 * 1024 + 128);
+    for (int i = 0; haystack.size() < 4 * 1024 * 1024; ++i) {
+        haystack += "2025-01-01T12:00:00 [info] request ";
+        haystack += QByteArray::number(i);
+        haystack += " handled by worker ";
+        haystack += QByteArray::number(i % 17);
+        haystack += '\n';
+    }
+}
+
+void tst_QByteArrayMatcher::byteArrayMatcher_data()
+{
+    QTest::addColumn<QByteArray>("needle");
+
+    // none of these occur in the haystack, so the whole of it is scanned
+    QTest::newRow("8") << QByteArray("[error] ");
+    QTest::newRow("16") << QByteArray("[error] request ");
+    QTest::newRow("32") << QByteArray("2025-01-01T12:00:00 [error] req ");
+    QTest::newRow("64") << QByteArray("2025-01-01T12:00:00 [error] request 0 handled by worker 12345678");
+}
+
+void tst_QByteArrayMatcher::byteArrayMatcher()
+{
+    QFETCH(QByteArray, needle);
+    const QByteArrayMatcher matcher(needle);
+
+    QBENCHMARK {
+        [[maybe_unused]] auto r = matcher.indexIn(haystack);
+    }
+}
+
+void tst_QByteArrayMatcher::latin1StringMatcher()
+{
+    QFETCH(QByteArray, needle);
+    const QLatin1StringMatcher matcher(QLatin1StringView(needle), Qt::CaseSensitive);
+    const QLatin1StringView hay(haystack);
+
+    QBENCHMARK {
+        [[maybe_unused]] auto r = matcher.indexIn(hay);
+    }
+}
+
+void tst_QByteArrayMatcher::stringMatcher()
+{
+    QFETCH(QByteArray, needle);
+    const QStringMatcher matcher(QString::fromLatin1(needle));
+    const QString hay = QString::fromLatin1(haystack);
+
+    QBENCHMARK {
+        [[maybe_unused]] auto r = matcher.indexIn(hay);
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_QByteArrayMatcher)
+
+#include "tst_bench_qbytearraymatcher.moc"
@@ -4,6 +4,7 @@
 #include <qbytearray.h>
 #include <qdebug.h>
 #include <qstring.h>
+#include <qstringconverter.h>
 #include <qtest.h>
 #include <qutf8stringview.h>
 
@@ -36,6 +37,11 @@ private slots:
     void compareStringsWithErrors_data();
     void compareStringsWithErrors();
 
+    void fromUtf8Large_data();
+    void fromUtf8Large();
+    void decodeUtf8Large_data() { fromUtf8Large_data(); }
+    void decodeUtf8Large();
+
 private:
     void equalStrings_data();
     void compareStringsCaseSensitive_data();
@@ -258,6 +264,39 @@ void tst_QUtf8StringView::compareStringsWithErrors()
     QCOMPARE(-result, rhv.compare(lhv, cs));
 }
 
+void tst_QUtf8StringView::fromUtf8Large_data()
+{
+    QTest::addColumn<QByteArray>("utf8");
+
+    // 64 MiB each, the size of a modest log file
+    const qsizetype size = 64 * 1024 * 1024;
+    const QByteArray ascii = "2025-01-01T12:00:00 [info] request handled by worker 7\n";
+    QTest::newRow("ascii") << ascii.repeated(size / ascii.size());
+    const QByteArray latin = "D\xc3\xa9j\xc3\xa0 vu, na\xc3\xafve caf\xc3\xa9 cr\xc3\xa8me\n";
+    QTest::newRow("latin") << latin.repeated(size / latin.size());
+    const QByteArray cjk = "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e\xe3\x81\xae\xf0\x9f\x98\x80";
+    QTest::newRow("cjk") << cjk.repeated(size / cjk.size());
+}
+
+void tst_QUtf8StringView::fromUtf8Large()
+{
+    QFETCH(QByteArray, utf8);
+
+    QBENCHMARK {
+        [[maybe_unused]] auto r = QString::fromUtf8(utf8);
+    }
+}
+
+void tst_QUtf8StringView::decodeUtf8Large()
+{
+    QFETCH(QByteArray, utf8);
+
+    QBENCHMARK {
+        QStringDecoder decoder(QStringDecoder::Utf8);
+        [[maybe_unused]] QString r = decoder(utf8);
+    }
+}
+
 QTEST_MAIN(tst_QUtf8StringView)
 
 #include "tst_bench_qutf8stringview.moc"
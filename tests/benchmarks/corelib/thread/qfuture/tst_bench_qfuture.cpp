@@ -28,6 +28,8 @@ private slots:
 #endif
     void then();
     void thenVoid();
+    void thenChain();
+    void thenChainExecutor();
     void onCanceled();
     void onCanceledVoid();
 #ifndef QT_NO_EXCEPTIONS
@@ -156,6 +158,41 @@ void tst_QFuture::thenVoid()
     }
 }
 
+void tst_QFuture::thenChain()
+{
+    QBENCHMARK {
+        QPromise<int> promise;
+        auto future = promise.future();
+        for (int i = 0; i < 100; ++i)
+            future = future.then([](int value) { return value + 1; });
+        promise.start();
+        promise.addResult(0);
+        promise.finish();
+        QCOMPARE(future.result(), 100);
+    }
+}
+
+class InlineExecutor : public QtFuture::Executor
+{
+public:
+    void execute(QRunnable *runnable) override { runnable->run(); }
+};
+
+void tst_QFuture::thenChainExecutor()
+{
+    InlineExecutor executor;
+    QBENCHMARK {
+        QPromise<int> promise;
+        auto future = promise.future();
+        for (int i = 0; i < 100; ++i)
+            future = future.then(&executor, [](int value) { return value + 1; });
+        promise.start();
+        promise.addResult(0);
+        promise.finish();
+        QCOMPARE(future.result(), 100);
+    }
+}
+
 void tst_QFuture::onCanceled()
 {
     QFutureInterface<int> fi;
@@ -76,6 +76,10 @@ private Q_SLOTS:
 #if QT_CONFIG(timezone)
     void fromMSecsSinceEpochTz();
 #endif
+    void fromMSecsSinceEpochBulk_data();
+    void fromMSecsSinceEpochBulk();
+    void toMSecsSinceEpochBulk_data() { fromMSecsSinceEpochBulk_data(); }
+    void toMSecsSinceEpochBulk();
 };
 
 using namespace QtPrivate::DateTimeConstants;
@@ -550,6 +554,76 @@ void tst_QDateTime::fromMSecsSinceEpochTz()
 }
 #endif
 
+void tst_QDateTime::fromMSecsSinceEpochBulk_data()
+{
+    QTest::addColumn<QTimeZone>("zone");
+    QTest::addColumn<bool>("bulk");
+
+    const auto addRows = [](const char *name, const QTimeZone &zone) {
+        QTest::addRow("%s-each", name) << zone << false;
+        QTest::addRow("%s-bulk", name) << zone << true;
+    };
+    addRows("UTC", QTimeZone::UTC);
+    addRows("offset", QTimeZone::fromSecondsAheadOfUtc(3600));
+    addRows("local", QTimeZone::LocalTime);
+#if QT_CONFIG(timezone)
+    addRows("Oslo", QTimeZone("Europe/Oslo"));
+#endif
+}
+
+void tst_QDateTime::fromMSecsSinceEpochBulk()
+{
+    QFETCH(const QTimeZone, zone);
+    QFETCH(const bool, bulk);
+    // Every ten minutes of the 2010s:
+    QList<qint64> msecs;
+    for (qint64 ms = (JULIAN_DAY_2010 - JULIAN_DAY_1970) * MSECS_PER_DAY;
+         ms < (JULIAN_DAY_2020 - JULIAN_DAY_1970) * MSECS_PER_DAY; ms += 600'000) {
+        msecs.append(ms);
+    }
+    QList<QDate> dates(msecs.size());
+    QList<QTime> times(msecs.size());
+    if (bulk) {
+        QBENCHMARK {
+            QDateTime::fromMSecsSinceEpoch(msecs, zone, dates, times);
+        }
+    } else {
+        QBENCHMARK {
+            for (qsizetype i = 0; i < msecs.size(); ++i) {
+                const QDateTime dt = QDateTime::fromMSecsSinceEpoch(msecs[i], zone);
+                dates[i] = dt.date();
+                times[i] = dt.time();
+            }
+        }
+    }
+}
+
+void tst_QDateTime::toMSecsSinceEpochBulk()
+{
+    QFETCH(const QTimeZone, zone);
+    QFETCH(const bool, bulk);
+    // Every ten minutes of the 2010s:
+    QList<QDate> dates;
+    QList<QTime> times;
+    for (qint64 jd = JULIAN_DAY_2010; jd < JULIAN_DAY_2020; ++jd) {
+        for (int minute = 0; minute < 24 * 60; minute += 10) {
+            dates.append(QDate::fromJulianDay(jd));
+            times.append(QTime::fromMSecsSinceStartOfDay(minute * 60'000));
+        }
+    }
+    QList<qint64> msecs(dates.size());
+    if (bulk) {
+        QBENCHMARK {
+            QDateTime::toMSecsSinceEpoch(dates, times, zone, msecs);
+        }
+    } else {
+        QBENCHMARK {
+            for (qsizetype i = 0; i < dates.size(); ++i)
+                msecs[i] = QDateTime(dates[i], times[i], zone).toMSecsSinceEpoch();
+        }
+    }
+}
+
 QTEST_MAIN(tst_QDateTime)
 
 #include "tst_bench_qdatetime.moc"
@@ -3,9 +3,12 @@
 #include <QString>
 #include <QMap>
 #include <QHash>
+#include <QFlatHash>
 
 #include <qtest.h>
 
+#include <unordered_map>
+
 class tst_associative_containers : public QObject
 {
     Q_OBJECT
@@ -14,6 +17,20 @@ private slots:
     void insert();
     void lookup_data();
     void lookup();
+    void lookupString_data() { lookup_data(); }
+    void lookupString();
+};
+
+// std::unordered_map has no value(); give it the same interface
+template <typename Key, typename T>
+struct StdUnorderedMap : std::unordered_map<Key, T>
+{
+    void insert(const Key &key, const T &value) { this->insert_or_assign(key, value); }
+    T value(const Key &key) const
+    {
+        const auto it = this->find(key);
+        return it == this->end() ? T() : it->second;
+    }
 };
 
 template <typename T>
@@ -27,33 +44,40 @@ void testInsert(int size)
     }
 }
 
-void tst_associative_containers::insert_data()
+static void addContainerRows()
 {
-    QTest::addColumn<bool>("useHash");
+    QTest::addColumn<QByteArray>("container");
     QTest::addColumn<int>("size");
 
     for (int size = 10; size < 20000; size += 100) {
 
         const QByteArray sizeString = QByteArray::number(size);
 
-        QTest::newRow(QByteArray("hash--" + sizeString).constData()) << true << size;
-        QTest::newRow(QByteArray("map--" + sizeString).constData()) << false << size;
+        for (const char *container : { "hash", "map", "flathash", "unordered_map" }) {
+            QTest::newRow(QByteArray(container + ("--" + sizeString)).constData())
+                    << QByteArray(container) << size;
+        }
     }
 }
 
+void tst_associative_containers::insert_data()
+{
+    addContainerRows();
+}
+
 void tst_associative_containers::insert()
 {
-    QFETCH(bool, useHash);
+    QFETCH(QByteArray, container);
     QFETCH(int, size);
 
-    QHash<int, int> testHash;
-    QMap<int, int> testMap;
-
-    if (useHash) {
+    if (container == "hash")
         testInsert<QHash<int, int> >(size);
-    } else {
+    else if (container == "map")
         testInsert<QMap<int, int> >(size);
-    }
+    else if (container == "flathash")
+        testInsert<QFlatHash<int, int> >(size);
+    else
+        testInsert<StdUnorderedMap<int, int> >(size);
 }
 
 void tst_associative_containers::lookup_data()
@@ -61,16 +85,7 @@ void tst_associative_containers::lookup_data()
 //    setReportType(LineChartReport);
 //    setChartTitle("Time to call value(), with an increasing number of items in the container");
 
-    QTest::addColumn<bool>("useHash");
-    QTest::addColumn<int>("size");
-
-    for (int size = 10; size < 20000; size += 100) {
-
-        const QByteArray sizeString = QByteArray::number(size);
-
-        QTest::newRow(QByteArray("hash--" + sizeString).constData()) << true << size;
-        QTest::newRow(QByteArray("map--" + sizeString).constData()) << false << size;
-    }
+    addContainerRows();
 }
 
 template <typename T>
@@ -93,14 +108,53 @@ void testLookup(int size)
 
 void tst_associative_containers::lookup()
 {
-    QFETCH(bool, useHash);
+    QFETCH(QByteArray, container);
     QFETCH(int, size);
 
-    if (useHash) {
+    if (container == "hash")
         testLookup<QHash<int, int> >(size);
-    } else {
+    else if (container == "map")
         testLookup<QMap<int, int> >(size);
+    else if (container == "flathash")
+        testLookup<QFlatHash<int, int> >(size);
+    else
+        testLookup<StdUnorderedMap<int, int> >(size);
+}
+
+template <typename T>
+void testLookupString(int size)
+{
+    QStringList keys;
+    keys.reserve(size);
+    for (int i = 0; i < size; ++i)
+        keys.append(QLatin1StringView("key-") + QString::number(i * 7919));
+
+    T container;
+    for (int i = 0; i < size; ++i)
+        container.insert(keys.at(i), i);
+
+    int val;
+
+    QBENCHMARK {
+        for (const QString &key : std::as_const(keys))
+            val = container.value(key);
     }
+    Q_UNUSED(val);
+}
+
+void tst_associative_containers::lookupString()
+{
+    QFETCH(QByteArray, container);
+    QFETCH(int, size);
+
+    if (container == "hash")
+        testLookupString<QHash<QString, int> >(size);
+    else if (container == "map")
+        testLookupString<QMap<QString, int> >(size);
+    else if (container == "flathash")
+        testLookupString<QFlatHash<QString, int> >(size);
+    else
+        testLookupString<StdUnorderedMap<QString, int> >(size);
 }
 
 QTEST_MAIN(tst_associative_containers)